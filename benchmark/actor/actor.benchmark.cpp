@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// Bounces a message back and forth between two actors until the count runs out, the way tile
+// workers and tiles trade requests and responses.
+class Pong;
+
+class Ping {
+public:
+    Ping(ActorRef<Ping>) {}
+
+    void start(ActorRef<Pong>, ActorRef<Ping>, int count, std::promise<void>);
+    void pong(ActorRef<Pong>, ActorRef<Ping>, int count, std::promise<void>);
+};
+
+class Pong {
+public:
+    Pong(ActorRef<Pong>) {}
+
+    void ping(ActorRef<Pong> self, ActorRef<Ping> ping, int count, std::promise<void> done) {
+        ping.invoke(&Ping::pong, self, ping, count, std::move(done));
+    }
+};
+
+void Ping::start(ActorRef<Pong> pong, ActorRef<Ping> self, int count, std::promise<void> done) {
+    pong.invoke(&Pong::ping, pong, self, count, std::move(done));
+}
+
+void Ping::pong(ActorRef<Pong> pong, ActorRef<Ping> self, int count, std::promise<void> done) {
+    if (count == 0) {
+        done.set_value();
+    } else {
+        pong.invoke(&Pong::ping, pong, self, count - 1, std::move(done));
+    }
+}
+
+class Sink {
+public:
+    Sink(ActorRef<Sink>) {}
+
+    void receive(int, std::string) {}
+};
+
+} // namespace
+
+static void Actor_PingPong(benchmark::State& state) {
+    const int count = 10000;
+
+    ThreadPool pool { 2 };
+    Actor<Ping> ping(pool);
+    Actor<Pong> pong(pool);
+
+    while (state.KeepRunning()) {
+        std::promise<void> done;
+        auto future = done.get_future();
+        ping.invoke(&Ping::start, pong.self(), ping.self(), count, std::move(done));
+        future.wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * count * 2);
+}
+
+static void Actor_ConcurrentSenders(benchmark::State& state) {
+    const auto senders = state.range(0);
+    const int count = 10000;
+
+    ThreadPool pool { 1 };
+    Actor<Sink> sink(pool);
+
+    while (state.KeepRunning()) {
+        std::vector<std::thread> threads;
+        for (auto i = 0; i < senders; i++) {
+            threads.emplace_back([&] {
+                auto ref = sink.self();
+                for (int j = 0; j < count; j++) {
+                    ref.invoke(&Sink::receive, j, std::string());
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        sink.ask(&Sink::receive, 0, std::string()).wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * senders * count);
+}
+
+BENCHMARK(Actor_PingPong)->UseRealTime();
+BENCHMARK(Actor_ConcurrentSenders)->Arg(1)->Arg(4)->UseRealTime();
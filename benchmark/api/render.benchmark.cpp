@@ -12,6 +12,7 @@
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/gl/context.hpp>
 
 using namespace mbgl;
 
@@ -49,6 +50,26 @@ static void API_renderStill_reuse_map(::benchmark::State& state) {
     }
 }
 
+// Renders a pitched view, which covers many tiles, and reports the number of draw calls per frame.
+static void API_renderStill_pitched(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend { { 1000, 1000 }, 1, bench.fileSource, bench.threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, bench.fileSource, bench.threadPool, MapMode::Static};
+    prepare(map);
+    map.setPitch(60);
+
+    gl::Context& context = frontend.getBackend()->getContext();
+    std::size_t frames = 0;
+    const std::size_t drawCalls = context.drawCalls;
+
+    while (state.KeepRunning()) {
+        frontend.render(map);
+        frames++;
+    }
+
+    state.counters["drawCalls"] = frames ? double(context.drawCalls - drawCalls) / frames : 0;
+}
+
 static void API_renderStill_reuse_map_switch_styles(::benchmark::State& state) {
     RenderBenchmark bench;
     HeadlessFrontend frontend { { 1000, 1000 }, 1, bench.fileSource, bench.threadPool };
@@ -74,5 +95,6 @@ static void API_renderStill_recreate_map(::benchmark::State& state) {
 }
 
 BENCHMARK(API_renderStill_reuse_map);
+BENCHMARK(API_renderStill_pitched);
 BENCHMARK(API_renderStill_reuse_map_switch_styles);
 BENCHMARK(API_renderStill_recreate_map);
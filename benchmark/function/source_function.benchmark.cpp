@@ -54,6 +54,30 @@ static void Evaluate_SourceFunction(benchmark::State& state) {
     state.SetLabel(std::to_string(stopCount).c_str());
 }
 
+static void Evaluate_SourceFunction_Batch(benchmark::State& state) {
+    auto doc = createFunctionJSON(8);
+    conversion::Error error;
+    optional<SourceFunction<float>> function = conversion::convertJSON<SourceFunction<float>>(doc, error);
+    if (!function) {
+        state.SkipWithError(error.message.c_str());
+    }
+
+    std::vector<StubGeometryTileFeature> features;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        features.emplace_back(PropertyMap { { "x", static_cast<int64_t>(rand() % 100) } });
+    }
+    std::vector<const GeometryTileFeature*> pointers;
+    for (const auto& feature : features) {
+        pointers.push_back(&feature);
+    }
+
+    while (state.KeepRunning()) {
+        function->evaluate(expression::FeatureBatch(pointers), -1.0f);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 BENCHMARK(Parse_SourceFunction)
     ->Arg(1)->Arg(2)->Arg(4)->Arg(6)->Arg(8)->Arg(10)->Arg(12);
 
@@ -61,3 +85,6 @@ BENCHMARK(Evaluate_SourceFunction)
     ->Arg(1)->Arg(2)->Arg(4)->Arg(6)->Arg(8)->Arg(10)->Arg(12);
 
 
+
+BENCHMARK(Evaluate_SourceFunction_Batch)
+    ->Arg(1000)->Arg(50000);
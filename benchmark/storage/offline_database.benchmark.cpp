@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/storage/offline_database.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+std::shared_ptr<std::string> tileData() {
+    return std::make_shared<std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf"));
+}
+
+Resource tileResource(int32_t x) {
+    return Resource::tile("mapbox://tiles/{z}/{x}/{y}.vector.pbf", 1.0, x, 0, 10, Tileset::Scheme::XYZ);
+}
+
+} // namespace
+
+static void OfflineDatabase_Put(::benchmark::State& state) {
+    OfflineDatabase db(":memory:", 256 * 1024 * 1024);
+    db.setCompression(Resource::Kind::Tile, util::Compression(state.range(0)));
+
+    Response response;
+    response.data = tileData();
+
+    int32_t x = 0;
+    while (state.KeepRunning()) {
+        db.put(tileResource(x++ % 1024), response);
+    }
+
+    state.SetBytesProcessed(state.iterations() * response.data->size());
+}
+
+static void OfflineDatabase_Get(::benchmark::State& state) {
+    OfflineDatabase db(":memory:", 256 * 1024 * 1024);
+    db.setCompression(Resource::Kind::Tile, util::Compression(state.range(0)));
+
+    Response response;
+    response.data = tileData();
+
+    // Use more tiles than the database keeps in memory, so that reads go to SQLite.
+    const int32_t count = 1024;
+    for (int32_t x = 0; x < count; x++) {
+        db.put(tileResource(x), response);
+    }
+
+    int32_t x = 0;
+    while (state.KeepRunning()) {
+        ::benchmark::DoNotOptimize(db.get(tileResource(x++ % count)));
+    }
+
+    state.SetBytesProcessed(state.iterations() * response.data->size());
+}
+
+// The argument is the util::Compression value that tiles are stored with.
+BENCHMARK(OfflineDatabase_Put)->Arg(int(util::Compression::None))->Arg(int(util::Compression::Zlib))->Arg(int(util::Compression::Fast));
+BENCHMARK(OfflineDatabase_Get)->Arg(int(util::Compression::None))->Arg(int(util::Compression::Zlib))->Arg(int(util::Compression::Fast));
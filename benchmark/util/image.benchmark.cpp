@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/premultiply.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+
+using namespace mbgl;
+
+static void decode(benchmark::State& state, const std::string& path) {
+    const std::string data = util::read_file(path);
+
+    while (state.KeepRunning()) {
+        auto image = decodeImage(data);
+        benchmark::DoNotOptimize(image.data.get());
+    }
+}
+
+static void Util_DecodePNG_RasterTile(benchmark::State& state) {
+    decode(state, "test/fixtures/image/tile.png");
+}
+
+static void Util_DecodeJPEG_RasterTile(benchmark::State& state) {
+    decode(state, "test/fixtures/image/tile.jpeg");
+}
+
+static void Util_DecodePNG_Sprite(benchmark::State& state) {
+    decode(state, "test/fixtures/resources/sprite.png");
+}
+
+static void encode(benchmark::State& state, const std::string& path, bool palette) {
+    const PremultipliedImage image = decodeImage(util::read_file(path));
+    ThreadPool threadPool(4);
+
+    // Arguments are the compression level, and whether to use the thread pool.
+    PNGEncodeOptions options;
+    options.compressionLevel = state.range(0);
+    options.palette = palette;
+    options.scheduler = state.range(1) ? &threadPool : nullptr;
+
+    std::size_t bytes = 0;
+    while (state.KeepRunning()) {
+        bytes = encodePNG(image, options).size();
+    }
+    state.counters["bytes"] = bytes;
+}
+
+static void Util_EncodePNG_RenderedMap(benchmark::State& state) {
+    encode(state, "test/fixtures/map/offline/expected.png", false);
+}
+
+static void Util_EncodePNG_RenderedMapPalette(benchmark::State& state) {
+    encode(state, "test/fixtures/map/offline/expected.png", true);
+}
+
+static void Util_EncodePNG_RasterTile(benchmark::State& state) {
+    encode(state, "test/fixtures/image/tile.jpeg", false);
+}
+
+static void Util_EncodePNG_RasterTilePalette(benchmark::State& state) {
+    encode(state, "test/fixtures/image/tile.jpeg", true);
+}
+
+static void Util_Premultiply(benchmark::State& state) {
+    UnassociatedImage image({ 512, 512 });
+    for (size_t i = 0; i < image.bytes(); i++) {
+        image.data[i] = i * 7;
+    }
+
+    while (state.KeepRunning()) {
+        util::premultiply(image.data.get(), image.size.width * image.size.height);
+        benchmark::DoNotOptimize(image.data.get());
+    }
+}
+
+BENCHMARK(Util_DecodePNG_RasterTile);
+BENCHMARK(Util_DecodeJPEG_RasterTile);
+BENCHMARK(Util_DecodePNG_Sprite);
+BENCHMARK(Util_Premultiply);
+
+static void encodeArguments(benchmark::internal::Benchmark* benchmark) {
+    for (int level : { 1, 6, 9 }) {
+        benchmark->Args({ level, 0 });
+    }
+    benchmark->Args({ 6, 1 });
+    benchmark->UseRealTime();
+}
+
+BENCHMARK(Util_EncodePNG_RenderedMap)->Apply(encodeArguments);
+BENCHMARK(Util_EncodePNG_RenderedMapPalette)->Apply(encodeArguments);
+BENCHMARK(Util_EncodePNG_RasterTile)->Apply(encodeArguments);
+BENCHMARK(Util_EncodePNG_RasterTilePalette)->Apply(encodeArguments);
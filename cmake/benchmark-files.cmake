@@ -1,6 +1,9 @@
 # This file is generated. Do not edit. Regenerate this with scripts/generate-cmake-files.js
 
 set(MBGL_BENCHMARK_FILES
+    # actor
+    benchmark/actor/actor.benchmark.cpp
+
     # api
     benchmark/api/query.benchmark.cpp
     benchmark/api/render.benchmark.cpp
@@ -21,8 +24,12 @@ set(MBGL_BENCHMARK_FILES
     benchmark/parse/tile_mask.benchmark.cpp
     benchmark/parse/vector_tile.benchmark.cpp
 
+    # storage
+    benchmark/storage/offline_database.benchmark.cpp
+
     # util
     benchmark/util/dtoa.benchmark.cpp
+    benchmark/util/image.benchmark.cpp
     benchmark/util/tilecover.benchmark.cpp
 
 )
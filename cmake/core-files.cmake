@@ -8,6 +8,7 @@ set(MBGL_CORE_FILES
     include/mbgl/actor/message.hpp
     include/mbgl/actor/scheduler.hpp
     src/mbgl/actor/mailbox.cpp
+    src/mbgl/actor/message.cpp
     src/mbgl/actor/scheduler.cpp
 
     # algorithm
@@ -73,9 +74,11 @@ set(MBGL_CORE_FILES
     src/mbgl/gl/index_buffer.hpp
     src/mbgl/gl/object.cpp
     src/mbgl/gl/object.hpp
+    src/mbgl/gl/pixel_buffer_extension.hpp
     src/mbgl/gl/primitives.hpp
     src/mbgl/gl/program.hpp
     src/mbgl/gl/program_binary_extension.hpp
+    src/mbgl/gl/readback.hpp
     src/mbgl/gl/renderbuffer.hpp
     src/mbgl/gl/state.hpp
     src/mbgl/gl/stencil_mode.cpp
@@ -134,6 +137,8 @@ set(MBGL_CORE_FILES
     src/mbgl/programs/background_program.hpp
     src/mbgl/programs/binary_program.cpp
     src/mbgl/programs/binary_program.hpp
+    src/mbgl/programs/binary_program_cache.cpp
+    src/mbgl/programs/binary_program_cache.hpp
     src/mbgl/programs/circle_program.cpp
     src/mbgl/programs/circle_program.hpp
     src/mbgl/programs/clipping_mask_program.hpp
@@ -175,6 +180,7 @@ set(MBGL_CORE_FILES
     include/mbgl/renderer/renderer_backend.hpp
     include/mbgl/renderer/renderer_frontend.hpp
     include/mbgl/renderer/renderer_observer.hpp
+    include/mbgl/renderer/rendering_stats.hpp
     src/mbgl/renderer/backend_scope.cpp
     src/mbgl/renderer/bucket.hpp
     src/mbgl/renderer/bucket_parameters.cpp
@@ -315,6 +321,8 @@ set(MBGL_CORE_FILES
     src/mbgl/shaders/hillshade_prepare.hpp
     src/mbgl/shaders/line.cpp
     src/mbgl/shaders/line.hpp
+    src/mbgl/shaders/line_batched.cpp
+    src/mbgl/shaders/line_batched.hpp
     src/mbgl/shaders/line_pattern.cpp
     src/mbgl/shaders/line_pattern.hpp
     src/mbgl/shaders/line_sdf.cpp
@@ -445,6 +453,7 @@ set(MBGL_CORE_FILES
     include/mbgl/style/expression/assertion.hpp
     include/mbgl/style/expression/at.hpp
     include/mbgl/style/expression/boolean_operator.hpp
+    include/mbgl/style/expression/bytecode.hpp
     include/mbgl/style/expression/case.hpp
     include/mbgl/style/expression/check_subtype.hpp
     include/mbgl/style/expression/coalesce.hpp
@@ -452,6 +461,7 @@ set(MBGL_CORE_FILES
     include/mbgl/style/expression/compound_expression.hpp
     include/mbgl/style/expression/equals.hpp
     include/mbgl/style/expression/expression.hpp
+    include/mbgl/style/expression/feature_batch.hpp
     include/mbgl/style/expression/find_zoom_curve.hpp
     include/mbgl/style/expression/get_covering_stops.hpp
     include/mbgl/style/expression/interpolate.hpp
@@ -469,12 +479,14 @@ set(MBGL_CORE_FILES
     src/mbgl/style/expression/assertion.cpp
     src/mbgl/style/expression/at.cpp
     src/mbgl/style/expression/boolean_operator.cpp
+    src/mbgl/style/expression/bytecode.cpp
     src/mbgl/style/expression/case.cpp
     src/mbgl/style/expression/check_subtype.cpp
     src/mbgl/style/expression/coalesce.cpp
     src/mbgl/style/expression/coercion.cpp
     src/mbgl/style/expression/compound_expression.cpp
     src/mbgl/style/expression/equals.cpp
+    src/mbgl/style/expression/feature_batch.cpp
     src/mbgl/style/expression/find_zoom_curve.cpp
     src/mbgl/style/expression/get_covering_stops.cpp
     src/mbgl/style/expression/interpolate.cpp
@@ -691,6 +703,7 @@ set(MBGL_CORE_FILES
     include/mbgl/util/thread.hpp
     include/mbgl/util/tileset.hpp
     include/mbgl/util/timer.hpp
+    include/mbgl/util/trace.hpp
     include/mbgl/util/traits.hpp
     include/mbgl/util/tuple.hpp
     include/mbgl/util/type_list.hpp
@@ -740,6 +753,8 @@ set(MBGL_CORE_FILES
     src/mbgl/util/math.hpp
     src/mbgl/util/offscreen_texture.cpp
     src/mbgl/util/offscreen_texture.hpp
+    src/mbgl/util/parallel_for.cpp
+    src/mbgl/util/parallel_for.hpp
     src/mbgl/util/premultiply.cpp
     src/mbgl/util/rapidjson.hpp
     src/mbgl/util/rect.hpp
@@ -759,6 +774,7 @@ set(MBGL_CORE_FILES
     src/mbgl/util/tiny_sdf.cpp
     src/mbgl/util/tiny_sdf.hpp
     src/mbgl/util/token.hpp
+    src/mbgl/util/trace.cpp
     src/mbgl/util/url.cpp
     src/mbgl/util/url.hpp
     src/mbgl/util/utf.hpp
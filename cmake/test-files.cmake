@@ -41,12 +41,14 @@ set(MBGL_TEST_FILES
 
     # programs
     test/programs/binary_program.test.cpp
+    test/programs/binary_program_cache.test.cpp
     test/programs/symbol_program.test.cpp
 
     # renderer
     test/renderer/backend_scope.test.cpp
     test/renderer/group_by_layout.test.cpp
     test/renderer/image_manager.test.cpp
+    test/renderer/paint_property_binder.test.cpp
 
     # sprite
     test/sprite/sprite_loader.test.cpp
@@ -83,6 +85,7 @@ set(MBGL_TEST_FILES
     test/style/conversion/tileset.test.cpp
 
     # style/expression
+    test/style/expression/bytecode.test.cpp
     test/style/expression/expression.test.cpp
     test/style/expression/util.test.cpp
 
@@ -131,6 +134,7 @@ set(MBGL_TEST_FILES
 
     # util
     test/util/async_task.test.cpp
+    test/util/compression.test.cpp
     test/util/dtoa.test.cpp
     test/util/geo.test.cpp
     test/util/grid_index.test.cpp
@@ -141,6 +145,7 @@ set(MBGL_TEST_FILES
     test/util/merge_lines.test.cpp
     test/util/number_conversions.test.cpp
     test/util/offscreen_texture.test.cpp
+    test/util/parallel_for.test.cpp
     test/util/position.test.cpp
     test/util/projection.test.cpp
     test/util/run_loop.test.cpp
@@ -151,6 +156,7 @@ set(MBGL_TEST_FILES
     test/util/tile_range.test.cpp
     test/util/timer.test.cpp
     test/util/token.test.cpp
+    test/util/trace.test.cpp
     test/util/unique_any.test.cpp
     test/util/url.test.cpp
 
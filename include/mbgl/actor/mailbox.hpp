@@ -1,17 +1,20 @@
 #pragma once
 
+#include <mbgl/actor/message.hpp>
+
+#include <atomic>
+#include <cstddef>
 #include <memory>
 #include <mutex>
-#include <queue>
 
 namespace mbgl {
 
 class Scheduler;
-class Message;
 
 class Mailbox : public std::enable_shared_from_this<Mailbox> {
 public:
     Mailbox(Scheduler&);
+    ~Mailbox();
 
     void push(std::unique_ptr<Message>);
 
@@ -21,15 +24,29 @@ public:
     static void maybeReceive(std::weak_ptr<Mailbox>);
 
 private:
+    Message* pop();
+
     Scheduler& scheduler;
 
     std::recursive_mutex receivingMutex;
-    std::mutex pushingMutex;
 
-    bool closed { false };
+    std::atomic<bool> closed { false };
+    std::atomic<std::size_t> pushing { 0 };
+
+    // An intrusive multi-producer, single-consumer queue (after Dmitry Vyukov). Pushing links a
+    // message in at the head with a single exchange; the receiving thread unlinks messages at the
+    // tail. The stub keeps the queue from ever running empty, so producers never touch the tail.
+    class Stub : public Message {
+    public:
+        void operator()() override {}
+    };
+
+    Stub stub;
+    std::atomic<Message*> head { &stub };
+    Message* tail = &stub;
 
-    std::mutex queueMutex;
-    std::queue<std::unique_ptr<Message>> queue;
+    // The number of messages that are fully linked into the queue.
+    std::atomic<std::size_t> queueSize { 0 };
 };
 
 } // namespace mbgl
@@ -2,6 +2,8 @@
 
 #include <mbgl/util/optional.hpp>
 
+#include <atomic>
+#include <cstddef>
 #include <future>
 #include <utility>
 
@@ -14,6 +16,18 @@ class Message {
 public:
     virtual ~Message() = default;
     virtual void operator()() = 0;
+
+    // Messages are small, short-lived, and usually freed on a different thread than the one that
+    // allocated them. Small messages are carved out of lock-free pools of recycled blocks; large
+    // ones, and any that don't fit once a pool is exhausted, come from the heap.
+    static void* operator new(std::size_t);
+    static void operator delete(void*, std::size_t);
+
+private:
+    friend class Mailbox;
+
+    // Links the message into the queue of the mailbox it was pushed to.
+    std::atomic<Message*> next { nullptr };
 };
 
 template <class Object, class MemberFn, class ArgsTuple>
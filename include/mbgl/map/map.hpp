@@ -161,6 +161,11 @@ public:
     void setPrefetchZoomDelta(uint8_t delta);
     uint8_t getPrefetchZoomDelta() const;
 
+    // Cameras that the map is expected to move to. Their tiles are loaded and laid out along with
+    // those of the current camera, at the current size of the map, but they are not rendered and
+    // still images don't wait for them. Replaces the cameras that were set before.
+    void setPrefetchCameras(std::vector<CameraOptions>);
+
     // Debug
     void setDebug(MapDebugOptions);
     void cycleDebugOptions();
@@ -2,12 +2,17 @@
 
 #include <mbgl/util/optional.hpp>
 #include <mbgl/style/filter.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/geo.hpp>
 
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace mbgl {
 
+class FeatureIndex;
+
 /**
  * Options for query rendered features.
  */
@@ -22,6 +27,30 @@ public:
     optional<std::vector<std::string>> layerIDs;
 
     optional<style::Filter> filter;
+
+    /** Names of the properties to copy into the resulting features. All properties are
+        copied when not set; none are when empty, e.g. when only feature IDs are needed. */
+    optional<std::vector<std::string>> properties;
+
+    /** Whether to convert the geometries of the resulting features. */
+    bool geometry = true;
+};
+
+/**
+ * A reference to a rendered feature: the layer it was rendered in, the tile it was
+ * found in, and its position in the tile's source layer. Handles are cheaper to
+ * obtain than Features because the feature's geometry and properties aren't
+ * converted; they keep the tile's data alive until they are released, and can be
+ * converted to Features later with Renderer::getFeatures().
+ */
+class RenderedFeatureHandle {
+public:
+    std::string layerID;
+    CanonicalTileID tileID;
+    std::string sourceLayer;
+    std::size_t featureIndex;
+
+    std::shared_ptr<const FeatureIndex> index;
 };
 
 /**
@@ -30,14 +59,21 @@ public:
 class SourceQueryOptions {
 public:
     SourceQueryOptions(optional<std::vector<std::string>> sourceLayers_ = {},
-                       optional<style::Filter> filter_ = {})
+                       optional<style::Filter> filter_ = {},
+                       optional<LatLngBounds> bounds_ = {})
         : sourceLayers(std::move(sourceLayers_)),
-          filter(std::move(filter_)) {}
+          filter(std::move(filter_)),
+          bounds(std::move(bounds_)) {}
 
     // Required for VectorSource, ignored for GeoJSONSource
     optional<std::vector<std::string>> sourceLayers;
 
     optional<style::Filter> filter;
+
+    // Restricts the query to features whose bounding boxes intersect the bounds. Bounded
+    // queries are answered from the tiles' feature indexes, and features that have an ID
+    // are returned only once, even when they are split across several tiles.
+    optional<LatLngBounds> bounds;
 };
 
 } // namespace mbgl
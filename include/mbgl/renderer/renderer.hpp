@@ -40,6 +40,19 @@ public:
     std::vector<Feature> queryRenderedFeatures(const ScreenCoordinate& point, const RenderedQueryOptions& options = {}) const;
     std::vector<Feature> queryRenderedFeatures(const ScreenBox& box, const RenderedQueryOptions& options = {}) const;
     std::vector<Feature> querySourceFeatures(const std::string& sourceID, const SourceQueryOptions& options = {}) const;
+
+    // Like querySourceFeatures(), but passes each feature to the callback as soon as it is
+    // found instead of collecting them all first.
+    void querySourceFeatures(const std::string& sourceID, const SourceQueryOptions&, const std::function<void (Feature&&)>&) const;
+
+    // Like queryRenderedFeatures(), but returns handles to the features, which are cheaper to
+    // obtain. Use getFeatures() to convert the handles of interest; only the properties and
+    // geometry options are used for the conversion.
+    std::vector<RenderedFeatureHandle> queryRenderedFeatureHandles(const ScreenLineString&, const RenderedQueryOptions& options = {}) const;
+    std::vector<RenderedFeatureHandle> queryRenderedFeatureHandles(const ScreenCoordinate& point, const RenderedQueryOptions& options = {}) const;
+    std::vector<RenderedFeatureHandle> queryRenderedFeatureHandles(const ScreenBox& box, const RenderedQueryOptions& options = {}) const;
+    std::vector<Feature> getFeatures(const std::vector<RenderedFeatureHandle>&, const RenderedQueryOptions& options = {}) const;
+
     AnnotationIDs queryPointAnnotations(const ScreenBox& box) const;
     AnnotationIDs queryShapeAnnotations(const ScreenBox& box) const;
     AnnotationIDs getAnnotationIDs(const std::vector<Feature>&) const;
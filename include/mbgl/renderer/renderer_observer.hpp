@@ -1,5 +1,7 @@
 #pragma once
 
+#include <mbgl/renderer/rendering_stats.hpp>
+
 #include <exception>
 
 namespace mbgl {
@@ -25,6 +27,9 @@ public:
     // Start of frame, initial is the first frame for this map
     virtual void onWillStartRenderingFrame() {}
 
+    // Statistics of the frame, right before it ends
+    virtual void onRenderingStats(const RenderingStats&) {}
+
     // End of frame, boolean flags that a repaint is required
     virtual void onDidFinishRenderingFrame(RenderMode, bool) {}
 
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+
+#include <cstddef>
+
+namespace mbgl {
+
+/**
+ * Statistics of the work done to render a frame.
+ */
+class RenderingStats {
+public:
+    /** OpenGL calls issued during the frame */
+    std::size_t drawCalls = 0;
+    std::size_t programSwitches = 0;
+    std::size_t textureBinds = 0;
+
+    /** Vertex and index data uploaded during the frame, in bytes */
+    std::size_t uploadedVertexBytes = 0;
+    std::size_t uploadedIndexBytes = 0;
+
+    /** Tiles of all sources that were rendered, and that are still loading */
+    std::size_t renderedTiles = 0;
+    std::size_t pendingTiles = 0;
+
+    /** Symbols that a placement during this frame showed, and that it hid because they collided.
+        Both are zero when the frame reused the previous placement. */
+    std::size_t placedSymbols = 0;
+    std::size_t collidedSymbols = 0;
+
+    /** Time spent on symbol placement, and on rendering the whole frame, on the CPU */
+    Duration placementTime = Duration::zero();
+    Duration renderTime = Duration::zero();
+
+    /** OpenGL buffer and texture storage in use at the end of the frame, in bytes */
+    std::size_t bufferMemory = 0;
+    std::size_t textureMemory = 0;
+};
+
+} // namespace mbgl
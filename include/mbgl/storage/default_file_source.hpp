@@ -3,6 +3,8 @@
 #include <mbgl/actor/actor_ref.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/offline.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/optional.hpp>
 
@@ -123,6 +125,14 @@ public:
      */
     void setOfflineMapboxTileCountLimit(uint64_t) const;
 
+    /*
+     * Select how resources of the given kind are compressed when they are stored in the
+     * database. `level` applies to zlib only, from 0 (store) to 9 (best), with -1 selecting
+     * zlib's default. Resources already in the database keep their compression. The default
+     * for every kind is zlib at its default level.
+     */
+    void setCacheCompression(Resource::Kind, util::Compression, int level = -1);
+
     /*
      * Pause file request activity.
      *
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <mbgl/style/expression/expression.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+namespace expression {
+
+class InterpolateBase;
+class FeatureBatch;
+
+/*
+    Bytecode is a flattened form of an expression tree: a list of instructions
+    that read and write typed registers, evaluated by a single loop instead of
+    by recursive virtual calls. Numbers stay unboxed in double registers
+    between instructions; other values live in Value registers.
+
+    The compiler lowers literals, "zoom", "heatmap-density", "get" with a
+    literal key, number assertions, arithmetic, and "interpolate" and "step"
+    curves with literal stop outputs. Any other subexpression is kept as a
+    tree and evaluated through Expression::evaluate() from within the
+    bytecode, so every expression can be compiled, and evaluating the bytecode
+    produces the same result or error as evaluating the tree.
+*/
+class Bytecode {
+public:
+    // Returns nullptr when no part of the expression can be lowered; evaluating the
+    // expression tree directly is at least as fast in that case.
+    static std::unique_ptr<Bytecode> compile(const Expression&);
+
+    EvaluationResult evaluate(const EvaluationContext&) const;
+
+    // Evaluates the bytecode for each feature of the batch, reading feature properties
+    // from the batch's columns.
+    std::vector<EvaluationResult> evaluate(const FeatureBatch&, optional<float> zoom) const;
+
+    // Number of subexpressions that are evaluated as trees.
+    std::size_t fallbackCount() const { return fallbacks.size(); }
+
+private:
+    class Compiler;
+
+    using Columns = std::vector<const std::vector<Value>*>;
+
+    // When columns are given, "get" reads the given row of the column for its key instead of
+    // looking the property up on the feature.
+    EvaluationResult evaluate(const EvaluationContext&, const Columns*, std::size_t row) const;
+
+    enum class Op : uint8_t {
+        LoadNumber,     // numbers[dst] = number
+        LoadValue,      // values[dst] = constants[index]
+        Zoom,           // numbers[dst] = zoom
+        HeatmapDensity, // numbers[dst] = heatmap density
+        Get,            // values[dst] = feature property keys[index]
+        AssertNumber,   // numbers[dst] = values[a], which must be a number
+        Unbox,          // numbers[dst] = values[a]
+        Sum,            // numbers[dst] = sum of numbers[operands[index...index + count]]
+        Product,
+        Min,
+        Max,
+        Subtract,       // numbers[dst] = numbers[a] - numbers[b]
+        Divide,
+        Modulo,
+        Power,
+        Negate,         // numbers[dst] = -numbers[a]
+        Math,           // numbers[dst] = function(numbers[a])
+        Interpolate,    // numbers[dst] or values[dst] = curves[index] at numbers[a]
+        Step,
+        Evaluate,       // values[dst] = fallbacks[index]->evaluate()
+    };
+
+    struct Instruction {
+        Op op;
+        uint16_t dst = 0;
+        uint16_t a = 0;
+        uint16_t b = 0;
+        uint16_t count = 0;
+        uint32_t index = 0;
+        double number = 0;
+        double (*function)(double) = nullptr;
+    };
+
+    // Stops of an "interpolate" or "step" expression whose outputs are all literals.
+    struct Curve {
+        const InterpolateBase* interpolate = nullptr; // null for "step"
+        bool numeric = false;                         // outputs are numbers
+        std::vector<double> inputs;
+        std::vector<double> numbers;
+        std::vector<Value> values;
+    };
+
+    std::vector<Instruction> instructions;
+    std::vector<uint16_t> operands;
+    std::vector<Value> constants;
+    std::vector<std::string> keys;
+    std::vector<Curve> curves;
+    std::vector<const Expression*> fallbacks;
+
+    uint16_t numberRegisters = 0;
+    uint16_t valueRegisters = 0;
+    bool resultIsNumber = false;
+    uint16_t result = 0;
+};
+
+} // namespace expression
+} // namespace style
+} // namespace mbgl
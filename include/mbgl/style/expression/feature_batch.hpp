@@ -0,0 +1,43 @@
+#pragma once
+
+#include <mbgl/style/expression/value.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+class GeometryTileFeature;
+
+namespace style {
+namespace expression {
+
+/*
+    A FeatureBatch is a list of features, typically the features of one source layer
+    that pass a layer's filter, that are evaluated together. Each feature property an
+    expression reads is decoded for all features of the batch once and stored as a
+    column, rather than being looked up through GeometryTileFeature::getValue() every
+    time an expression is evaluated for a feature.
+*/
+class FeatureBatch {
+public:
+    FeatureBatch(std::vector<const GeometryTileFeature*> features_)
+        : features(std::move(features_)) {}
+
+    std::size_t size() const { return features.size(); }
+    const GeometryTileFeature& operator[](std::size_t i) const { return *features[i]; }
+    const std::vector<const GeometryTileFeature*>& getFeatures() const { return features; }
+
+    // The value of the given property for each feature of the batch, or Null for features
+    // that don't have the property. Decoded on first use.
+    const std::vector<Value>& column(const std::string& key) const;
+
+private:
+    std::vector<const GeometryTileFeature*> features;
+    mutable std::unordered_map<std::string, std::vector<Value>> columns;
+};
+
+} // namespace expression
+} // namespace style
+} // namespace mbgl
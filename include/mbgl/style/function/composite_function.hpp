@@ -1,6 +1,8 @@
 #pragma once
 
 #include <mbgl/style/expression/expression.hpp>
+#include <mbgl/style/expression/bytecode.hpp>
+#include <mbgl/style/expression/feature_batch.hpp>
 #include <mbgl/style/expression/interpolate.hpp>
 #include <mbgl/style/expression/step.hpp>
 #include <mbgl/style/expression/find_zoom_curve.hpp>
@@ -53,6 +55,7 @@ public:
     CompositeFunction(std::unique_ptr<expression::Expression> expression_)
     :   isExpression(true),
         expression(std::move(expression_)),
+        bytecode(expression::Bytecode::compile(*expression)),
         zoomCurve(expression::findZoomCurveChecked(expression.get()))
     {
         assert(!expression::isZoomConstant(*expression));
@@ -65,12 +68,13 @@ public:
         expression(stops.match([&] (const auto& s) {
             return expression::Convert::toExpression(property, s);
         })),
+        bytecode(expression::Bytecode::compile(*expression)),
         zoomCurve(expression::findZoomCurveChecked(expression.get()))
     {}
 
     // Return the range obtained by evaluating the function at each of the zoom levels in zoomRange
     template <class Feature>
-    Range<T> evaluate(const Range<float>& zoomRange, const Feature& feature, T finalDefaultValue) {
+    Range<T> evaluate(const Range<float>& zoomRange, const Feature& feature, T finalDefaultValue) const {
         return Range<T> {
             evaluate(zoomRange.min, feature, finalDefaultValue),
             evaluate(zoomRange.max, feature, finalDefaultValue)
@@ -79,12 +83,35 @@ public:
 
     template <class Feature>
     T evaluate(float zoom, const Feature& feature, T finalDefaultValue) const {
-        const expression::EvaluationResult result = expression->evaluate(expression::EvaluationContext({zoom}, &feature));
-        if (result) {
-            const optional<T> typed = expression::fromExpressionValue<T>(*result);
-            return typed ? *typed : defaultValue ? *defaultValue : finalDefaultValue;
+        const expression::EvaluationContext context({zoom}, &feature);
+        return fromResult(bytecode ? bytecode->evaluate(context) : expression->evaluate(context), finalDefaultValue);
+    }
+
+    // Evaluates the function for each feature of the batch at each of the zoom levels in zoomRange.
+    std::vector<Range<T>> evaluate(const Range<float>& zoomRange, const expression::FeatureBatch& batch, T finalDefaultValue) const {
+        std::vector<T> min = evaluate(zoomRange.min, batch, finalDefaultValue);
+        std::vector<T> max = evaluate(zoomRange.max, batch, finalDefaultValue);
+        std::vector<Range<T>> ranges;
+        ranges.reserve(batch.size());
+        for (std::size_t i = 0; i < batch.size(); i++) {
+            ranges.push_back({ std::move(min[i]), std::move(max[i]) });
         }
-        return defaultValue ? *defaultValue : finalDefaultValue;
+        return ranges;
+    }
+
+    std::vector<T> evaluate(float zoom, const expression::FeatureBatch& batch, T finalDefaultValue) const {
+        std::vector<T> values;
+        values.reserve(batch.size());
+        if (bytecode) {
+            for (const auto& result : bytecode->evaluate(batch, { zoom })) {
+                values.push_back(fromResult(result, finalDefaultValue));
+            }
+        } else {
+            for (std::size_t i = 0; i < batch.size(); i++) {
+                values.push_back(evaluate(zoom, batch[i], finalDefaultValue));
+            }
+        }
+        return values;
     }
     
     float interpolationFactor(const Range<float>& inputLevels, const float inputValue) const {
@@ -117,8 +144,17 @@ public:
     bool isExpression;
     
 private:
+    T fromResult(const expression::EvaluationResult& result, const T& finalDefaultValue) const {
+        if (result) {
+            const optional<T> typed = expression::fromExpressionValue<T>(*result);
+            return typed ? *typed : defaultValue ? *defaultValue : finalDefaultValue;
+        }
+        return defaultValue ? *defaultValue : finalDefaultValue;
+    }
+
     optional<T> defaultValue;
     std::shared_ptr<expression::Expression> expression;
+    std::shared_ptr<const expression::Bytecode> bytecode;
     const variant<const expression::InterpolateBase*, const expression::Step*> zoomCurve;
 };
 
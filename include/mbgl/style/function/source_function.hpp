@@ -1,5 +1,7 @@
 #pragma once
 
+#include <mbgl/style/expression/bytecode.hpp>
+#include <mbgl/style/expression/feature_batch.hpp>
 #include <mbgl/style/expression/is_constant.hpp>
 #include <mbgl/style/function/convert.hpp>
 #include <mbgl/style/function/exponential_stops.hpp>
@@ -31,7 +33,8 @@ public:
 
     SourceFunction(std::unique_ptr<expression::Expression> expression_)
         : isExpression(true),
-          expression(std::move(expression_))
+          expression(std::move(expression_)),
+          bytecode(expression::Bytecode::compile(*expression))
     {
         assert(expression::isZoomConstant(*expression));
         assert(!expression::isFeatureConstant(*expression));
@@ -44,17 +47,30 @@ public:
               return expression::Convert::fromIdentityFunction(expression::valueTypeToExpressionType<T>(), property);
           }, [&] (const auto& s) {
               return expression::Convert::toExpression(property, s);
-          }))
+          })),
+          bytecode(expression::Bytecode::compile(*expression))
     {}
 
     template <class Feature>
     T evaluate(const Feature& feature, T finalDefaultValue) const {
-        const expression::EvaluationResult result = expression->evaluate(expression::EvaluationContext(&feature));
-        if (result) {
-            const optional<T> typed = expression::fromExpressionValue<T>(*result);
-            return typed ? *typed : defaultValue ? *defaultValue : finalDefaultValue;
+        const expression::EvaluationContext context(&feature);
+        return fromResult(bytecode ? bytecode->evaluate(context) : expression->evaluate(context), finalDefaultValue);
+    }
+
+    // Evaluates the function for each feature of the batch.
+    std::vector<T> evaluate(const expression::FeatureBatch& batch, T finalDefaultValue) const {
+        std::vector<T> values;
+        values.reserve(batch.size());
+        if (bytecode) {
+            for (const auto& result : bytecode->evaluate(batch, {})) {
+                values.push_back(fromResult(result, finalDefaultValue));
+            }
+        } else {
+            for (std::size_t i = 0; i < batch.size(); i++) {
+                values.push_back(evaluate(batch[i], finalDefaultValue));
+            }
         }
-        return defaultValue ? *defaultValue : finalDefaultValue;
+        return values;
     }
 
     std::vector<optional<T>> possibleOutputs() const {
@@ -72,8 +88,17 @@ public:
     const expression::Expression& getExpression() const { return *expression; }
 
 private:
+    T fromResult(const expression::EvaluationResult& result, const T& finalDefaultValue) const {
+        if (result) {
+            const optional<T> typed = expression::fromExpressionValue<T>(*result);
+            return typed ? *typed : defaultValue ? *defaultValue : finalDefaultValue;
+        }
+        return defaultValue ? *defaultValue : finalDefaultValue;
+    }
+
     optional<T> defaultValue;
     std::shared_ptr<expression::Expression> expression;
+    std::shared_ptr<const expression::Bytecode> bytecode;
 };
 
 } // namespace style
@@ -39,7 +39,12 @@ public:
     CustomGeometrySource(std::string id, CustomGeometrySource::Options options);
     ~CustomGeometrySource() final;
     void loadDescription(FileSource&) final;
-    void setTileData(const CanonicalTileID&, const GeoJSON&);
+    // The data is clipped and converted to tile coordinates once on a worker thread, and shared
+    // by all tiles that are rendered from the canonical tile.
+    void setTileData(const CanonicalTileID&, GeoJSON);
+    // Sets features that are already in the coordinates of the tile, with an extent of
+    // util::EXTENT, so that they are used as they are.
+    void setTileFeatures(const CanonicalTileID&, mapbox::geometry::feature_collection<int16_t>);
     void invalidateTile(const CanonicalTileID&);
     void invalidateRegion(const LatLngBounds&);
     // Private implementation
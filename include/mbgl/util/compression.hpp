@@ -1,12 +1,26 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace mbgl {
 namespace util {
 
-std::string compress(const std::string& raw);
+// Values are stored in the offline database and must not change.
+enum class Compression : uint8_t {
+    None = 0,
+    Zlib = 1,
+    Fast = 2,
+};
+
+// zlib streams. The level ranges from 0 (store) to 9 (best); -1 selects zlib's default.
+std::string compress(const std::string& raw, int level = -1);
 std::string decompress(const std::string& raw);
 
+// A byte-oriented LZ77 codec in the style of LZ4. It compresses less than zlib, but is
+// several times faster in both directions.
+std::string compressFast(const std::string& raw);
+std::string decompressFast(const std::string& raw);
+
 } // namespace util
 } // namespace mbgl
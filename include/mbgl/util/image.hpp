@@ -11,6 +11,8 @@
 
 namespace mbgl {
 
+class Scheduler;
+
 enum class ImageAlphaMode {
     Unassociated,
     Premultiplied,
@@ -174,4 +176,23 @@ using AlphaImage = Image<ImageAlphaMode::Exclusive>;
 PremultipliedImage decodeImage(const std::string&);
 std::string encodePNG(const PremultipliedImage&);
 
+class PNGEncodeOptions {
+public:
+    // zlib level, from 0 (store) to 9 (best); -1 selects zlib's default.
+    int compressionLevel = -1;
+
+    // Writes an 8 bit palette of at most 256 colors instead of RGBA. Images with more colors
+    // are quantized, which is lossy.
+    bool palette = false;
+
+    // When set, rows are filtered and compressed in chunks on the threads of the scheduler.
+    Scheduler* scheduler = nullptr;
+
+    // Takes the rows of the image from the bottom up, for pixels read from OpenGL, which returns
+    // the bottom row first.
+    bool flipY = false;
+};
+
+std::string encodePNG(const PremultipliedImage&, const PNGEncodeOptions&);
+
 } // namespace mbgl
@@ -2,11 +2,18 @@
 
 #include <mbgl/util/image.hpp>
 
+#include <cstddef>
+#include <cstdint>
+
 namespace mbgl {
 namespace util {
 
 PremultipliedImage premultiply(UnassociatedImage&&);
 UnassociatedImage unpremultiply(PremultipliedImage&&);
 
+// Premultiplies `count` consecutive RGBA pixels in place. Decoders use this to premultiply
+// each row as soon as it has been decoded, while it is still in cache.
+void premultiply(uint8_t* data, std::size_t count);
+
 } // namespace util
 } // namespace mbgl
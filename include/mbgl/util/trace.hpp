@@ -0,0 +1,86 @@
+#pragma once
+
+#include <mbgl/util/event.hpp>
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <atomic>
+#include <string>
+
+namespace mbgl {
+
+// Records timed events from the tile loading and rendering pipelines, which can be exported in
+// the Chrome trace event format and viewed in chrome://tracing or Perfetto. Recording is off by
+// default; while it's off, tracing a scope costs a single relaxed atomic load.
+class Trace {
+public:
+    // Starts recording, discarding the events of any earlier recording.
+    static void start();
+
+    // Stops recording. The events that were recorded are kept until the next call to start().
+    static void stop();
+
+    static bool isRecording() {
+        return recording.load(std::memory_order_relaxed);
+    }
+
+    // Returns the recorded events as a Chrome trace event JSON object.
+    static std::string toChromeTraceJSON();
+
+    // Records an event that ran on the current thread from begin to end. Events of a thread must
+    // nest; use recordAsync() for operations that overlap with other work on the thread.
+    static void record(Event, std::string name, TimePoint begin, TimePoint end, std::string detail = {});
+
+    // Records an operation that was in flight from begin to end, such as a network request.
+    static void recordAsync(Event, std::string name, TimePoint begin, TimePoint end, std::string detail = {});
+
+private:
+    static std::atomic<bool> recording;
+};
+
+namespace util {
+
+// Records the lifetime of the scope as a trace event, if recording is on when it's entered.
+class TraceScope : private noncopyable {
+public:
+    TraceScope(Event event_, const char* name_)
+        : event(event_),
+          name(Trace::isRecording() ? name_ : nullptr) {
+        if (name) {
+            begin = Clock::now();
+        }
+    }
+
+    ~TraceScope() {
+        if (name) {
+            Trace::record(event, name, begin, Clock::now(), std::move(detail));
+        }
+    }
+
+    // Whether the scope is being recorded. Use this to skip building details that won't be used.
+    explicit operator bool() const {
+        return name != nullptr;
+    }
+
+    void setDetail(std::string detail_) {
+        detail = std::move(detail_);
+    }
+
+private:
+    const Event event;
+    const char* const name;
+    TimePoint begin;
+    std::string detail;
+};
+
+#define __MBGL_TRACE_NAME2(counter) __MBGL_TRACE_##counter
+#define __MBGL_TRACE_NAME(counter) __MBGL_TRACE_NAME2(counter)
+
+// Traces the rest of the enclosing scope. The detail expression is only evaluated when recording.
+#define MBGL_TRACE(event, name) const ::mbgl::util::TraceScope __MBGL_TRACE_NAME(__LINE__)(event, name);
+#define MBGL_TRACE_DETAIL(event, name, detail) \
+    ::mbgl::util::TraceScope __MBGL_TRACE_NAME(__LINE__)(event, name); \
+    if (__MBGL_TRACE_NAME(__LINE__)) __MBGL_TRACE_NAME(__LINE__).setDetail(detail);
+
+} // namespace util
+} // namespace mbgl
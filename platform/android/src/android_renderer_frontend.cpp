@@ -41,6 +41,10 @@ public:
         delegate.invoke(&RendererObserver::onWillStartRenderingFrame);
     }
 
+    void onRenderingStats(const RenderingStats& stats) override {
+        delegate.invoke(&RendererObserver::onRenderingStats, stats);
+    }
+
     void onDidFinishRenderingFrame(RenderMode mode, bool repaintNeeded) override {
         delegate.invoke(&RendererObserver::onDidFinishRenderingFrame, mode, repaintNeeded);
     }
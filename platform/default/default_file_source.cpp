@@ -8,6 +8,8 @@
 #include <mbgl/storage/resource_transform.hpp>
 
 #include <mbgl/util/platform.hpp>
+#include <mbgl/util/string.hpp>
+#include <mbgl/util/traits.hpp>
 #include <mbgl/util/url.hpp>
 #include <mbgl/util/thread.hpp>
 #include <mbgl/util/work_request.hpp>
@@ -114,59 +116,67 @@ public:
         } else if (LocalFileSource::acceptsURL(resource.url)) {
             //Local file request
             tasks[req] = localFileSource->request(resource, callback);
-        } else {
-            // Try the offline database
-            if (resource.hasLoadingMethod(Resource::LoadingMethod::Cache)) {
-                auto offlineResponse = offlineDatabase->get(resource);
-
-                if (resource.loadingMethod == Resource::LoadingMethod::CacheOnly) {
-                    if (!offlineResponse) {
-                        // Ensure there's always a response that we can send, so the caller knows that
-                        // there's no optional data available in the cache, when it's the only place
-                        // we're supposed to load from.
-                        offlineResponse.emplace();
-                        offlineResponse->noContent = true;
-                        offlineResponse->error = std::make_unique<Response::Error>(
-                                Response::Error::Reason::NotFound, "Not found in offline database");
-                    } else if (!offlineResponse->isUsable()) {
-                        // Don't return resources the server requested not to show when they're stale.
-                        // Even if we can't directly use the response, we may still use it to send a
-                        // conditional HTTP request, which is why we're saving it above.
-                        offlineResponse->error = std::make_unique<Response::Error>(
-                            Response::Error::Reason::NotFound, "Cached resource is unusable");
-                    }
-                    callback(*offlineResponse);
-                } else if (offlineResponse) {
-                    // Copy over the fields so that we can use them when making a refresh request.
-                    resource.priorModified = offlineResponse->modified;
-                    resource.priorExpires = offlineResponse->expires;
-                    resource.priorEtag = offlineResponse->etag;
-                    resource.priorData = offlineResponse->data;
-
-                    if (offlineResponse->isUsable()) {
-                        callback(*offlineResponse);
-                    }
+        } else if (isSharable(resource)) {
+            // Join an identical request that is already in flight, or start one that later
+            // identical requests can join.
+            const std::string key = sharedRequestKey(resource);
+            requestKeys[req] = key;
+
+            auto it = sharedRequests.find(key);
+            if (it != sharedRequests.end()) {
+                SharedRequest& shared = it->second;
+                shared.requestors.emplace(req, ref);
+                if (shared.response) {
+                    ref.invoke(&FileSourceRequest::setResponse, *shared.response);
                 }
+                return;
             }
 
-            // Get from the online file source
-            if (resource.hasLoadingMethod(Resource::LoadingMethod::Network)) {
-                tasks[req] = onlineFileSource.request(resource, [=] (Response onlineResponse) mutable {
-                    this->offlineDatabase->put(resource, onlineResponse);
-                    callback(onlineResponse);
-                });
-            }
+            sharedRequests[key].requestors.emplace(req, ref);
+            auto task = requestDatabaseOrNetwork(std::move(resource), [this, key] (const Response& res) {
+                auto sharedIt = sharedRequests.find(key);
+                if (sharedIt == sharedRequests.end()) {
+                    return;
+                }
+                SharedRequest& shared = sharedIt->second;
+                shared.response = res;
+                for (auto& requestor : shared.requestors) {
+                    requestor.second.invoke(&FileSourceRequest::setResponse, res);
+                }
+            });
+
+            sharedRequests[key].task = std::move(task);
+        } else {
+            tasks[req] = requestDatabaseOrNetwork(std::move(resource), callback);
         }
     }
 
     void cancel(AsyncRequest* req) {
-        tasks.erase(req);
+        auto keyIt = requestKeys.find(req);
+        if (keyIt == requestKeys.end()) {
+            tasks.erase(req);
+            return;
+        }
+
+        auto it = sharedRequests.find(keyIt->second);
+        requestKeys.erase(keyIt);
+
+        if (it != sharedRequests.end()) {
+            it->second.requestors.erase(req);
+            if (it->second.requestors.empty()) {
+                sharedRequests.erase(it);
+            }
+        }
     }
 
     void setOfflineMapboxTileCountLimit(uint64_t limit) {
         offlineDatabase->setOfflineMapboxTileCountLimit(limit);
     }
 
+    void setCacheCompression(Resource::Kind kind, util::Compression codec, int level) {
+        offlineDatabase->setCompression(kind, codec, level);
+    }
+
     void setOnlineStatus(const bool status) {
         onlineFileSource.setOnlineStatus(status);
     }
@@ -176,6 +186,72 @@ public:
     }
 
 private:
+    // Answers from the offline database if possible, then requests the resource from the network
+    // if its loading method allows. Returns the network request, if one was made.
+    std::unique_ptr<AsyncRequest> requestDatabaseOrNetwork(Resource resource, std::function<void (const Response&)> callback) {
+        // Try the offline database
+        if (resource.hasLoadingMethod(Resource::LoadingMethod::Cache)) {
+            auto offlineResponse = offlineDatabase->get(resource);
+
+            if (resource.loadingMethod == Resource::LoadingMethod::CacheOnly) {
+                if (!offlineResponse) {
+                    // Ensure there's always a response that we can send, so the caller knows that
+                    // there's no optional data available in the cache, when it's the only place
+                    // we're supposed to load from.
+                    offlineResponse.emplace();
+                    offlineResponse->noContent = true;
+                    offlineResponse->error = std::make_unique<Response::Error>(
+                            Response::Error::Reason::NotFound, "Not found in offline database");
+                } else if (!offlineResponse->isUsable()) {
+                    // Don't return resources the server requested not to show when they're stale.
+                    // Even if we can't directly use the response, we may still use it to send a
+                    // conditional HTTP request, which is why we're saving it above.
+                    offlineResponse->error = std::make_unique<Response::Error>(
+                        Response::Error::Reason::NotFound, "Cached resource is unusable");
+                }
+                callback(*offlineResponse);
+            } else if (offlineResponse) {
+                // Copy over the fields so that we can use them when making a refresh request.
+                resource.priorModified = offlineResponse->modified;
+                resource.priorExpires = offlineResponse->expires;
+                resource.priorEtag = offlineResponse->etag;
+                resource.priorData = offlineResponse->data;
+
+                if (offlineResponse->isUsable()) {
+                    callback(*offlineResponse);
+                }
+            }
+        }
+
+        // Get from the online file source
+        if (resource.hasLoadingMethod(Resource::LoadingMethod::Network)) {
+            return onlineFileSource.request(resource, [=] (Response onlineResponse) mutable {
+                this->offlineDatabase->put(resource, onlineResponse);
+                callback(onlineResponse);
+            });
+        }
+
+        return {};
+    }
+
+    // Requests that carry state from an earlier response, such as tile refreshes, are answered
+    // relative to that state and can't be shared with other requestors.
+    static bool isSharable(const Resource& resource) {
+        return (resource.loadingMethod & Resource::LoadingMethod::Network) != Resource::LoadingMethod::None &&
+               !resource.priorModified && !resource.priorExpires && !resource.priorEtag && !resource.priorData;
+    }
+
+    static std::string sharedRequestKey(const Resource& resource) {
+        std::string key = util::toString(uint8_t(resource.kind)) + ' ' +
+                          util::toString(underlying_type(resource.loadingMethod)) + ' ' + resource.url;
+        if (resource.tileData) {
+            const Resource::TileData& tile = *resource.tileData;
+            key += ' ' + tile.urlTemplate + ' ' + util::toString(tile.pixelRatio) + '/' + util::toString(tile.z) +
+                   '/' + util::toString(tile.x) + '/' + util::toString(tile.y);
+        }
+        return key;
+    }
+
     OfflineDownload& getDownload(int64_t regionID) {
         auto it = downloads.find(regionID);
         if (it != downloads.end()) {
@@ -192,6 +268,15 @@ private:
     OnlineFileSource onlineFileSource;
     std::unordered_map<AsyncRequest*, std::unique_ptr<AsyncRequest>> tasks;
     std::unordered_map<int64_t, std::unique_ptr<OfflineDownload>> downloads;
+
+    // Identical in-flight requests share one fetch, keyed by sharedRequestKey().
+    struct SharedRequest {
+        std::unique_ptr<AsyncRequest> task;
+        std::unordered_map<AsyncRequest*, ActorRef<FileSourceRequest>> requestors;
+        optional<Response> response;
+    };
+    std::unordered_map<std::string, SharedRequest> sharedRequests;
+    std::unordered_map<AsyncRequest*, std::string> requestKeys;
 };
 
 DefaultFileSource::DefaultFileSource(const std::string& cachePath,
@@ -287,6 +372,10 @@ void DefaultFileSource::setOfflineMapboxTileCountLimit(uint64_t limit) const {
     impl->actor().invoke(&Impl::setOfflineMapboxTileCountLimit, limit);
 }
 
+void DefaultFileSource::setCacheCompression(Resource::Kind kind, util::Compression codec, int level) {
+    impl->actor().invoke(&Impl::setCacheCompression, kind, codec, level);
+}
+
 void DefaultFileSource::pause() {
     impl->pause();
 }
@@ -1,9 +1,6 @@
 #include <mbgl/util/image.hpp>
-#include <mbgl/util/char_array_buffer.hpp>
 
-#include <istream>
-#include <sstream>
-#include <array>
+#include <stdexcept>
 
 extern "C"
 {
@@ -12,62 +9,43 @@ extern "C"
 
 namespace mbgl {
 
-const static unsigned BUF_SIZE = 4096;
-
-struct jpeg_stream_wrapper {
-    jpeg_source_mgr manager;
-    std::istream* stream;
-    std::array<JOCTET, BUF_SIZE> buffer;
-};
-
-static void init_source(j_decompress_ptr cinfo) {
-    auto* wrap = reinterpret_cast<jpeg_stream_wrapper*>(cinfo->src);
-    wrap->stream->seekg(0, std::ios_base::beg);
-}
+// The source manager hands libjpeg the whole encoded buffer at once, so no data is copied.
+static void init_source(j_decompress_ptr) {}
 
 static boolean fill_input_buffer(j_decompress_ptr cinfo) {
-    auto* wrap = reinterpret_cast<jpeg_stream_wrapper*>(cinfo->src);
-    wrap->stream->read(reinterpret_cast<char*>(&wrap->buffer[0]), BUF_SIZE);
-    std::streamsize size = wrap->stream->gcount();
-    wrap->manager.next_input_byte = wrap->buffer.data();
-    wrap->manager.bytes_in_buffer = BUF_SIZE;
-    return (size > 0) ? TRUE : FALSE;
+    // The data ran out before the image ended. Insert a fake EOI marker, as libjpeg's own
+    // memory source does, so that the truncated image is reported instead of waiting for
+    // more data.
+    static const JOCTET eoi[] = { 0xFF, JPEG_EOI };
+    cinfo->src->next_input_byte = eoi;
+    cinfo->src->bytes_in_buffer = 2;
+    return TRUE;
 }
 
 static void skip(j_decompress_ptr cinfo, long count) {
     if (count <= 0) return; // A zero or negative skip count should be treated as a no-op.
-    auto* wrap = reinterpret_cast<jpeg_stream_wrapper*>(cinfo->src);
-
-    if (wrap->manager.bytes_in_buffer > 0 && count < static_cast<long>(wrap->manager.bytes_in_buffer))
-    {
-        wrap->manager.bytes_in_buffer -= count;
-        wrap->manager.next_input_byte = &wrap->buffer[BUF_SIZE - wrap->manager.bytes_in_buffer];
-    }
-    else
-    {
-        wrap->stream->seekg(count - wrap->manager.bytes_in_buffer, std::ios_base::cur);
-        // trigger buffer fill
-        wrap->manager.next_input_byte = nullptr;
-        wrap->manager.bytes_in_buffer = 0; // bytes_in_buffer may be zero on return.
+    if (static_cast<size_t>(count) > cinfo->src->bytes_in_buffer) {
+        fill_input_buffer(cinfo);
+    } else {
+        cinfo->src->next_input_byte += count;
+        cinfo->src->bytes_in_buffer -= count;
     }
 }
 
 static void term(j_decompress_ptr) {}
 
-static void attach_stream(j_decompress_ptr cinfo, std::istream* in) {
+static void attach_memory(j_decompress_ptr cinfo, const uint8_t* data, size_t size) {
     if (cinfo->src == nullptr) {
         cinfo->src = (struct jpeg_source_mgr *)
-            (*cinfo->mem->alloc_small) ((j_common_ptr) cinfo, JPOOL_PERMANENT, sizeof(jpeg_stream_wrapper));
+            (*cinfo->mem->alloc_small) ((j_common_ptr) cinfo, JPOOL_PERMANENT, sizeof(jpeg_source_mgr));
     }
-    auto * src = reinterpret_cast<jpeg_stream_wrapper*> (cinfo->src);
-    src->manager.init_source = init_source;
-    src->manager.fill_input_buffer = fill_input_buffer;
-    src->manager.skip_input_data = skip;
-    src->manager.resync_to_restart = jpeg_resync_to_restart;
-    src->manager.term_source = term;
-    src->manager.bytes_in_buffer = 0;
-    src->manager.next_input_byte = nullptr;
-    src->stream = in;
+    cinfo->src->init_source = init_source;
+    cinfo->src->fill_input_buffer = fill_input_buffer;
+    cinfo->src->skip_input_data = skip;
+    cinfo->src->resync_to_restart = jpeg_resync_to_restart;
+    cinfo->src->term_source = term;
+    cinfo->src->bytes_in_buffer = size;
+    cinfo->src->next_input_byte = reinterpret_cast<const JOCTET*>(data);
 }
 
 static void on_error(j_common_ptr) {}
@@ -90,9 +68,6 @@ struct jpeg_info_guard {
 };
 
 PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
-    util::CharArrayBuffer dataBuffer { reinterpret_cast<const char*>(data), size };
-    std::istream stream(&dataBuffer);
-
     jpeg_decompress_struct cinfo;
     jpeg_info_guard iguard(&cinfo);
     jpeg_error_mgr jerr;
@@ -100,7 +75,7 @@ PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
     jerr.error_exit = on_error;
     jerr.output_message = on_error_message;
     jpeg_create_decompress(&cinfo);
-    attach_stream(&cinfo, &stream);
+    attach_memory(&cinfo, data, size);
 
     int ret = jpeg_read_header(&cinfo, TRUE);
     if (ret != JPEG_HEADER_OK)
@@ -117,27 +92,30 @@ PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
     size_t width = cinfo.output_width;
     size_t height = cinfo.output_height;
     size_t components = cinfo.output_components;
-    size_t rowStride = components * width;
 
-    PremultipliedImage image({ static_cast<uint32_t>(width), static_cast<uint32_t>(height) });
-    uint8_t* dst = image.data.get();
+    if (components > 4)
+        throw std::runtime_error("JPEG Reader: unsupported number of components");
 
-    JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr) &cinfo, JPOOL_IMAGE, rowStride, 1);
+    PremultipliedImage image({ static_cast<uint32_t>(width), static_cast<uint32_t>(height) });
+    const size_t stride = image.stride();
 
     while (cinfo.output_scanline < cinfo.output_height) {
-        jpeg_read_scanlines(&cinfo, buffer, 1);
+        // Decode the scanline into the end of its row, and expand it to RGBA front to back.
+        // Pixel i is read before it is written, and its output never reaches the input of
+        // pixel i + 1, so no separate scanline buffer is needed.
+        uint8_t* dst = image.data.get() + cinfo.output_scanline * stride;
+        JSAMPROW src = dst + (4 - components) * width;
+        jpeg_read_scanlines(&cinfo, &src, 1);
 
         for (size_t i = 0; i < width; ++i) {
-            dst[0] = buffer[0][components * i];
-            dst[3] = 0xFF;
+            const uint8_t r = src[components * i];
+            const uint8_t g = components > 2 ? src[components * i + 1] : r;
+            const uint8_t b = components > 2 ? src[components * i + 2] : r;
 
-            if (components > 2) {
-                dst[1] = buffer[0][components * i + 1];
-                dst[2] = buffer[0][components * i + 2];
-            } else {
-                dst[1] = dst[0];
-                dst[2] = dst[0];
-            }
+            dst[0] = r;
+            dst[1] = g;
+            dst[2] = b;
+            dst[3] = 0xFF;
 
             dst += 4;
         }
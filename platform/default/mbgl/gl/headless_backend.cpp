@@ -82,4 +82,14 @@ PremultipliedImage HeadlessBackend::readStillImage() {
     return getContext().readFramebuffer<PremultipliedImage>(size);
 }
 
+std::unique_ptr<gl::Readback> HeadlessBackend::startStillImageReadback() {
+    return std::make_unique<gl::Readback>(getContext().startReadback(size));
+}
+
+PremultipliedImage HeadlessBackend::finishStillImageReadback(std::unique_ptr<gl::Readback> readback) {
+    assert(readback);
+    const Size imageSize = readback->size;
+    return { imageSize, getContext().finishReadback(std::move(*readback)) };
+}
+
 } // namespace mbgl
@@ -7,6 +7,10 @@
 
 namespace mbgl {
 
+namespace gl {
+class Readback;
+} // namespace gl
+
 class HeadlessBackend : public RendererBackend {
 public:
     HeadlessBackend(Size = { 256, 256 });
@@ -19,6 +23,11 @@ public:
     void setSize(Size);
     PremultipliedImage readStillImage();
 
+    // Starts reading the rendered image without waiting for the GPU where the context supports
+    // pixel buffer objects. The image of a finished readback has its rows ordered bottom to top.
+    std::unique_ptr<gl::Readback> startStillImageReadback();
+    PremultipliedImage finishStillImageReadback(std::unique_ptr<gl::Readback>);
+
     class Impl {
     public:
         virtual ~Impl() = default;
@@ -1,10 +1,19 @@
 #include <mbgl/gl/headless_frontend.hpp>
+#include <mbgl/gl/readback.hpp>
+#include <mbgl/renderer/backend_scope.hpp>
 #include <mbgl/renderer/renderer.hpp>
 #include <mbgl/renderer/update_parameters.hpp>
 #include <mbgl/map/map.hpp>
 #include <mbgl/map/transform_state.hpp>
+#include <mbgl/map/camera.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/geo.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
 namespace mbgl {
 
 HeadlessFrontend::HeadlessFrontend(float pixelRatio_, FileSource& fileSource, Scheduler& scheduler, const optional<std::string> programCacheDir, GLContextMode mode, const optional<std::string> localFontFamily)
@@ -85,6 +94,147 @@ PremultipliedImage HeadlessFrontend::render(Map& map) {
     return result;
 }
 
+HeadlessFrontend::DeferredImage::DeferredImage(HeadlessBackend& backend_, std::unique_ptr<gl::Readback> readback_)
+    : backend(backend_), readback(std::move(readback_)) {
+}
+
+HeadlessFrontend::DeferredImage::DeferredImage(DeferredImage&&) = default;
+
+HeadlessFrontend::DeferredImage::~DeferredImage() = default;
+
+PremultipliedImage HeadlessFrontend::DeferredImage::get() {
+    assert(readback);
+    PremultipliedImage image = [&] {
+        BackendScope guard { backend };
+        return backend.finishStillImageReadback(std::move(readback));
+    }();
+
+    const size_t stride = image.stride();
+    uint8_t* rgba = image.data.get();
+    for (int i = 0, j = image.size.height - 1; i < j; i++, j--) {
+        std::swap_ranges(rgba + i * stride, rgba + (i + 1) * stride, rgba + j * stride);
+    }
+    return image;
+}
+
+std::string HeadlessFrontend::DeferredImage::encodePNG(PNGEncodeOptions options) {
+    assert(readback);
+    PremultipliedImage image = [&] {
+        BackendScope guard { backend };
+        return backend.finishStillImageReadback(std::move(readback));
+    }();
+
+    options.flipY = true;
+    return mbgl::encodePNG(image, options);
+}
+
+HeadlessFrontend::DeferredImage HeadlessFrontend::renderDeferred(Map& map) {
+    std::unique_ptr<gl::Readback> readback;
+
+    map.renderStill([&](std::exception_ptr error) {
+        if (error) {
+            std::rethrow_exception(error);
+        } else {
+            readback = backend.startStillImageReadback();
+        }
+    });
+
+    while (!readback) {
+        util::RunLoop::Get()->runOnce();
+    }
+
+    return { backend, std::move(readback) };
+}
+
+void HeadlessFrontend::renderBatch(Map& map,
+                                   const std::vector<BatchItem>& items,
+                                   const std::function<void (std::size_t, PremultipliedImage)>& callback,
+                                   std::size_t lookahead) {
+    optional<DeferredImage> previous;
+
+    for (std::size_t i = 0; i < items.size(); i++) {
+        const auto upcoming = items.begin() + i + 1;
+        std::vector<CameraOptions> cameras;
+        std::transform(upcoming, upcoming + std::min(lookahead, items.size() - i - 1),
+                       std::back_inserter(cameras), [](const BatchItem& item) { return item.camera; });
+        map.setPrefetchCameras(std::move(cameras));
+
+        setSize(items[i].size);
+        map.setSize(items[i].size);
+        map.jumpTo(items[i].camera);
+
+        DeferredImage image = renderDeferred(map);
+        if (previous) {
+            callback(i - 1, previous->get());
+        }
+        previous.emplace(std::move(image));
+    }
+
+    map.setPrefetchCameras({});
+
+    if (previous) {
+        callback(items.size() - 1, previous->get());
+    }
+}
+
+std::vector<PremultipliedImage> HeadlessFrontend::renderMetatile(Map& map,
+                                                                 const CanonicalTileID& topLeft,
+                                                                 uint32_t span,
+                                                                 uint32_t tileSize,
+                                                                 uint32_t buffer) {
+    assert(tileSize > 0);
+    const uint32_t tiles = 1u << topLeft.z;
+    span = std::max(1u, std::min({ span, tiles - topLeft.x, tiles - topLeft.y }));
+
+    const uint32_t blockSize = span * tileSize + 2 * buffer;
+    setSize({ blockSize, blockSize });
+    map.setSize({ blockSize, blockSize });
+
+    // The block and its buffer may reach past the edges of the world, where constraining the
+    // camera would move it off the block.
+    const ConstrainMode constrainMode = map.getConstrainMode();
+    map.setConstrainMode(ConstrainMode::None);
+
+    // The center of the block is the corner of a tile one zoom level further in, which is
+    // valid for an odd span as well.
+    CameraOptions camera;
+    camera.center = LatLng(CanonicalTileID(topLeft.z + 1, 2 * topLeft.x + span, 2 * topLeft.y + span));
+    camera.zoom = topLeft.z + std::log2(tileSize / util::tileSize);
+    camera.angle = 0;
+    camera.pitch = 0;
+    map.jumpTo(camera);
+
+    PremultipliedImage block;
+    try {
+        block = render(map);
+    } catch (...) {
+        map.setConstrainMode(constrainMode);
+        throw;
+    }
+    map.setConstrainMode(constrainMode);
+
+    // The image has the physical size of the viewport, which is rounded down from the logical
+    // size scaled by the pixel ratio in the same way as the tiles.
+    const auto scaled = [&](uint32_t length) {
+        return static_cast<uint32_t>(length * pixelRatio);
+    };
+    const uint32_t tilePixels = scaled(tileSize);
+
+    std::vector<PremultipliedImage> result;
+    result.reserve(span * span);
+    for (uint32_t row = 0; row < span; row++) {
+        for (uint32_t column = 0; column < span; column++) {
+            PremultipliedImage tile({ tilePixels, tilePixels });
+            PremultipliedImage::copy(block, tile,
+                                     { scaled(buffer + column * tileSize), scaled(buffer + row * tileSize) },
+                                     { 0, 0 }, tile.size);
+            result.push_back(std::move(tile));
+        }
+    }
+
+    return result;
+}
+
 optional<TransformState> HeadlessFrontend::getTransformState() const {
     if (updateParameters) {
         return updateParameters->transformState;
@@ -1,12 +1,17 @@
 #pragma once
 
+#include <mbgl/map/camera.hpp>
 #include <mbgl/renderer/mode.hpp>
 #include <mbgl/renderer/renderer_frontend.hpp>
 #include <mbgl/gl/headless_backend.hpp>
 #include <mbgl/util/async_task.hpp>
 #include <mbgl/util/optional.hpp>
+#include <mbgl/util/constants.hpp>
 
+#include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace mbgl {
 
@@ -16,6 +21,11 @@ class Renderer;
 class RendererBackend;
 class Map;
 class TransformState;
+class CanonicalTileID;
+
+namespace gl {
+class Readback;
+} // namespace gl
 
 class HeadlessFrontend : public RendererFrontend {
 public:
@@ -36,6 +46,57 @@ public:
     PremultipliedImage readStillImage();
     PremultipliedImage render(Map&);
 
+    // A rendered image whose pixels may still be on their way from the GPU. It must be
+    // retrieved before the frontend is destroyed.
+    class DeferredImage {
+    public:
+        DeferredImage(HeadlessBackend&, std::unique_ptr<gl::Readback>);
+        DeferredImage(DeferredImage&&);
+        ~DeferredImage();
+
+        // Waits for the pixels. Can be called only once.
+        PremultipliedImage get();
+
+        // Waits for the pixels and encodes them, taking the rows in the order they were read
+        // instead of flipping them first. Can be called only once.
+        std::string encodePNG(PNGEncodeOptions);
+
+    private:
+        HeadlessBackend& backend;
+        std::unique_ptr<gl::Readback> readback;
+    };
+
+    // Renders a still image like render(), but returns as soon as the GPU has been told to
+    // copy the pixels, so that the next image can be prepared in the meantime.
+    DeferredImage renderDeferred(Map&);
+
+    class BatchItem {
+    public:
+        CameraOptions camera;
+        Size size;
+    };
+
+    // Renders an image for each item in turn and passes it to the callback with the index of
+    // its item, in order. The tiles of the next `lookahead` items are loaded and laid out while
+    // earlier items render, and each image is read back while the next one is prepared. The map
+    // and the frontend are left at the size and camera of the last item.
+    void renderBatch(Map&,
+                     const std::vector<BatchItem>&,
+                     const std::function<void (std::size_t, PremultipliedImage)>&,
+                     std::size_t lookahead = 4);
+
+    // Renders a block of span x span tiles in one pass, starting with the tile at the top left,
+    // and returns the images of the tiles row by row. Labels are placed once for the whole
+    // block, so they are consistent across the tiles. The map and the frontend are resized and
+    // the camera is moved to the block; the camera isn't constrained while the block renders.
+    // The buffer is a margin in logical pixels that is rendered around the block and then
+    // discarded, so that labels near the edges of the block aren't cut off by the viewport.
+    std::vector<PremultipliedImage> renderMetatile(Map&,
+                                                   const CanonicalTileID& topLeft,
+                                                   uint32_t span,
+                                                   uint32_t tileSize = util::tileSize,
+                                                   uint32_t buffer = 0);
+
     optional<TransformState> getTransformState() const;
 
 private:
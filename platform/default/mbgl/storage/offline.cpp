@@ -39,9 +39,11 @@ std::vector<CanonicalTileID> OfflineTilePyramidRegionDefinition::tileCover(style
 }
 
 uint64_t OfflineTilePyramidRegionDefinition::tileCount(style::SourceType type, uint16_t tileSize, const Range<uint8_t>& zoomRange) const {
-    
     const Range<uint8_t> clampedZoomRange = coveringZoomRange(type, tileSize, zoomRange);
-    unsigned long result = 0;;
+
+    // util::tileCount computes the size of each zoom level's tile range directly, so this
+    // doesn't enumerate the tile cover.
+    uint64_t result = 0;
     for (uint8_t z = clampedZoomRange.min; z <= clampedZoomRange.max; z++) {
         result +=  util::tileCount(bounds, z);
     }
@@ -5,11 +5,20 @@
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/trace.hpp>
 
 #include "sqlite3.hpp"
 
 namespace mbgl {
 
+// Responses recently read from the database are kept in memory, up to this many bytes of data.
+static const uint64_t maximumMemoryCacheSize = 4 * 1024 * 1024;
+
+// Accessed timestamps of memory cache hits are written once this many are pending, or once the
+// oldest has been pending for this long.
+static const std::size_t maximumPendingAccessed = 64;
+static const Seconds maximumPendingAccessedAge { 60 };
+
 OfflineDatabase::OfflineDatabase(std::string path_, uint64_t maximumCacheSize_)
     : path(std::move(path_)),
       maximumCacheSize(maximumCacheSize_) {
@@ -20,6 +29,9 @@ OfflineDatabase::~OfflineDatabase() {
     // Deleting these SQLite objects may result in exceptions, but we're in a destructor, so we
     // can't throw anything.
     try {
+        if (db) {
+            flushAccessed();
+        }
         statements.clear();
         db.reset();
     } catch (mapbox::sqlite::Exception& ex) {
@@ -45,7 +57,8 @@ void OfflineDatabase::ensureSchema() {
             case 3: // no-op and fall through
             case 4: migrateToVersion5(); // fall through
             case 5: migrateToVersion6(); // fall through
-            case 6: return;
+            case 6: migrateToVersion7(); // fall through
+            case 7: return;
             default: break; // downgrade, delete the database
             }
 
@@ -79,7 +92,7 @@ void OfflineDatabase::ensureSchema() {
         db->exec("PRAGMA journal_mode = DELETE");
         db->exec("PRAGMA synchronous = FULL");
         db->exec(schema);
-        db->exec("PRAGMA user_version = 6");
+        db->exec("PRAGMA user_version = 7");
     } catch (...) {
         Log::Error(Event::Database, "Unexpected error creating database schema: %s", util::toString(std::current_exception()).c_str());
         throw;
@@ -94,6 +107,9 @@ void OfflineDatabase::removeExisting() {
     Log::Warning(Event::Database, "Removing existing incompatible offline database");
 
     db.reset();
+    regionCompletedStatus.clear();
+    clearMemoryCache();
+    pendingAccessed.clear();
 
     try {
         util::deleteFile(path);
@@ -128,6 +144,30 @@ void OfflineDatabase::migrateToVersion6() {
     transaction.commit();
 }
 
+// Version 7 stores a util::Compression value in the `compressed` column instead of a boolean.
+// Existing rows keep their meaning (0 is uncompressed, 1 is zlib); the version bump keeps older
+// releases from misreading rows that use another codec.
+void OfflineDatabase::migrateToVersion7() {
+    db->exec("PRAGMA user_version = 7");
+}
+
+void OfflineDatabase::setCompression(Resource::Kind kind, util::Compression codec, int level) {
+    compression[kind] = { codec, level };
+}
+
+std::string OfflineDatabase::decompress(const std::string& data, int64_t codec) {
+    switch (util::Compression(codec)) {
+    case util::Compression::None:
+        return data;
+    case util::Compression::Zlib:
+        return util::decompress(data);
+    case util::Compression::Fast:
+        return util::decompressFast(data);
+    }
+
+    throw std::runtime_error("Unknown compression in offline database");
+}
+
 mapbox::sqlite::Statement& OfflineDatabase::getStatement(const char* sql) {
     auto it = statements.find(sql);
     if (it == statements.end()) {
@@ -137,8 +177,132 @@ mapbox::sqlite::Statement& OfflineDatabase::getStatement(const char* sql) {
 }
 
 optional<Response> OfflineDatabase::get(const Resource& resource) {
+    MBGL_TRACE_DETAIL(Event::Database, "OfflineDatabase::get", resource.url);
+
+    const std::string key = memoryCacheKey(resource);
+
+    // Anything that eviction removes from the database is dropped from the memory cache too.
+    // Hits still count as accesses for eviction, but the timestamps are written in batches.
+    auto it = memoryCache.find(key);
+    if (it != memoryCache.end()) {
+        memoryCacheKeys.splice(memoryCacheKeys.end(), memoryCacheKeys, it->second.position);
+
+        const Timestamp now = util::now();
+        if (pendingAccessed.empty()) {
+            pendingAccessedSince = now;
+        }
+        auto pending = pendingAccessed.find(key);
+        if (pending != pendingAccessed.end()) {
+            pending->second.second = now;
+        } else {
+            pendingAccessed.emplace(key, std::make_pair(resource, now));
+        }
+        if (pendingAccessed.size() >= maximumPendingAccessed ||
+            now - pendingAccessedSince >= maximumPendingAccessedAge) {
+            flushAccessed();
+        }
+
+        return it->second.response;
+    }
+
     auto result = getInternal(resource);
-    return result ? result->first : optional<Response>();
+    if (!result) {
+        return {};
+    }
+
+    putMemoryCache(key, result->first);
+    return result->first;
+}
+
+std::string OfflineDatabase::memoryCacheKey(const Resource& resource) {
+    if (resource.kind == Resource::Kind::Tile) {
+        assert(resource.tileData);
+        const Resource::TileData& tile = *resource.tileData;
+        return tile.urlTemplate + '\n' + util::toString(tile.pixelRatio) + '/' + util::toString(tile.z) + '/' +
+               util::toString(tile.x) + '/' + util::toString(tile.y);
+    } else {
+        return resource.url;
+    }
+}
+
+void OfflineDatabase::putMemoryCache(const std::string& key, const Response& response) {
+    // Responses are kept uncompressed, so that's the size that counts. Large responses would
+    // push out many small ones.
+    const uint64_t size = response.data ? response.data->size() : 0;
+    if (size > maximumMemoryCacheSize / 8) {
+        return;
+    }
+
+    eraseMemoryCache(key);
+    memoryCacheKeys.push_back(key);
+    memoryCache.emplace(key, MemoryCacheEntry { response, size, std::prev(memoryCacheKeys.end()) });
+    memoryCacheSize += size;
+
+    while (memoryCacheSize > maximumMemoryCacheSize) {
+        eraseMemoryCache(memoryCacheKeys.front());
+    }
+}
+
+void OfflineDatabase::eraseMemoryCache(const std::string& key) {
+    auto it = memoryCache.find(key);
+    if (it != memoryCache.end()) {
+        memoryCacheSize -= it->second.size;
+        memoryCacheKeys.erase(it->second.position);
+        memoryCache.erase(it);
+    }
+}
+
+void OfflineDatabase::clearMemoryCache() {
+    memoryCache.clear();
+    memoryCacheKeys.clear();
+    memoryCacheSize = 0;
+}
+
+void OfflineDatabase::flushAccessed() {
+    if (pendingAccessed.empty()) {
+        return;
+    }
+
+    // The timestamps only order eviction, so failing to write them (e.g. because the database
+    // is locked or the disk is full) mustn't fail the request that triggered the write. They
+    // are dropped rather than retried on every later request.
+    try {
+        mapbox::sqlite::Transaction transaction(*db);
+        for (const auto& pending : pendingAccessed) {
+            const Resource& resource = pending.second.first;
+            if (resource.kind == Resource::Kind::Tile) {
+                assert(resource.tileData);
+                const Resource::TileData& tile = *resource.tileData;
+                // clang-format off
+                mapbox::sqlite::Query accessedQuery{ getStatement(
+                    "UPDATE tiles "
+                    "SET accessed       = ?1 "
+                    "WHERE url_template = ?2 "
+                    "  AND pixel_ratio  = ?3 "
+                    "  AND x            = ?4 "
+                    "  AND y            = ?5 "
+                    "  AND z            = ?6 ") };
+                // clang-format on
+
+                accessedQuery.bind(1, pending.second.second);
+                accessedQuery.bind(2, tile.urlTemplate);
+                accessedQuery.bind(3, tile.pixelRatio);
+                accessedQuery.bind(4, tile.x);
+                accessedQuery.bind(5, tile.y);
+                accessedQuery.bind(6, tile.z);
+                accessedQuery.run();
+            } else {
+                mapbox::sqlite::Query accessedQuery{ getStatement("UPDATE resources SET accessed = ?1 WHERE url = ?2") };
+                accessedQuery.bind(1, pending.second.second);
+                accessedQuery.bind(2, resource.url);
+                accessedQuery.run();
+            }
+        }
+        transaction.commit();
+    } catch (mapbox::sqlite::Exception& ex) {
+        Log::Error(Event::Database, (int)ex.code, ex.what());
+    }
+    pendingAccessed.clear();
 }
 
 optional<std::pair<Response, uint64_t>> OfflineDatabase::getInternal(const Resource& resource) {
@@ -168,14 +332,32 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
         return { false, 0 };
     }
 
+    const std::string key = memoryCacheKey(resource);
+    eraseMemoryCache(key);
+    pendingAccessed.erase(key);
+
     std::string compressedData;
-    bool compressed = false;
+    util::Compression codec = util::Compression::None;
     uint64_t size = 0;
 
     if (response.data) {
-        compressedData = util::compress(*response.data);
-        compressed = compressedData.size() < response.data->size();
-        size = compressed ? compressedData.size() : response.data->size();
+        CompressionSetting setting;
+        auto it = compression.find(resource.kind);
+        if (it != compression.end()) {
+            setting = it->second;
+        }
+
+        if (setting.codec == util::Compression::Zlib) {
+            compressedData = util::compress(*response.data, setting.level);
+        } else if (setting.codec == util::Compression::Fast) {
+            compressedData = util::compressFast(*response.data);
+        }
+
+        // Only keep the compressed form if it is smaller.
+        if (setting.codec != util::Compression::None && compressedData.size() < response.data->size()) {
+            codec = setting.codec;
+        }
+        size = codec != util::Compression::None ? compressedData.size() : response.data->size();
     }
 
     if (evict_ && !evict(size)) {
@@ -188,12 +370,17 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
     if (resource.kind == Resource::Kind::Tile) {
         assert(resource.tileData);
         inserted = putTile(*resource.tileData, response,
-                compressed ? compressedData : response.data ? *response.data : "",
-                compressed);
+                codec != util::Compression::None ? compressedData : response.data ? *response.data : "",
+                codec);
     } else {
         inserted = putResource(resource, response,
-                compressed ? compressedData : response.data ? *response.data : "",
-                compressed);
+                codec != util::Compression::None ? compressedData : response.data ? *response.data : "",
+                codec);
+
+        if (!response.notModified &&
+            (resource.kind == Resource::Kind::Style || resource.kind == Resource::Kind::Source)) {
+            styleAndSourceChangeCount++;
+        }
     }
 
     return { inserted, size };
@@ -233,11 +420,8 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resou
     auto data = query.get<optional<std::string>>(4);
     if (!data) {
         response.noContent = true;
-    } else if (query.get<bool>(5)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
-        size = data->length();
     } else {
-        response.data = std::make_shared<std::string>(*data);
+        response.data = std::make_shared<std::string>(decompress(*data, query.get<int64_t>(5)));
         size = data->length();
     }
 
@@ -257,7 +441,7 @@ optional<int64_t> OfflineDatabase::hasResource(const Resource& resource) {
 bool OfflineDatabase::putResource(const Resource& resource,
                                   const Response& response,
                                   const std::string& data,
-                                  bool compressed) {
+                                  util::Compression codec) {
     if (response.notModified) {
         // clang-format off
         mapbox::sqlite::Query notModifiedQuery{ getStatement(
@@ -309,12 +493,15 @@ bool OfflineDatabase::putResource(const Resource& resource,
         updateQuery.bind(8, false);
     } else {
         updateQuery.bindBlob(7, data.data(), data.size(), false);
-        updateQuery.bind(8, compressed);
+        updateQuery.bind(8, uint8_t(codec));
     }
 
     updateQuery.run();
     if (updateQuery.changes() != 0) {
         transaction.commit();
+
+        // The stored size of a resource that belongs to a region may have changed.
+        regionCompletedStatus.clear();
         return false;
     }
 
@@ -337,7 +524,7 @@ bool OfflineDatabase::putResource(const Resource& resource,
         insertQuery.bind(9, false);
     } else {
         insertQuery.bindBlob(8, data.data(), data.size(), false);
-        insertQuery.bind(9, compressed);
+        insertQuery.bind(9, uint8_t(codec));
     }
 
     insertQuery.run();
@@ -401,11 +588,8 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
     optional<std::string> data = query.get<optional<std::string>>(4);
     if (!data) {
         response.noContent = true;
-    } else if (query.get<bool>(5)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
-        size = data->length();
     } else {
-        response.data = std::make_shared<std::string>(*data);
+        response.data = std::make_shared<std::string>(decompress(*data, query.get<int64_t>(5)));
         size = data->length();
     }
 
@@ -440,7 +624,7 @@ optional<int64_t> OfflineDatabase::hasTile(const Resource::TileData& tile) {
 bool OfflineDatabase::putTile(const Resource::TileData& tile,
                               const Response& response,
                               const std::string& data,
-                              bool compressed) {
+                              util::Compression codec) {
     if (response.notModified) {
         // clang-format off
         mapbox::sqlite::Query notModifiedQuery{ getStatement(
@@ -506,12 +690,15 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         updateQuery.bind(7, false);
     } else {
         updateQuery.bindBlob(6, data.data(), data.size(), false);
-        updateQuery.bind(7, compressed);
+        updateQuery.bind(7, uint8_t(codec));
     }
 
     updateQuery.run();
     if (updateQuery.changes() != 0) {
         transaction.commit();
+
+        // The stored size of a resource that belongs to a region may have changed.
+        regionCompletedStatus.clear();
         return false;
     }
 
@@ -537,7 +724,7 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         insertQuery.bind(12, false);
     } else {
         insertQuery.bindBlob(11, data.data(), data.size(), false);
-        insertQuery.bind(12, compressed);
+        insertQuery.bind(12, uint8_t(codec));
     }
 
     insertQuery.run();
@@ -601,13 +788,15 @@ void OfflineDatabase::deleteRegion(OfflineRegion&& region) {
 
     // Ensure that the cached offlineTileCount value is recalculated.
     offlineMapboxTileCount = {};
+    regionCompletedStatus.erase(region.getID());
+    clearMemoryCache();
 }
 
 optional<std::pair<Response, uint64_t>> OfflineDatabase::getRegionResource(int64_t regionID, const Resource& resource) {
     auto response = getInternal(resource);
 
     if (response) {
-        markUsed(regionID, resource);
+        markUsed(regionID, resource, response->second);
     }
 
     return response;
@@ -617,7 +806,7 @@ optional<int64_t> OfflineDatabase::hasRegionResource(int64_t regionID, const Res
     auto response = hasInternal(resource);
 
     if (response) {
-        markUsed(regionID, resource);
+        markUsed(regionID, resource, *response);
     }
 
     return response;
@@ -625,7 +814,7 @@ optional<int64_t> OfflineDatabase::hasRegionResource(int64_t regionID, const Res
 
 uint64_t OfflineDatabase::putRegionResource(int64_t regionID, const Resource& resource, const Response& response) {
     uint64_t size = putInternal(resource, response, false).second;
-    bool previouslyUnused = markUsed(regionID, resource);
+    bool previouslyUnused = markUsed(regionID, resource, size);
 
     if (offlineMapboxTileCount
         && resource.kind == Resource::Kind::Tile
@@ -637,7 +826,7 @@ uint64_t OfflineDatabase::putRegionResource(int64_t regionID, const Resource& re
     return size;
 }
 
-bool OfflineDatabase::markUsed(int64_t regionID, const Resource& resource) {
+bool OfflineDatabase::markUsed(int64_t regionID, const Resource& resource, uint64_t size) {
     if (resource.kind == Resource::Kind::Tile) {
         // clang-format off
         mapbox::sqlite::Query insertQuery{ getStatement(
@@ -664,6 +853,8 @@ bool OfflineDatabase::markUsed(int64_t regionID, const Resource& resource) {
             return false;
         }
 
+        updateRegionCompletedStatus(regionID, resource, size);
+
         // clang-format off
         mapbox::sqlite::Query selectQuery{ getStatement(
             "SELECT region_id "
@@ -701,6 +892,8 @@ bool OfflineDatabase::markUsed(int64_t regionID, const Resource& resource) {
             return false;
         }
 
+        updateRegionCompletedStatus(regionID, resource, size);
+
         // clang-format off
         mapbox::sqlite::Query selectQuery{ getStatement(
             "SELECT region_id "
@@ -724,7 +917,27 @@ OfflineRegionDefinition OfflineDatabase::getRegionDefinition(int64_t regionID) {
     return decodeOfflineRegionDefinition(query.get<std::string>(0));
 }
 
+void OfflineDatabase::updateRegionCompletedStatus(int64_t regionID, const Resource& resource, uint64_t size) {
+    auto it = regionCompletedStatus.find(regionID);
+    if (it == regionCompletedStatus.end()) {
+        return;
+    }
+
+    OfflineRegionStatus& status = it->second;
+    status.completedResourceCount++;
+    status.completedResourceSize += size;
+    if (resource.kind == Resource::Kind::Tile) {
+        status.completedTileCount++;
+        status.completedTileSize += size;
+    }
+}
+
 OfflineRegionStatus OfflineDatabase::getRegionCompletedStatus(int64_t regionID) {
+    auto it = regionCompletedStatus.find(regionID);
+    if (it != regionCompletedStatus.end()) {
+        return it->second;
+    }
+
     OfflineRegionStatus result;
 
     std::tie(result.completedResourceCount, result.completedResourceSize)
@@ -735,6 +948,7 @@ OfflineRegionStatus OfflineDatabase::getRegionCompletedStatus(int64_t regionID)
     result.completedResourceCount += result.completedTileCount;
     result.completedResourceSize += result.completedTileSize;
 
+    regionCompletedStatus.emplace(regionID, result);
     return result;
 }
 
@@ -782,6 +996,9 @@ T OfflineDatabase::getPragma(const char* sql) {
 // delete an arbitrary number of old cache entries. The free pages approach saves
 // us from calling VACCUM or keeping a running total, which can be costly.
 bool OfflineDatabase::evict(uint64_t neededFreeSize) {
+    // Eviction goes by the accessed timestamps, so they need to be current.
+    flushAccessed();
+
     uint64_t pageSize = getPragma<int64_t>("PRAGMA page_size");
     uint64_t pageCount = getPragma<int64_t>("PRAGMA page_count");
 
@@ -853,6 +1070,8 @@ bool OfflineDatabase::evict(uint64_t neededFreeSize) {
         if (resourceChanges == 0 && tileChanges == 0) {
             return false;
         }
+
+        clearMemoryCache();
     }
 
     return true;
@@ -6,8 +6,12 @@
 #include <mbgl/util/optional.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/mapbox.hpp>
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/chrono.hpp>
 
+#include <map>
 #include <unordered_map>
+#include <list>
 #include <memory>
 #include <string>
 
@@ -53,11 +57,23 @@ public:
     OfflineRegionDefinition getRegionDefinition(int64_t regionID);
     OfflineRegionStatus getRegionCompletedStatus(int64_t regionID);
 
+    // Counts the times that the data of a style or source resource was stored. Values derived
+    // from these resources, like the required resource count of a region, are stale once it
+    // changes.
+    uint64_t getStyleAndSourceChangeCount() const {
+        return styleAndSourceChangeCount;
+    }
+
     void setOfflineMapboxTileCountLimit(uint64_t);
     uint64_t getOfflineMapboxTileCountLimit();
     bool offlineMapboxTileCountLimitExceeded();
     uint64_t getOfflineMapboxTileCount();
 
+    // Selects how newly stored data of a resource kind is compressed. The level applies to
+    // zlib only. Each row records its codec, so existing rows remain readable. The default
+    // is zlib at its default level.
+    void setCompression(Resource::Kind, util::Compression, int level = -1);
+
 private:
     void connect(int flags);
     int userVersion();
@@ -66,25 +82,36 @@ private:
     void migrateToVersion3();
     void migrateToVersion5();
     void migrateToVersion6();
+    void migrateToVersion7();
+
+    static std::string decompress(const std::string& data, int64_t codec);
 
     mapbox::sqlite::Statement& getStatement(const char *);
 
     optional<std::pair<Response, uint64_t>> getTile(const Resource::TileData&);
     optional<int64_t> hasTile(const Resource::TileData&);
     bool putTile(const Resource::TileData&, const Response&,
-                 const std::string&, bool compressed);
+                 const std::string&, util::Compression);
 
     optional<std::pair<Response, uint64_t>> getResource(const Resource&);
     optional<int64_t> hasResource(const Resource&);
     bool putResource(const Resource&, const Response&,
-                     const std::string&, bool compressed);
+                     const std::string&, util::Compression);
 
     optional<std::pair<Response, uint64_t>> getInternal(const Resource&);
     optional<int64_t> hasInternal(const Resource&);
     std::pair<bool, uint64_t> putInternal(const Resource&, const Response&, bool evict);
 
+    static std::string memoryCacheKey(const Resource&);
+    void putMemoryCache(const std::string& key, const Response&);
+    void eraseMemoryCache(const std::string& key);
+    void clearMemoryCache();
+    void flushAccessed();
+
     // Return value is true iff the resource was previously unused by any other regions.
-    bool markUsed(int64_t regionID, const Resource&);
+    // `size` is the stored size of the resource, used to keep cached region status current.
+    bool markUsed(int64_t regionID, const Resource&, uint64_t size);
+    void updateRegionCompletedStatus(int64_t regionID, const Resource&, uint64_t size);
 
     std::pair<int64_t, int64_t> getCompletedResourceCountAndSize(int64_t regionID);
     std::pair<int64_t, int64_t> getCompletedTileCountAndSize(int64_t regionID);
@@ -98,9 +125,35 @@ private:
 
     uint64_t maximumCacheSize;
 
+    struct CompressionSetting {
+        util::Compression codec = util::Compression::Zlib;
+        int level = -1;
+    };
+    std::map<Resource::Kind, CompressionSetting> compression;
+
     uint64_t offlineMapboxTileCountLimit = util::mapbox::DEFAULT_OFFLINE_TILE_COUNT_LIMIT;
     optional<uint64_t> offlineMapboxTileCount;
 
+    uint64_t styleAndSourceChangeCount = 0;
+
+    // Completed counts and sizes per region, computed once and then updated as resources
+    // are linked to the region.
+    std::unordered_map<int64_t, OfflineRegionStatus> regionCompletedStatus;
+
+    // Small LRU cache of responses returned by get(), in front of SQLite.
+    struct MemoryCacheEntry {
+        Response response;
+        uint64_t size;
+        std::list<std::string>::iterator position;
+    };
+    std::unordered_map<std::string, MemoryCacheEntry> memoryCache;
+    std::list<std::string> memoryCacheKeys;
+    uint64_t memoryCacheSize = 0;
+
+    // Accessed timestamps of memory cache hits, which are written to the database in batches.
+    std::unordered_map<std::string, std::pair<Resource, Timestamp>> pendingAccessed;
+    Timestamp pendingAccessedSince;
+
     bool evict(uint64_t neededFreeSize);
 };
 
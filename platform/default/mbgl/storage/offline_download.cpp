@@ -64,10 +64,32 @@ OfflineRegionStatus OfflineDownload::getStatus() const {
 
     OfflineRegionStatus result = offlineDatabase.getRegionCompletedStatus(id);
 
+    // Counting the required resources means parsing the style and every source's TileJSON, so
+    // keep the count once it is precise, until the ambient cache or a download stores a new
+    // version of a style or a TileJSON.
+    const uint64_t styleAndSourceChangeCount = offlineDatabase.getStyleAndSourceChangeCount();
+    if (!requiredResourceCount || requiredResourceCountChangeCount != styleAndSourceChangeCount) {
+        requiredResourceCount = computeRequiredResourceCount();
+        requiredResourceCountChangeCount = styleAndSourceChangeCount;
+    }
+
+    result.requiredResourceCount = requiredResourceCount->first;
+    result.requiredResourceCountIsPrecise = requiredResourceCount->second;
+
+    if (!result.requiredResourceCountIsPrecise) {
+        requiredResourceCount = {};
+    }
+
+    return result;
+}
+
+std::pair<uint64_t, bool> OfflineDownload::computeRequiredResourceCount() const {
+    OfflineRegionStatus result;
+
     result.requiredResourceCount++;
     optional<Response> styleResponse = offlineDatabase.get(Resource::style(definition.styleURL));
     if (!styleResponse) {
-        return result;
+        return { result.requiredResourceCount, result.requiredResourceCountIsPrecise };
     }
 
     style::Parser parser;
@@ -149,10 +171,11 @@ OfflineRegionStatus OfflineDownload::getStatus() const {
         result.requiredResourceCount += 2;
     }
 
-    return result;
+    return { result.requiredResourceCount, result.requiredResourceCountIsPrecise };
 }
 
 void OfflineDownload::activateDownload() {
+    requiredResourceCount = {};
     status = OfflineRegionStatus();
     status.downloadState = OfflineRegionDownloadState::Active;
     status.requiredResourceCount++;
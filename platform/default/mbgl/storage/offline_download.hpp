@@ -36,6 +36,9 @@ public:
     OfflineRegionStatus getStatus() const;
 
 private:
+    // Return value is (required resource count, count is precise)
+    std::pair<uint64_t, bool> computeRequiredResourceCount() const;
+
     void activateDownload();
     void continueDownload();
     void deactivateDownload();
@@ -53,6 +56,8 @@ private:
     OfflineDatabase& offlineDatabase;
     FileSource& onlineFileSource;
     OfflineRegionStatus status;
+    mutable optional<std::pair<uint64_t, bool>> requiredResourceCount;
+    mutable uint64_t requiredResourceCountChangeCount = 0;
     std::unique_ptr<OfflineRegionObserver> observer;
 
     std::list<std::unique_ptr<AsyncRequest>> requests;
@@ -16,6 +16,7 @@
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/timer.hpp>
 #include <mbgl/util/http_timeout.hpp>
+#include <mbgl/util/trace.hpp>
 
 #include <algorithm>
 #include <cassert>
@@ -117,7 +118,13 @@ public:
     }
 
     void activateRequest(OnlineFileRequest* request) {
+        const optional<TimePoint> traceBegin = Trace::isRecording() ? optional<TimePoint>(Clock::now()) : nullopt;
+
         auto callback = [=](Response response) {
+            if (traceBegin && Trace::isRecording()) {
+                Trace::recordAsync(Event::HttpRequest, "HTTP request", *traceBegin, Clock::now(), request->resource.url);
+            }
+
             activeRequests.erase(request);
             request->request.reset();
             request->completed(response);
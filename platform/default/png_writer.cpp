@@ -1,20 +1,51 @@
-#include <mbgl/util/compression.hpp>
 #include <mbgl/util/image.hpp>
-#include <mbgl/util/premultiply.hpp>
+#include <mbgl/util/parallel_for.hpp>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wshadow"
 #include <boost/crc.hpp>
 #pragma GCC diagnostic pop
 
+#if defined(__QT__) && defined(_WINDOWS) && !defined(__GNUC__)
+#include <QtZlib/zlib.h>
+#else
+#include <zlib.h>
+#endif
+
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <cstdlib>
 #include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #define NETWORK_BYTE_UINT32(value)                                                                 \
     char(value >> 24), char(value >> 16), char(value >> 8), char(value >> 0)
 
 namespace {
 
+using namespace mbgl;
+
+// Rows are compressed in chunks of about this many bytes, which are independent apart from the
+// dictionary that each chunk is primed with.
+constexpr std::size_t chunkBytes = 128 * 1024;
+
+// The size of the deflate window.
+constexpr std::size_t windowBytes = 32 * 1024;
+
+enum class Filter : uint8_t {
+    None = 0,
+    Sub = 1,
+    Up = 2,
+    Average = 3,
+    Paeth = 4,
+};
+
 void addChunk(std::string& png, const char* type, const char* data = "", const uint32_t size = 0) {
     assert(strlen(type) == 4);
 
@@ -33,45 +64,478 @@ void addChunk(std::string& png, const char* type, const char* data = "", const u
     png.append(crc, 4);
 }
 
+void forEach(Scheduler* scheduler, std::size_t count, const std::function<void(std::size_t)>& fn) {
+    if (scheduler) {
+        util::parallelFor(*scheduler, count, fn);
+    } else {
+        for (std::size_t i = 0; i < count; i++) {
+            fn(i);
+        }
+    }
+}
+
+// Returns row y of the PNG, which is row y of the image counted from the top or, when the image
+// is stored bottom to top, from the bottom.
+const uint8_t* imageRow(const PremultipliedImage& image, bool flipY, uint32_t y) {
+    return image.data.get() + std::size_t(flipY ? image.size.height - 1 - y : y) * image.stride();
+}
+
+void unpremultiplyRow(const uint8_t* src, uint8_t* dst, uint32_t width) {
+    for (uint32_t x = 0; x < width * 4; x += 4) {
+        const uint8_t a = src[x + 3];
+        if (a) {
+            dst[x + 0] = (255 * src[x + 0] + (a / 2)) / a;
+            dst[x + 1] = (255 * src[x + 1] + (a / 2)) / a;
+            dst[x + 2] = (255 * src[x + 2] + (a / 2)) / a;
+        } else {
+            dst[x + 0] = dst[x + 1] = dst[x + 2] = 0;
+        }
+        dst[x + 3] = a;
+    }
+}
+
+uint8_t paeth(int a, int b, int c) {
+    const int p = a + b - c;
+    const int pa = std::abs(p - a);
+    const int pb = std::abs(p - b);
+    const int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return a;
+    } else if (pb <= pc) {
+        return b;
+    } else {
+        return c;
+    }
+}
+
+template <Filter filter>
+uint8_t predict(uint8_t left, uint8_t up, uint8_t upperLeft);
+
+template <>
+uint8_t predict<Filter::Sub>(uint8_t left, uint8_t, uint8_t) {
+    return left;
+}
+
+template <>
+uint8_t predict<Filter::Up>(uint8_t, uint8_t up, uint8_t) {
+    return up;
+}
+
+template <>
+uint8_t predict<Filter::Average>(uint8_t left, uint8_t up, uint8_t) {
+    return (left + up) / 2;
+}
+
+template <>
+uint8_t predict<Filter::Paeth>(uint8_t left, uint8_t up, uint8_t upperLeft) {
+    return paeth(left, up, upperLeft);
+}
+
+// Estimates the number of bits that an entropy coder would need for the bytes, which predicts
+// the filter that compresses best more reliably than the sum of absolute differences that the
+// PNG specification suggests. The estimate is n log n - sum(c log c) over the byte counts c; the
+// table holds c log c for all counts up to the row length.
+float entropy(const uint8_t* data, std::size_t length, const std::vector<float>& table) {
+    std::array<uint32_t, 256> histogram {};
+    for (std::size_t i = 0; i < length; i++) {
+        histogram[data[i]]++;
+    }
+
+    float bits = table[length];
+    for (const uint32_t count : histogram) {
+        bits -= table[count];
+    }
+    return bits;
+}
+
+// Filters a row of RGBA pixels against the row above it.
+template <Filter filter>
+void filterRow(const uint8_t* row, const uint8_t* prior, std::size_t length, uint8_t* out) {
+    constexpr std::size_t bpp = 4;
+    for (std::size_t i = 0; i < bpp; i++) {
+        out[i] = row[i] - predict<filter>(0, prior[i], 0);
+    }
+    for (std::size_t i = bpp; i < length; i++) {
+        out[i] = row[i] - predict<filter>(row[i - bpp], prior[i], prior[i - bpp]);
+    }
+}
+
+// Gives each of the rows the filter that leaves it with the least entropy. The rows are
+// unfiltered, with a filter type byte in front of each, and prior is the row above the first one.
+void filterAdaptive(const uint8_t* rows, std::size_t stride, std::size_t count, const uint8_t* prior,
+                    uint8_t* out, const std::vector<float>& table) {
+    std::vector<uint8_t> candidate(stride);
+    for (std::size_t y = 0; y < count; y++) {
+        const uint8_t* row = rows + y * (stride + 1) + 1;
+        uint8_t* filtered = out + y * (stride + 1);
+
+        Filter best = Filter::None;
+        float bestBits = entropy(row, stride, table);
+        std::copy(row, row + stride, filtered + 1);
+        const auto tryFilter = [&](Filter filter, void (*apply)(const uint8_t*, const uint8_t*, std::size_t, uint8_t*)) {
+            apply(row, prior, stride, candidate.data());
+            const float bits = entropy(candidate.data(), stride, table);
+            if (bits < bestBits) {
+                best = filter;
+                bestBits = bits;
+                std::copy(candidate.begin(), candidate.end(), filtered + 1);
+            }
+        };
+        tryFilter(Filter::Sub, filterRow<Filter::Sub>);
+        tryFilter(Filter::Up, filterRow<Filter::Up>);
+        tryFilter(Filter::Average, filterRow<Filter::Average>);
+        tryFilter(Filter::Paeth, filterRow<Filter::Paeth>);
+        filtered[0] = static_cast<uint8_t>(best);
+
+        prior = row;
+    }
+}
+
+std::size_t compressedSize(const uint8_t* data, std::size_t length) {
+    uLongf size = compressBound(uLong(length));
+    std::vector<Bytef> out(size);
+    compress2(out.data(), &size, data, uLong(length), 1);
+    return size;
+}
+
+// Writes the filter type and the filtered bytes of rows [begin, end) of the image. Adaptive
+// filtering works well for photographic content, but flat-colored content like rendered vector
+// maps compresses better unfiltered, because the matches between rows are lost when the filter
+// changes from row to row. So a sample of the rows is compressed both ways at the fastest level
+// first, and the rows are only filtered when that pays off.
+void filterRows(const PremultipliedImage& image, bool flipY, uint32_t begin, uint32_t end, uint8_t* out) {
+    const std::size_t stride = image.stride();
+    const std::size_t rowBytes = stride + 1;
+    const std::size_t count = end - begin;
+
+    for (std::size_t y = 0; y < count; y++) {
+        out[y * rowBytes] = static_cast<uint8_t>(Filter::None);
+        unpremultiplyRow(imageRow(image, flipY, begin + y), out + y * rowBytes + 1, image.size.width);
+    }
+
+    std::vector<uint8_t> prior(stride, 0);
+    if (begin > 0) {
+        unpremultiplyRow(imageRow(image, flipY, begin - 1), prior.data(), image.size.width);
+    }
+
+    std::vector<float> table(stride + 1, 0.0f);
+    for (std::size_t i = 2; i <= stride; i++) {
+        table[i] = i * std::log2(float(i));
+    }
+
+    const std::size_t sampleCount = std::min(count, std::max<std::size_t>(1, windowBytes / rowBytes));
+    const std::size_t sampleBegin = (count - sampleCount) / 2;
+    const uint8_t* sample = out + sampleBegin * rowBytes;
+    std::vector<uint8_t> filtered(sampleCount * rowBytes);
+    filterAdaptive(sample, stride, sampleCount, sampleBegin > 0 ? sample - stride : prior.data(),
+                   filtered.data(), table);
+    if (compressedSize(filtered.data(), filtered.size()) >= compressedSize(sample, filtered.size())) {
+        return;
+    }
+
+    filtered.resize(count * rowBytes);
+    filterAdaptive(out, stride, count, prior.data(), filtered.data(), table);
+    std::copy(filtered.begin(), filtered.end(), out);
+}
+
+class Palette {
+public:
+    std::vector<std::array<uint8_t, 4>> colors;
+    std::vector<uint8_t> indices;
+};
+
+// Maps the pixels to at most 256 colors. Images with more colors are quantized with a median
+// cut of the color histogram, which splits the box with the largest extent in any channel at
+// the pixel-weighted median until there are enough boxes.
+Palette quantize(const PremultipliedImage& image, bool flipY) {
+    const std::size_t pixels = image.size.area();
+
+    std::vector<uint32_t> keys(pixels);
+    std::unordered_map<uint32_t, uint32_t> histogram;
+    for (uint32_t y = 0; y < image.size.height; y++) {
+        const uint8_t* row = imageRow(image, flipY, y);
+        uint8_t rgba[4];
+        for (uint32_t x = 0; x < image.size.width; x++) {
+            const std::size_t i = std::size_t(y) * image.size.width + x;
+            unpremultiplyRow(row + x * 4, rgba, 1);
+            keys[i] = uint32_t(rgba[0]) << 24 | uint32_t(rgba[1]) << 16 | uint32_t(rgba[2]) << 8 | rgba[3];
+            histogram[keys[i]]++;
+        }
+    }
+
+    struct Entry {
+        std::array<uint8_t, 4> color;
+        uint32_t count;
+    };
+    std::vector<Entry> entries;
+    entries.reserve(histogram.size());
+    for (const auto& bin : histogram) {
+        entries.push_back({ {{ uint8_t(bin.first >> 24), uint8_t(bin.first >> 16),
+                               uint8_t(bin.first >> 8), uint8_t(bin.first) }}, bin.second });
+    }
+
+    struct Box {
+        std::size_t begin;
+        std::size_t end;
+        std::size_t channel;
+        int extent;
+    };
+    const auto makeBox = [&](std::size_t begin, std::size_t end) {
+        std::array<uint8_t, 4> min {{ 255, 255, 255, 255 }};
+        std::array<uint8_t, 4> max {{ 0, 0, 0, 0 }};
+        for (std::size_t i = begin; i < end; i++) {
+            for (std::size_t c = 0; c < 4; c++) {
+                min[c] = std::min(min[c], entries[i].color[c]);
+                max[c] = std::max(max[c], entries[i].color[c]);
+            }
+        }
+        Box box { begin, end, 0, -1 };
+        for (std::size_t c = 0; c < 4; c++) {
+            if (max[c] - min[c] > box.extent) {
+                box.channel = c;
+                box.extent = max[c] - min[c];
+            }
+        }
+        return box;
+    };
+
+    std::vector<Box> boxes;
+    if (entries.empty()) {
+        return { { {{ 0, 0, 0, 0 }} }, {} };
+    } else if (entries.size() > 256) {
+        boxes.push_back(makeBox(0, entries.size()));
+        while (boxes.size() < 256) {
+            auto widest = std::max_element(boxes.begin(), boxes.end(), [](const Box& a, const Box& b) {
+                return a.extent < b.extent;
+            });
+            if (widest->extent <= 0) {
+                break;
+            }
+
+            const Box box = *widest;
+            std::sort(entries.begin() + box.begin, entries.begin() + box.end, [&](const Entry& a, const Entry& b) {
+                return a.color[box.channel] < b.color[box.channel];
+            });
+
+            uint64_t total = 0;
+            for (std::size_t i = box.begin; i < box.end; i++) {
+                total += entries[i].count;
+            }
+            std::size_t split = box.begin + 1;
+            for (uint64_t below = entries[box.begin].count; split < box.end - 1 && below * 2 < total; split++) {
+                below += entries[split].count;
+            }
+
+            *widest = makeBox(box.begin, split);
+            boxes.push_back(makeBox(split, box.end));
+        }
+    } else {
+        for (std::size_t i = 0; i < entries.size(); i++) {
+            boxes.push_back({ i, i + 1, 0, 0 });
+        }
+    }
+
+    // Colors that aren't opaque come first, so that the tRNS chunk only needs to list those.
+    Palette palette;
+    std::vector<std::array<uint8_t, 4>> translucent;
+    std::vector<std::array<uint8_t, 4>> opaque;
+    std::vector<std::pair<bool, std::size_t>> boxColors;
+    for (const auto& box : boxes) {
+        std::array<uint64_t, 4> sum {{ 0, 0, 0, 0 }};
+        uint64_t count = 0;
+        for (std::size_t i = box.begin; i < box.end; i++) {
+            for (std::size_t c = 0; c < 4; c++) {
+                sum[c] += uint64_t(entries[i].color[c]) * entries[i].count;
+            }
+            count += entries[i].count;
+        }
+        std::array<uint8_t, 4> color;
+        for (std::size_t c = 0; c < 4; c++) {
+            color[c] = uint8_t((sum[c] + count / 2) / count);
+        }
+        auto& group = color[3] < 255 ? translucent : opaque;
+        boxColors.emplace_back(color[3] < 255, group.size());
+        group.push_back(color);
+    }
+    palette.colors = std::move(translucent);
+    const std::size_t opaqueStart = palette.colors.size();
+    palette.colors.insert(palette.colors.end(), opaque.begin(), opaque.end());
+
+    for (std::size_t b = 0; b < boxes.size(); b++) {
+        const auto index = uint8_t(boxColors[b].first ? boxColors[b].second : opaqueStart + boxColors[b].second);
+        for (std::size_t i = boxes[b].begin; i < boxes[b].end; i++) {
+            const auto& color = entries[i].color;
+            histogram[uint32_t(color[0]) << 24 | uint32_t(color[1]) << 16 | uint32_t(color[2]) << 8 | color[3]] = index;
+        }
+    }
+
+    palette.indices.resize(pixels);
+    for (std::size_t i = 0; i < pixels; i++) {
+        palette.indices[i] = uint8_t(histogram[keys[i]]);
+    }
+
+    return palette;
+}
+
+// Compresses the filtered rows into a zlib stream. The rows are split into chunks that are
+// compressed as independent raw deflate streams, each primed with the end of the chunk
+// before it, and joined with sync flushes, which makes the output a single valid stream.
+std::string compressRows(const std::string& rows, std::size_t rowBytes, int level, Scheduler* scheduler) {
+    if (level < -1 || level > 9) {
+        throw std::runtime_error("invalid PNG compression level " + std::to_string(level));
+    }
+
+    const std::size_t rowsPerChunk = std::max<std::size_t>(1, chunkBytes / rowBytes);
+    const std::size_t rowCount = rows.size() / rowBytes;
+    const std::size_t chunkCount = std::max<std::size_t>(1, (rowCount + rowsPerChunk - 1) / rowsPerChunk);
+
+    std::vector<std::string> chunks(chunkCount);
+    std::vector<uLong> checksums(chunkCount);
+    // Chunks may be compressed on other threads, so failures are reported once they're all done.
+    std::vector<const char*> errors(chunkCount, nullptr);
+    forEach(scheduler, chunkCount, [&](std::size_t i) {
+        const std::size_t begin = std::min(rows.size(), i * rowsPerChunk * rowBytes);
+        const std::size_t end = std::min(rows.size(), (i + 1) * rowsPerChunk * rowBytes);
+        const auto* input = reinterpret_cast<const Bytef*>(rows.data());
+
+        z_stream stream;
+        memset(&stream, 0, sizeof(stream));
+        if (deflateInit2(&stream, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            errors[i] = "failed to initialize deflate";
+            return;
+        }
+        if (begin > 0) {
+            const std::size_t dictionary = std::min(begin, windowBytes);
+            deflateSetDictionary(&stream, input + begin - dictionary, uInt(dictionary));
+        }
+
+        stream.next_in = const_cast<Bytef*>(input + begin);
+        stream.avail_in = uInt(end - begin);
+
+        std::string& out = chunks[i];
+        out.resize(deflateBound(&stream, end - begin) + 16);
+        stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+        stream.avail_out = uInt(out.size());
+        const int flush = i + 1 == chunkCount ? Z_FINISH : Z_SYNC_FLUSH;
+        const int code = deflate(&stream, flush);
+        out.resize(stream.total_out);
+        deflateEnd(&stream);
+        if (code != (flush == Z_FINISH ? Z_STREAM_END : Z_OK) || stream.avail_out == 0) {
+            errors[i] = "failed to deflate image data";
+            return;
+        }
+
+        checksums[i] = adler32(adler32(0, nullptr, 0), input + begin, uInt(end - begin));
+    });
+
+    for (const char* error : errors) {
+        if (error) {
+            throw std::runtime_error(error);
+        }
+    }
+
+    // The zlib header announces the compression level, and must be a multiple of 31.
+    const int flags = level == 0 || level == 1 ? 0 : level >= 2 && level <= 5 ? 1 : level == 6 || level < 0 ? 2 : 3;
+    const uint8_t cmf = 0x78;
+    uint8_t flg = uint8_t(flags << 6);
+    flg += (31 - (cmf * 256 + flg) % 31) % 31;
+
+    uLong checksum = checksums[0];
+    for (std::size_t i = 1; i < chunkCount; i++) {
+        const std::size_t length = std::min(rowsPerChunk * rowBytes, rows.size() - i * rowsPerChunk * rowBytes);
+        checksum = adler32_combine(checksum, checksums[i], z_off_t(length));
+    }
+
+    std::string result;
+    std::size_t size = 2 + 4;
+    for (const auto& chunk : chunks) {
+        size += chunk.size();
+    }
+    result.reserve(size);
+    result.push_back(char(cmf));
+    result.push_back(char(flg));
+    for (const auto& chunk : chunks) {
+        result.append(chunk);
+    }
+    const char trailer[4] = { NETWORK_BYTE_UINT32(checksum) };
+    result.append(trailer, 4);
+    return result;
+}
+
 } // namespace
 
 namespace mbgl {
 
-// Encode PNGs without libpng.
 std::string encodePNG(const PremultipliedImage& pre) {
-    // Make copy of the image so that we can unpremultiply it.
-    const auto src = util::unpremultiply(pre.clone());
+    return encodePNG(pre, {});
+}
 
+// Encode PNGs without libpng.
+std::string encodePNG(const PremultipliedImage& pre, const PNGEncodeOptions& options) {
     // PNG magic bytes
     const char preamble[8] = { char(0x89), 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
 
-    // IHDR chunk for our RGBA image.
+    // IHDR chunk for our RGBA or palette image.
     const char ihdr[13] = {
-        NETWORK_BYTE_UINT32(src.size.width),  // width
-        NETWORK_BYTE_UINT32(src.size.height), // height
+        NETWORK_BYTE_UINT32(pre.size.width),  // width
+        NETWORK_BYTE_UINT32(pre.size.height), // height
         8,                                    // bit depth == 8 bits
-        6,                                    // color type == RGBA
+        char(options.palette ? 3 : 6),        // color type == palette or RGBA
         0,                                    // compression method == deflate
         0,                                    // filter method == default
         0,                                    // interlace method == none
     };
 
-    // Prepare the (compressed) data chunk.
-    const auto stride = src.stride();
-    std::string idat;
-    for (uint32_t y = 0; y < src.size.height; y++) {
-        // Every scanline needs to be prefixed with one byte that indicates the filter type.
-        idat.append(1, 0); // filter type 0
-        idat.append((const char*)(src.data.get() + y * stride), stride);
+    // Every scanline is prefixed with one byte that indicates the filter type. Filtering rarely
+    // pays off for palette images, so those are written unfiltered.
+    std::string plte;
+    std::string trns;
+    std::string rows;
+    std::size_t rowBytes;
+    if (options.palette) {
+        const Palette palette = quantize(pre, options.flipY);
+        for (const auto& color : palette.colors) {
+            plte.append(reinterpret_cast<const char*>(color.data()), 3);
+            if (color[3] < 255) {
+                trns.push_back(char(color[3]));
+            }
+        }
+
+        rowBytes = pre.size.width + 1;
+        rows.resize(rowBytes * pre.size.height);
+        for (uint32_t y = 0; y < pre.size.height; y++) {
+            rows[y * rowBytes] = char(Filter::None);
+            std::copy(palette.indices.begin() + std::size_t(y) * pre.size.width,
+                      palette.indices.begin() + std::size_t(y + 1) * pre.size.width,
+                      rows.begin() + y * rowBytes + 1);
+        }
+    } else {
+        rowBytes = pre.stride() + 1;
+        rows.resize(rowBytes * pre.size.height);
+        const uint32_t rowsPerChunk = std::max<uint32_t>(1, chunkBytes / rowBytes);
+        const std::size_t chunkCount = (pre.size.height + rowsPerChunk - 1) / rowsPerChunk;
+        auto* out = reinterpret_cast<uint8_t*>(&rows[0]);
+        forEach(options.scheduler, chunkCount, [&](std::size_t i) {
+            const uint32_t begin = uint32_t(i) * rowsPerChunk;
+            const uint32_t end = std::min(pre.size.height, begin + rowsPerChunk);
+            filterRows(pre, options.flipY, begin, end, out + begin * rowBytes);
+        });
     }
-    idat = util::compress(idat);
+
+    const std::string idat = compressRows(rows, rowBytes, options.compressionLevel, options.scheduler);
 
     // Assemble the PNG.
     std::string png;
-    png.reserve((8 /* preamble */) + (12 + 13 /* IHDR */) +
-                (12 + idat.size() /* IDAT */) + (12 /* IEND */));
+    png.reserve((8 /* preamble */) + (12 + 13 /* IHDR */) + (12 + plte.size() /* PLTE */) +
+                (12 + trns.size() /* tRNS */) + (12 + idat.size() /* IDAT */) + (12 /* IEND */));
     png.append(preamble, 8);
     addChunk(png, "IHDR", ihdr, 13);
+    if (!plte.empty()) {
+        addChunk(png, "PLTE", plte.data(), static_cast<uint32_t>(plte.size()));
+    }
+    if (!trns.empty()) {
+        addChunk(png, "tRNS", trns.data(), static_cast<uint32_t>(trns.size()));
+    }
     addChunk(png, "IDAT", idat.data(), static_cast<uint32_t>(idat.size()));
     addChunk(png, "IEND");
     return png;
@@ -1,37 +1,49 @@
 #include "node_thread_pool.hpp"
-#include "util/async_queue.hpp"
 
-#include <mbgl/actor/mailbox.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
 
 namespace node_mbgl {
 
-NodeThreadPool::NodeThreadPool()
-    : queue(new util::AsyncQueue<std::weak_ptr<mbgl::Mailbox>>(uv_default_loop(), [](std::weak_ptr<mbgl::Mailbox> mailbox) {
-        Worker* worker = new Worker(mailbox);
-        Nan::AsyncQueueWorker(worker);
-    })) {
-    // Don't keep the event loop alive.
-    queue->unref();
+namespace {
+
+// Honors UV_THREADPOOL_SIZE, which Node users already set to tune work done off the main
+// thread, with the same default and limit as libuv.
+std::size_t poolSize() {
+    if (const char* size = std::getenv("UV_THREADPOOL_SIZE")) {
+        const long count = std::strtol(size, nullptr, 10);
+        if (count > 0) {
+            return std::min(count, 128l);
+        }
+    }
+    return 4;
 }
 
-NodeThreadPool::~NodeThreadPool() {
-    queue->stop();
-}
+std::shared_ptr<mbgl::ThreadPool> sharedPool() {
+    static std::mutex mutex;
+    static std::weak_ptr<mbgl::ThreadPool> weak;
 
-void NodeThreadPool::schedule(std::weak_ptr<mbgl::Mailbox> mailbox) {
-    queue->send(std::move(mailbox));
+    std::lock_guard<std::mutex> lock(mutex);
+    auto pool = weak.lock();
+    if (!pool) {
+        weak = pool = std::make_shared<mbgl::ThreadPool>(poolSize());
+    }
+    return pool;
 }
 
-NodeThreadPool::Worker::Worker(std::weak_ptr<mbgl::Mailbox> mailbox_)
-    : AsyncWorker(nullptr),
-    mailbox(std::move(mailbox_)) {};
+} // namespace
 
-void NodeThreadPool::Worker::Execute() {
-    mbgl::Mailbox::maybeReceive(mailbox);
+NodeThreadPool::NodeThreadPool()
+    : pool(sharedPool()) {
 }
 
-void NodeThreadPool::Worker::WorkComplete() {
-    // no-op to avoid calling nullptr callback
+NodeThreadPool::~NodeThreadPool() = default;
+
+void NodeThreadPool::schedule(std::weak_ptr<mbgl::Mailbox> mailbox) {
+    pool->schedule(std::move(mailbox));
 }
 
 } // namespace node_mbgl
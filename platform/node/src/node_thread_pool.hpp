@@ -2,16 +2,17 @@
 
 #include <mbgl/actor/scheduler.hpp>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-#pragma GCC diagnostic ignored "-Wshadow"
-#include <nan.h>
-#pragma GCC diagnostic pop
+#include <memory>
 
-namespace node_mbgl {
+namespace mbgl {
+class ThreadPool;
+} // namespace mbgl
 
-namespace util { template <typename T> class AsyncQueue; }
+namespace node_mbgl {
 
+// Runs the work of all maps on a native pool shared between them, sized like the libuv
+// threadpool. Messages go straight to the workers without a trip through the JavaScript thread,
+// and the pool holds no libuv handles, so it doesn't keep the event loop alive.
 class NodeThreadPool : public mbgl::Scheduler {
 public:
     NodeThreadPool();
@@ -20,18 +21,7 @@ public:
     void schedule(std::weak_ptr<mbgl::Mailbox>) override;
 
 private:
-    util::AsyncQueue<std::weak_ptr<mbgl::Mailbox>>* queue;
-
-    class Worker : public Nan::AsyncWorker {
-    public:
-        Worker(std::weak_ptr<mbgl::Mailbox>);
-
-        void Execute();
-        void WorkComplete();
-
-    private:
-        std::weak_ptr<mbgl::Mailbox> mailbox;
-    };
+    std::shared_ptr<mbgl::ThreadPool> pool;
 };
 
 } // namespace node_mbgl
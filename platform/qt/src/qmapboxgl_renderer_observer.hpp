@@ -37,6 +37,10 @@ public:
         delegate.invoke(&mbgl::RendererObserver::onWillStartRenderingFrame);
     }
 
+    void onRenderingStats(const mbgl::RenderingStats& stats) final {
+        delegate.invoke(&mbgl::RendererObserver::onRenderingStats, stats);
+    }
+
     void onDidFinishRenderingFrame(RenderMode mode, bool repaintNeeded) final {
         delegate.invoke(&mbgl::RendererObserver::onDidFinishRenderingFrame, mode, repaintNeeded);
     }
@@ -7,14 +7,29 @@
 namespace mbgl {
 
 std::string encodePNG(const PremultipliedImage& pre) {
+    return encodePNG(pre, {});
+}
+
+// The scheduler is ignored; Qt encodes on the calling thread.
+std::string encodePNG(const PremultipliedImage& pre, const PNGEncodeOptions& options) {
     QImage image(pre.data.get(), pre.size.width, pre.size.height,
         QImage::Format_ARGB32_Premultiplied);
+    image = image.rgbSwapped();
+    if (options.flipY) {
+        image = image.mirrored();
+    }
+    if (options.palette) {
+        image = image.convertToFormat(QImage::Format_Indexed8);
+    }
+
+    // Qt derives the zlib level from the quality as (100 - quality) * 9 / 91.
+    const int quality = options.compressionLevel < 0 ? -1 : 100 - (options.compressionLevel * 91 + 8) / 9;
 
     QByteArray array;
     QBuffer buffer(&array);
 
     buffer.open(QIODevice::WriteOnly);
-    image.rgbSwapped().save(&buffer, "PNG");
+    image.save(&buffer, "PNG", quality);
 
     return std::string(array.constData(), array.size());
 }
@@ -2,6 +2,7 @@
 
 require('flow-remove-types/register');
 
+const fs = require('fs');
 const path = require('path');
 const outputPath = 'src/mbgl/shaders';
 
@@ -9,6 +10,20 @@ var shaders = require('../mapbox-gl-js/src/shaders');
 
 delete shaders.lineGradient;
 
+// Shaders that only exist in native, read from shaders/<name>.{vertex,fragment}.glsl.
+const nativeShadersPath = path.join(__dirname, '../shaders');
+for (const file of fs.readdirSync(nativeShadersPath)) {
+    const match = file.match(/^(.+)\.vertex\.glsl$/);
+    if (!match)
+        continue;
+
+    const key = match[1].replace(/_([a-z])/g, (_, letter) => letter.toUpperCase());
+    shaders[key] = {
+        vertexSource: fs.readFileSync(path.join(nativeShadersPath, file), 'utf8'),
+        fragmentSource: fs.readFileSync(path.join(nativeShadersPath, `${match[1]}.fragment.glsl`), 'utf8')
+    };
+}
+
 require('./style-code');
 
 writeIfModified(path.join(outputPath, 'preludes.hpp'), `// NOTE: DO NOT CHANGE THIS FILE. IT IS AUTOMATICALLY GENERATED.
@@ -0,0 +1,30 @@
+uniform highp vec4 u_color;
+uniform lowp float u_blur;
+uniform lowp float u_opacity;
+
+varying vec2 v_width2;
+varying vec2 v_normal;
+varying float v_gamma_scale;
+varying highp vec2 v_tile_pos;
+
+void main() {
+    // Clip to the tile, which covers the same pixels as the tile's stencil clipping mask.
+    if (v_tile_pos.x < 0.0 || v_tile_pos.y < 0.0 || v_tile_pos.x >= 1.0 || v_tile_pos.y >= 1.0) {
+        discard;
+    }
+
+    // Calculate the distance of the pixel from the line in pixels.
+    float dist = length(v_normal) * v_width2.s;
+
+    // Calculate the antialiasing fade factor. This is either when fading in
+    // the line in case of an offset line (v_width2.t) or when fading out
+    // (v_width2.s)
+    float blur2 = (u_blur + 1.0 / DEVICE_PIXEL_RATIO) * v_gamma_scale;
+    float alpha = clamp(min(dist - (v_width2.t - blur2), v_width2.s - dist) / blur2, 0.0, 1.0);
+
+    gl_FragColor = u_color * (alpha * u_opacity);
+
+#ifdef OVERDRAW_INSPECTOR
+    gl_FragColor = vec4(1.0);
+#endif
+}
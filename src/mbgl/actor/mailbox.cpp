@@ -3,36 +3,67 @@
 #include <mbgl/actor/scheduler.hpp>
 
 #include <cassert>
+#include <thread>
 
 namespace mbgl {
 
+namespace {
+
+// Registers a push in progress for the duration of a scope.
+class PushScope {
+public:
+    PushScope(std::atomic<std::size_t>& pushing_) : pushing(pushing_) {
+        pushing++;
+    }
+
+    ~PushScope() {
+        pushing--;
+    }
+
+private:
+    std::atomic<std::size_t>& pushing;
+};
+
+} // namespace
+
 Mailbox::Mailbox(Scheduler& scheduler_)
     : scheduler(scheduler_) {
 }
 
+Mailbox::~Mailbox() {
+    for (std::size_t n = queueSize; n > 0; n--) {
+        delete pop();
+    }
+}
+
 void Mailbox::close() {
-    // Block until neither receive() nor push() are in progress. Two mutexes are used because receive()
-    // must not block send(). Of the two, the receiving mutex must be acquired first, because that is
-    // the order that an actor will obtain them when it self-sends a message, and consistent lock
-    // acquisition order prevents deadlocks.
-    // The receiving mutex is recursive to allow a mailbox (and thus the actor) to close itself.
+    // Block until neither receive() nor push() are in progress. receive() is excluded by the
+    // receiving mutex, which is recursive to allow a mailbox (and thus the actor) to close itself.
+    // push() doesn't lock, so that senders never wait for each other or for the receiver: it
+    // registers itself before checking the closed flag, and close() sets the flag before waiting
+    // for registered pushes to finish, so every push either sees the flag or is waited for.
     std::lock_guard<std::recursive_mutex> receivingLock(receivingMutex);
-    std::lock_guard<std::mutex> pushingLock(pushingMutex);
 
     closed = true;
+
+    while (pushing != 0) {
+        std::this_thread::yield();
+    }
 }
 
 void Mailbox::push(std::unique_ptr<Message> message) {
-    std::lock_guard<std::mutex> pushingLock(pushingMutex);
+    PushScope pushScope(pushing);
 
     if (closed) {
         return;
     }
 
-    std::lock_guard<std::mutex> queueLock(queueMutex);
-    bool wasEmpty = queue.empty();
-    queue.push(std::move(message));
-    if (wasEmpty) {
+    Message* node = message.release();
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Message* prev = head.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+
+    if (queueSize.fetch_add(1, std::memory_order_acq_rel) == 0) {
         scheduler.schedule(shared_from_this());
     }
 }
@@ -44,16 +75,9 @@ void Mailbox::receive() {
         return;
     }
 
-    std::unique_ptr<Message> message;
-    bool wasEmpty;
-
-    {
-        std::lock_guard<std::mutex> queueLock(queueMutex);
-        assert(!queue.empty());
-        message = std::move(queue.front());
-        queue.pop();
-        wasEmpty = queue.empty();
-    }
+    assert(queueSize != 0);
+    std::unique_ptr<Message> message(pop());
+    bool wasEmpty = queueSize.fetch_sub(1, std::memory_order_acq_rel) == 1;
 
     (*message)();
 
@@ -62,6 +86,39 @@ void Mailbox::receive() {
     }
 }
 
+// Unlinks the message at the tail. Must only be called by the receiving thread, and only while
+// queueSize says that a message is queued. A producer that swapped itself in at the head but
+// hasn't linked itself to its predecessor yet holds up the messages behind it; we wait out that
+// window, which spans a single store.
+Message* Mailbox::pop() {
+    auto awaitNext = [] (Message& node) {
+        Message* next;
+        while (!(next = node.next.load(std::memory_order_acquire))) {
+            std::this_thread::yield();
+        }
+        return next;
+    };
+
+    Message* first = tail;
+    if (first == &stub) {
+        first = awaitNext(stub);
+    }
+
+    Message* next = first->next.load(std::memory_order_acquire);
+    if (!next) {
+        // first is the last message. Push the stub behind it so that it can be unlinked.
+        if (first == head.load(std::memory_order_acquire)) {
+            stub.next.store(nullptr, std::memory_order_relaxed);
+            Message* prev = head.exchange(&stub, std::memory_order_acq_rel);
+            prev->next.store(&stub, std::memory_order_release);
+        }
+        next = awaitNext(*first);
+    }
+
+    tail = next;
+    return first;
+}
+
 void Mailbox::maybeReceive(std::weak_ptr<Mailbox> mailbox) {
     if (auto locked = mailbox.lock()) {
         locked->receive();
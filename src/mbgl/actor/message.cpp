@@ -0,0 +1,125 @@
+#include <mbgl/actor/message.hpp>
+
+#include <cstdint>
+#include <new>
+
+namespace mbgl {
+
+namespace {
+
+// A fixed number of equally sized blocks that are handed out and returned through a lock-free
+// stack. Blocks are numbered from 1, and 0 ends the stack. The top of the stack packs the number
+// of the top block with a tag that changes on every update, so that a pop that raced with other
+// threads popping and pushing back the same block fails its compare-and-swap instead of linking
+// in a stale successor.
+template <std::size_t BlockSize>
+class MessagePool {
+public:
+    static constexpr uint32_t capacity = 256;
+
+    MessagePool() {
+        for (uint32_t i = 0; i < capacity; i++) {
+            links[i].store(i + 1 < capacity ? i + 2 : 0, std::memory_order_relaxed);
+        }
+        top.store(1);
+    }
+
+    void* allocate() {
+        uint64_t head = top.load(std::memory_order_acquire);
+        while (uint32_t block = index(head)) {
+            const uint32_t next = links[block - 1].load(std::memory_order_relaxed);
+            if (top.compare_exchange_weak(head, pack(tag(head) + 1, next),
+                                          std::memory_order_acquire, std::memory_order_acquire)) {
+                return storage + (block - 1) * BlockSize;
+            }
+        }
+        return nullptr;
+    }
+
+    bool owns(const void* ptr) const {
+        const auto address = reinterpret_cast<uintptr_t>(ptr);
+        const auto begin = reinterpret_cast<uintptr_t>(storage);
+        return address >= begin && address < begin + sizeof(storage);
+    }
+
+    void deallocate(void* ptr) {
+        const auto block = uint32_t((static_cast<char*>(ptr) - storage) / BlockSize) + 1;
+        uint64_t head = top.load(std::memory_order_relaxed);
+        do {
+            links[block - 1].store(index(head), std::memory_order_relaxed);
+        } while (!top.compare_exchange_weak(head, pack(tag(head) + 1, block),
+                                            std::memory_order_release, std::memory_order_relaxed));
+    }
+
+private:
+    static uint64_t pack(uint32_t tag_, uint32_t index_) {
+        return (uint64_t(tag_) << 32) | index_;
+    }
+
+    static uint32_t tag(uint64_t head) {
+        return uint32_t(head >> 32);
+    }
+
+    static uint32_t index(uint64_t head) {
+        return uint32_t(head);
+    }
+
+    alignas(alignof(std::max_align_t)) char storage[capacity * BlockSize];
+    std::atomic<uint32_t> links[capacity];
+    std::atomic<uint64_t> top;
+};
+
+template <std::size_t BlockSize>
+MessagePool<BlockSize>& pool() {
+    // Never destroyed, because messages may still be freed by threads that outlive static
+    // destruction.
+    static auto* instance = new MessagePool<BlockSize>();
+    return *instance;
+}
+
+template <std::size_t BlockSize>
+void* allocate(std::size_t size) {
+    if (void* ptr = pool<BlockSize>().allocate()) {
+        return ptr;
+    }
+    return ::operator new(size);
+}
+
+template <std::size_t BlockSize>
+void deallocate(void* ptr) {
+    if (pool<BlockSize>().owns(ptr)) {
+        pool<BlockSize>().deallocate(ptr);
+    } else {
+        ::operator delete(ptr);
+    }
+}
+
+} // namespace
+
+// The size passed to operator delete is that of the dynamic type, so it picks the same pool
+// as the size that was passed to operator new.
+void* Message::operator new(std::size_t size) {
+    if (size <= 64) {
+        return allocate<64>(size);
+    } else if (size <= 128) {
+        return allocate<128>(size);
+    } else if (size <= 256) {
+        return allocate<256>(size);
+    } else {
+        return ::operator new(size);
+    }
+}
+
+void Message::operator delete(void* ptr, std::size_t size) {
+    if (size <= 64) {
+        deallocate<64>(ptr);
+    } else if (size <= 128) {
+        deallocate<128>(ptr);
+    } else if (size <= 256) {
+        deallocate<256>(ptr);
+    } else {
+        ::operator delete(ptr);
+    }
+}
+
+} // namespace mbgl
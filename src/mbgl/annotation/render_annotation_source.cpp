@@ -23,6 +23,10 @@ bool RenderAnnotationSource::isLoaded() const {
     return tilePyramid.isLoaded();
 }
 
+std::size_t RenderAnnotationSource::getPendingTileCount() const {
+    return tilePyramid.getPendingTileCount();
+}
+
 void RenderAnnotationSource::update(Immutable<style::Source::Impl> baseImpl_,
                                     const std::vector<Immutable<Layer::Impl>>& layers,
                                     const bool needsRendering,
@@ -60,17 +64,18 @@ std::vector<std::reference_wrapper<RenderTile>> RenderAnnotationSource::getRende
     return tilePyramid.getRenderTiles();
 }
 
-std::unordered_map<std::string, std::vector<Feature>>
+std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>
 RenderAnnotationSource::queryRenderedFeatures(const ScreenLineString& geometry,
                                               const TransformState& transformState,
                                               const std::vector<const RenderLayer*>& layers,
                                               const RenderedQueryOptions& options,
-                                              const mat4& projMatrix) const {
-    return tilePyramid.queryRenderedFeatures(geometry, transformState, layers, options, projMatrix);
+                                              const mat4& projMatrix,
+                                              Scheduler& scheduler) const {
+    return tilePyramid.queryRenderedFeatures(geometry, transformState, layers, options, projMatrix, scheduler);
 }
 
-std::vector<Feature> RenderAnnotationSource::querySourceFeatures(const SourceQueryOptions&) const {
-    return {};
+void RenderAnnotationSource::querySourceFeatures(const std::function<void (Feature&&)>&,
+                                                 const SourceQueryOptions&) const {
 }
 
 void RenderAnnotationSource::reduceMemoryUse() {
@@ -12,6 +12,7 @@
 
 #include <mapbox/geometry/envelope.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <string>
 
@@ -39,7 +40,7 @@ void FeatureIndex::insert(const GeometryCollection& geometries,
 }
 
 void FeatureIndex::query(
-        std::unordered_map<std::string, std::vector<Feature>>& result,
+        std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>& result,
         const GeometryCoordinates& queryGeometry,
         const TransformState& transformState,
         const mat4& posMatrix,
@@ -78,12 +79,12 @@ void FeatureIndex::query(
     }
 }
     
-std::unordered_map<std::string, std::vector<Feature>> FeatureIndex::lookupSymbolFeatures(const std::vector<IndexedSubfeature>& symbolFeatures,
-                                                                                         const RenderedQueryOptions& queryOptions,
-                                                                                         const std::vector<const RenderLayer*>& layers,
-                                                                                         const OverscaledTileID& tileID,
-                                                                                        const std::shared_ptr<std::vector<size_t>>& featureSortOrder) const {
-    std::unordered_map<std::string, std::vector<Feature>> result;
+std::unordered_map<std::string, std::vector<RenderedFeatureHandle>> FeatureIndex::lookupSymbolFeatures(const std::vector<IndexedSubfeature>& symbolFeatures,
+                                                                                                       const RenderedQueryOptions& queryOptions,
+                                                                                                       const std::vector<const RenderLayer*>& layers,
+                                                                                                       const OverscaledTileID& tileID,
+                                                                                                       const std::shared_ptr<std::vector<size_t>>& featureSortOrder) const {
+    std::unordered_map<std::string, std::vector<RenderedFeatureHandle>> result;
     if (!tileData) {
         return result;
     }
@@ -118,7 +119,7 @@ std::unordered_map<std::string, std::vector<Feature>> FeatureIndex::lookupSymbol
 }
 
 void FeatureIndex::addFeature(
-    std::unordered_map<std::string, std::vector<Feature>>& result,
+    std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>& result,
     const IndexedSubfeature& indexedFeature,
     const RenderedQueryOptions& options,
     const CanonicalTileID& tileID,
@@ -164,10 +165,60 @@ void FeatureIndex::addFeature(
             continue;
         }
 
-        result[layerID].push_back(convertFeature(*geometryTileFeature, tileID));
+        result[layerID].push_back({ layerID, tileID, indexedFeature.sourceLayerName, indexedFeature.index, shared_from_this() });
     }
 }
 
+Feature FeatureIndex::getFeature(const RenderedFeatureHandle& handle, const RenderedQueryOptions& options) const {
+    assert(handle.index.get() == this);
+    auto sourceLayer = tileData->getLayer(handle.sourceLayer);
+    assert(sourceLayer);
+    auto geometryTileFeature = sourceLayer->getFeature(handle.featureIndex);
+    assert(geometryTileFeature);
+    return convertFeature(*geometryTileFeature, handle.tileID, options.properties, options.geometry);
+}
+
+std::vector<std::size_t> FeatureIndex::querySourceLayer(const std::string& sourceLayerName,
+                                                        const mapbox::geometry::box<int16_t>& box) const {
+    if (!tileData) {
+        return {};
+    }
+
+    auto it = sourceLayerGrids.find(sourceLayerName);
+    if (it == sourceLayerGrids.end()) {
+        GridIndex<std::size_t> sourceLayerGrid(util::EXTENT, util::EXTENT, util::EXTENT / 16);
+        if (auto sourceLayer = tileData->getLayer(sourceLayerName)) {
+            for (std::size_t i = 0; i < sourceLayer->featureCount(); i++) {
+                const GeometryCollection geometries = sourceLayer->getFeature(i)->getGeometries();
+                optional<mapbox::geometry::box<int16_t>> envelope;
+                for (const auto& ring : geometries) {
+                    if (ring.empty()) {
+                        continue;
+                    }
+                    auto ringEnvelope = mapbox::geometry::envelope(ring);
+                    envelope = envelope ? mapbox::geometry::box<int16_t> {
+                        { std::min(envelope->min.x, ringEnvelope.min.x), std::min(envelope->min.y, ringEnvelope.min.y) },
+                        { std::max(envelope->max.x, ringEnvelope.max.x), std::max(envelope->max.y, ringEnvelope.max.y) }
+                    } : ringEnvelope;
+                }
+                // Features in the tile's buffer are indexed by the neighbouring tile.
+                if (envelope &&
+                    envelope->min.x < util::EXTENT &&
+                    envelope->min.y < util::EXTENT &&
+                    envelope->max.x >= 0 &&
+                    envelope->max.y >= 0) {
+                    sourceLayerGrid.insert(std::size_t(i), { convertPoint<float>(envelope->min), convertPoint<float>(envelope->max) });
+                }
+            }
+        }
+        it = sourceLayerGrids.emplace(sourceLayerName, std::move(sourceLayerGrid)).first;
+    }
+
+    std::vector<std::size_t> result = it->second.query({ convertPoint<float>(box.min), convertPoint<float>(box.max) });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
 optional<GeometryCoordinates> FeatureIndex::translateQueryGeometry(
         const GeometryCoordinates& queryGeometry,
         const std::array<float, 2>& translate,
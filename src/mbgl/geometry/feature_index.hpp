@@ -7,6 +7,7 @@
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/mat4.hpp>
 
+#include <memory>
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -14,6 +15,7 @@
 namespace mbgl {
 
 class RenderedQueryOptions;
+class RenderedFeatureHandle;
 class RenderLayer;
 class TransformState;
 
@@ -47,7 +49,9 @@ public:
     uint32_t bucketInstanceId;
 };
 
-class FeatureIndex {
+// Query results are handles that keep the index alive, so an index must be owned by a
+// shared_ptr when it is queried.
+class FeatureIndex : public std::enable_shared_from_this<FeatureIndex> {
 public:
     FeatureIndex(std::unique_ptr<const GeometryTileData> tileData_);
 
@@ -56,7 +60,7 @@ public:
     void insert(const GeometryCollection&, std::size_t index, const std::string& sourceLayerName, const std::string& bucketName);
 
     void query(
-            std::unordered_map<std::string, std::vector<Feature>>& result,
+            std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>& result,
             const GeometryCoordinates& queryGeometry,
             const TransformState&,
             const mat4& posMatrix,
@@ -76,16 +80,26 @@ public:
 
     void setBucketLayerIDs(const std::string& bucketName, const std::vector<std::string>& layerIDs);
     
-    std::unordered_map<std::string, std::vector<Feature>> lookupSymbolFeatures(
+    std::unordered_map<std::string, std::vector<RenderedFeatureHandle>> lookupSymbolFeatures(
            const std::vector<IndexedSubfeature>& symbolFeatures,
            const RenderedQueryOptions& options,
            const std::vector<const RenderLayer*>& layers,
            const OverscaledTileID& tileID,
            const std::shared_ptr<std::vector<size_t>>& featureSortOrder) const;
 
+    // Converts a feature that was returned by a query of this index. Only the properties
+    // and geometry requested by the options are converted.
+    Feature getFeature(const RenderedFeatureHandle&, const RenderedQueryOptions&) const;
+
+    // Returns the indices of all features of the source layer, styled or not, whose bounding
+    // boxes intersect the given box in tile coordinates, in ascending order. The index of a
+    // source layer is built when it's first queried.
+    std::vector<std::size_t> querySourceLayer(const std::string& sourceLayerName,
+                                              const mapbox::geometry::box<int16_t>&) const;
+
 private:
     void addFeature(
-            std::unordered_map<std::string, std::vector<Feature>>& result,
+            std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>& result,
             const IndexedSubfeature&,
             const RenderedQueryOptions& options,
             const CanonicalTileID&,
@@ -100,5 +114,7 @@ private:
 
     std::unordered_map<std::string, std::vector<std::string>> bucketLayerIDs;
     std::unique_ptr<const GeometryTileData> tileData;
+
+    mutable std::unordered_map<std::string, GridIndex<std::size_t>> sourceLayerGrids;
 };
 } // namespace mbgl
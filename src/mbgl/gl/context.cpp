@@ -3,11 +3,14 @@
 #include <mbgl/gl/debugging_extension.hpp>
 #include <mbgl/gl/vertex_array_extension.hpp>
 #include <mbgl/gl/program_binary_extension.hpp>
+#include <mbgl/gl/pixel_buffer_extension.hpp>
 #include <mbgl/util/traits.hpp>
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <algorithm>
 #include <cstring>
+#include <stdexcept>
 
 namespace mbgl {
 namespace gl {
@@ -125,6 +128,9 @@ void Context::initializeExtensions(const std::function<gl::ProcAddress(const cha
 #if MBGL_HAS_BINARY_PROGRAMS
         programBinary = std::make_unique<extension::ProgramBinary>(fn);
 #endif
+        if (strstr(extensions, "_pixel_buffer_object") != nullptr) {
+            pixelBuffer = std::make_unique<extension::PixelBuffer>(fn);
+        }
 
 #if MBGL_USE_GLES2
         constexpr const char* halfFloatExtensionName = "OES_texture_half_float";
@@ -241,12 +247,21 @@ UniqueBuffer Context::createVertexBuffer(const void* data, std::size_t size, con
     UniqueBuffer result { std::move(id), { this } };
     vertexBuffer = result;
     MBGL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, size, data, static_cast<GLenum>(usage)));
+    setBufferSize(result, size);
+    uploadedVertexBytes += size;
     return result;
 }
 
 void Context::updateVertexBuffer(UniqueBuffer& buffer, const void* data, std::size_t size) {
     vertexBuffer = buffer;
     MBGL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, 0, size, data));
+    uploadedVertexBytes += size;
+}
+
+void Context::updateVertexBuffer(UniqueBuffer& buffer, const void* data, std::size_t offset, std::size_t size) {
+    vertexBuffer = buffer;
+    MBGL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
+    uploadedVertexBytes += size;
 }
 
 UniqueBuffer Context::createIndexBuffer(const void* data, std::size_t size, const BufferUsage usage) {
@@ -256,6 +271,8 @@ UniqueBuffer Context::createIndexBuffer(const void* data, std::size_t size, cons
     bindVertexArray = 0;
     globalVertexArrayState.indexBuffer = result;
     MBGL_CHECK_ERROR(glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, static_cast<GLenum>(usage)));
+    setBufferSize(result, size);
+    uploadedIndexBytes += size;
     return result;
 }
 
@@ -265,6 +282,7 @@ void Context::updateIndexBuffer(UniqueBuffer& buffer, const void* data, std::siz
     bindVertexArray = 0;
     globalVertexArrayState.indexBuffer = buffer;
     MBGL_CHECK_ERROR(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, size, data));
+    uploadedIndexBytes += size;
 }
 
 
@@ -346,6 +364,17 @@ optional<std::pair<BinaryProgramFormat, std::string>> Context::getBinaryProgram(
 }
 #endif
 
+std::string Context::getRendererIdentifier() const {
+    std::string result;
+    for (const GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+        if (const GLubyte* value = MBGL_CHECK_ERROR(glGetString(name))) {
+            result += reinterpret_cast<const char*>(value);
+        }
+        result += '\n';
+    }
+    return result;
+}
+
 VertexArray Context::createVertexArray() {
     if (supportsVertexArrays()) {
         VertexArrayID id = 0;
@@ -389,18 +418,77 @@ std::unique_ptr<uint8_t[]> Context::readFramebuffer(const Size size, const Textu
                                   GL_UNSIGNED_BYTE, data.get()));
 
     if (flip) {
-        auto tmp = std::make_unique<uint8_t[]>(stride);
         uint8_t* rgba = data.get();
         for (int i = 0, j = size.height - 1; i < j; i++, j--) {
-            std::memcpy(tmp.get(), rgba + i * stride, stride);
-            std::memcpy(rgba + i * stride, rgba + j * stride, stride);
-            std::memcpy(rgba + j * stride, tmp.get(), stride);
+            std::swap_ranges(rgba + i * stride, rgba + (i + 1) * stride, rgba + j * stride);
         }
     }
 
     return data;
 }
 
+bool Context::supportsAsyncReadback() const {
+    return pixelBuffer && pixelBuffer->mapBufferRange && pixelBuffer->unmapBuffer;
+}
+
+Readback Context::startReadback(const Size size, const TextureFormat format) {
+    const size_t bytes = size.area() * (format == TextureFormat::RGBA ? 4 : 1);
+    pixelStorePack = { 1 };
+
+    if (!supportsAsyncReadback()) {
+        auto data = std::make_unique<uint8_t[]>(bytes);
+        MBGL_CHECK_ERROR(glReadPixels(0, 0, size.width, size.height, static_cast<GLenum>(format),
+                                      GL_UNSIGNED_BYTE, data.get()));
+        return { size, format, {}, std::move(data) };
+    }
+
+    optional<UniqueBuffer> buffer;
+    if (pooledPixelBuffers.empty()) {
+        BufferID id = 0;
+        MBGL_CHECK_ERROR(glGenBuffers(1, &id));
+        buffer = UniqueBuffer { std::move(id), { this } };
+    } else {
+        buffer = std::move(pooledPixelBuffers.back());
+        pooledPixelBuffers.pop_back();
+    }
+
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, *buffer));
+    MBGL_CHECK_ERROR(glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ));
+    setBufferSize(*buffer, bytes);
+    MBGL_CHECK_ERROR(glReadPixels(0, 0, size.width, size.height, static_cast<GLenum>(format),
+                                  GL_UNSIGNED_BYTE, nullptr));
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+    return { size, format, std::move(buffer), {} };
+}
+
+std::unique_ptr<uint8_t[]> Context::finishReadback(Readback&& readback) {
+    if (!readback.buffer) {
+        return std::move(readback.data);
+    }
+
+    const size_t bytes = readback.size.area() * (readback.format == TextureFormat::RGBA ? 4 : 1);
+    auto data = std::make_unique<uint8_t[]>(bytes);
+
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, *readback.buffer));
+    const void* pixels = MBGL_CHECK_ERROR(pixelBuffer->mapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes, GL_MAP_READ_BIT));
+    if (pixels) {
+        std::memcpy(data.get(), pixels, bytes);
+        MBGL_CHECK_ERROR(pixelBuffer->unmapBuffer(GL_PIXEL_PACK_BUFFER));
+    }
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+    if (pooledPixelBuffers.size() < PixelBufferMax) {
+        pooledPixelBuffers.push_back(std::move(*readback.buffer));
+    }
+    readback.buffer = {};
+
+    if (!pixels) {
+        throw std::runtime_error("failed to map pixel buffer");
+    }
+    return data;
+}
+
 #if not MBGL_USE_GLES2
 void Context::drawPixels(const Size size, const void* data, TextureFormat format) {
     pixelStoreUnpack = { 1 };
@@ -541,6 +629,9 @@ void Context::updateTexture(
     MBGL_CHECK_ERROR(glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLenum>(format), size.width,
                                   size.height, 0, static_cast<GLenum>(format), static_cast<GLenum>(type),
                                   data));
+    setTextureSize(id, std::size_t(size.width) * size.height *
+                           (format == TextureFormat::RGBA ? 4 : 1) *
+                           (type == TextureType::HalfFloat ? 2 : 1));
 }
 
 void Context::bindTexture(Texture& obj,
@@ -549,6 +640,10 @@ void Context::bindTexture(Texture& obj,
                           TextureMipMap mipmap,
                           TextureWrap wrapX,
                           TextureWrap wrapY) {
+    if (texture[unit] != obj.texture) {
+        textureBinds++;
+    }
+
     if (filter != obj.filter || mipmap != obj.mipmap || wrapX != obj.wrapX || wrapY != obj.wrapY) {
         activeTextureUnit = unit;
         texture[unit] = obj.texture;
@@ -589,6 +684,7 @@ void Context::bindTexture(Texture& obj,
 void Context::reset() {
     std::copy(pooledTextures.begin(), pooledTextures.end(), std::back_inserter(abandonedTextures));
     pooledTextures.resize(0);
+    pooledPixelBuffers.clear();
     performCleanup();
 }
 
@@ -729,6 +825,7 @@ void Context::setColorMode(const ColorMode& color) {
 void Context::draw(PrimitiveType primitiveType,
                    std::size_t indexOffset,
                    std::size_t indexLength) {
+    drawCalls++;
     MBGL_CHECK_ERROR(glDrawElements(
         static_cast<GLenum>(primitiveType),
         static_cast<GLsizei>(indexLength),
@@ -736,6 +833,26 @@ void Context::draw(PrimitiveType primitiveType,
         reinterpret_cast<GLvoid*>(sizeof(uint16_t) * indexOffset)));
 }
 
+void Context::setBufferSize(BufferID id, std::size_t size) {
+    auto& entry = bufferSizes[id];
+    bufferMemory = bufferMemory - entry + size;
+    if (size) {
+        entry = size;
+    } else {
+        bufferSizes.erase(id);
+    }
+}
+
+void Context::setTextureSize(TextureID id, std::size_t size) {
+    auto& entry = textureSizes[id];
+    textureMemory = textureMemory - entry + size;
+    if (size) {
+        entry = size;
+    } else {
+        textureSizes.erase(id);
+    }
+}
+
 void Context::performCleanup() {
     for (auto id : abandonedPrograms) {
         if (program == id) {
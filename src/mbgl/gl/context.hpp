@@ -10,6 +10,7 @@
 #include <mbgl/gl/vertex_buffer.hpp>
 #include <mbgl/gl/index_buffer.hpp>
 #include <mbgl/gl/vertex_array.hpp>
+#include <mbgl/gl/readback.hpp>
 #include <mbgl/gl/types.hpp>
 #include <mbgl/gl/draw_mode.hpp>
 #include <mbgl/gl/depth_mode.hpp>
@@ -23,17 +24,20 @@
 #include <vector>
 #include <array>
 #include <string>
+#include <unordered_map>
 
 namespace mbgl {
 namespace gl {
 
 constexpr size_t TextureMax = 64;
+constexpr size_t PixelBufferMax = 3;
 using ProcAddress = void (*)();
 
 namespace extension {
 class VertexArray;
 class Debugging;
 class ProgramBinary;
+class PixelBuffer;
 } // namespace extension
 
 class Context : private util::noncopyable {
@@ -60,6 +64,10 @@ public:
 #endif
     optional<std::pair<BinaryProgramFormat, std::string>> getBinaryProgram(ProgramID) const;
 
+    // Identifies the GL implementation and driver version. Program binaries can only be loaded
+    // by the implementation that produced them.
+    std::string getRendererIdentifier() const;
+
     template <class Vertex, class DrawMode>
     VertexBuffer<Vertex, DrawMode> createVertexBuffer(VertexVector<Vertex, DrawMode>&& v, const BufferUsage usage = BufferUsage::StaticDraw) {
         return VertexBuffer<Vertex, DrawMode> {
@@ -68,12 +76,30 @@ public:
         };
     }
 
+    // Like the above, for vertices that the caller keeps to update the buffer later.
+    template <class Vertex, class DrawMode>
+    VertexBuffer<Vertex, DrawMode> createVertexBuffer(const VertexVector<Vertex, DrawMode>& v, const BufferUsage usage = BufferUsage::StaticDraw) {
+        return VertexBuffer<Vertex, DrawMode> {
+            v.vertexSize(),
+            createVertexBuffer(v.data(), v.byteSize(), usage)
+        };
+    }
+
     template <class Vertex, class DrawMode>
     void updateVertexBuffer(VertexBuffer<Vertex, DrawMode>& buffer, VertexVector<Vertex, DrawMode>&& v) {
         assert(v.vertexSize() == buffer.vertexCount);
         updateVertexBuffer(buffer.buffer, v.data(), v.byteSize());
     }
 
+    // Updates `count` vertices starting at `first`, leaving the rest of the buffer untouched.
+    template <class Vertex, class DrawMode>
+    void updateVertexBuffer(VertexBuffer<Vertex, DrawMode>& buffer, const VertexVector<Vertex, DrawMode>& v,
+                            std::size_t first, std::size_t count) {
+        assert(v.vertexSize() == buffer.vertexCount);
+        assert(first + count <= buffer.vertexCount);
+        updateVertexBuffer(buffer.buffer, v.data() + first, first * sizeof(Vertex), count * sizeof(Vertex));
+    }
+
     template <class DrawMode>
     IndexBuffer<DrawMode> createIndexBuffer(IndexVector<DrawMode>&& v, const BufferUsage usage = BufferUsage::StaticDraw) {
         return IndexBuffer<DrawMode> {
@@ -81,6 +107,15 @@ public:
             createIndexBuffer(v.data(), v.byteSize(), usage)
         };
     }
+
+    // Like the above, for indices that the caller keeps.
+    template <class DrawMode>
+    IndexBuffer<DrawMode> createIndexBuffer(const IndexVector<DrawMode>& v, const BufferUsage usage = BufferUsage::StaticDraw) {
+        return IndexBuffer<DrawMode> {
+            v.indexSize(),
+            createIndexBuffer(v.data(), v.byteSize(), usage)
+        };
+    }
     
     template <class DrawMode>
     void updateIndexBuffer(IndexBuffer<DrawMode>& buffer, IndexVector<DrawMode>&& v) {
@@ -115,6 +150,18 @@ public:
         return { size, readFramebuffer(size, format, flip) };
     }
 
+    // Starts reading the pixels of the bound framebuffer. With pixel buffer objects, this
+    // returns without waiting for rendering to finish, so the CPU can go on with other work
+    // while the GPU copies the pixels. The buffers come from a pool of up to PixelBufferMax
+    // buffers that are reused for later reads.
+    Readback startReadback(Size, TextureFormat = TextureFormat::RGBA);
+
+    // Waits for the pixels of a readback. The rows are ordered bottom to top, the way OpenGL
+    // returns them.
+    std::unique_ptr<uint8_t[]> finishReadback(Readback&&);
+
+    bool supportsAsyncReadback() const;
+
 #if not MBGL_USE_GLES2
     template <typename Image>
     void drawPixels(const Image& image) {
@@ -175,6 +222,22 @@ public:
               std::size_t indexOffset,
               std::size_t indexLength);
 
+    // Counts of the work issued through this context. Only used for profiling.
+    std::size_t drawCalls = 0;
+    std::size_t programSwitches = 0;
+    std::size_t textureBinds = 0;
+    std::size_t uploadedVertexBytes = 0;
+    std::size_t uploadedIndexBytes = 0;
+
+    // Bytes of buffer and texture storage allocated through this context that are still in use.
+    std::size_t getBufferMemory() const {
+        return bufferMemory;
+    }
+
+    std::size_t getTextureMemory() const {
+        return textureMemory;
+    }
+
     // Actually remove the objects we marked as abandoned with the above methods.
     // Only call this while the OpenGL context is exclusive to this thread.
     void performCleanup();
@@ -185,6 +248,7 @@ public:
 
     bool empty() const {
         return pooledTextures.empty()
+            && pooledPixelBuffers.empty()
             && abandonedPrograms.empty()
             && abandonedShaders.empty()
             && abandonedBuffers.empty()
@@ -195,6 +259,16 @@ public:
 
     void setDirtyState();
 
+    // Segments cache a vertex array for each index of a layer that draws them. Call this when
+    // layers are removed, so that the cached vertex arrays are released.
+    void releaseSegmentVertexArrays() {
+        segmentVertexArrayGeneration++;
+    }
+
+    std::size_t getSegmentVertexArrayGeneration() const {
+        return segmentVertexArrayGeneration;
+    }
+
     extension::Debugging* getDebuggingExtension() const {
         return debugging.get();
     }
@@ -209,12 +283,14 @@ public:
 
 private:
     bool cleanupOnDestruction = true;
+    std::size_t segmentVertexArrayGeneration = 0;
 
     std::unique_ptr<extension::Debugging> debugging;
     std::unique_ptr<extension::VertexArray> vertexArray;
 #if MBGL_HAS_BINARY_PROGRAMS
     std::unique_ptr<extension::ProgramBinary> programBinary;
 #endif
+    std::unique_ptr<extension::PixelBuffer> pixelBuffer;
 
 public:
     State<value::ActiveTextureUnit> activeTextureUnit;
@@ -265,6 +341,7 @@ private:
 
     UniqueBuffer createVertexBuffer(const void* data, std::size_t size, const BufferUsage usage);
     void updateVertexBuffer(UniqueBuffer& buffer, const void* data, std::size_t size);
+    void updateVertexBuffer(UniqueBuffer& buffer, const void* data, std::size_t offset, std::size_t size);
     UniqueBuffer createIndexBuffer(const void* data, std::size_t size, const BufferUsage usage);
     void updateIndexBuffer(UniqueBuffer& buffer, const void* data, std::size_t size);
     UniqueTexture createTexture(Size size, const void* data, TextureFormat, TextureUnit, TextureType);
@@ -278,6 +355,15 @@ private:
 
     bool supportsVertexArrays() const;
 
+    // Records the storage size of a buffer or texture; a size of zero forgets the object.
+    void setBufferSize(BufferID, std::size_t);
+    void setTextureSize(TextureID, std::size_t);
+
+    std::unordered_map<BufferID, std::size_t> bufferSizes;
+    std::unordered_map<TextureID, std::size_t> textureSizes;
+    std::size_t bufferMemory = 0;
+    std::size_t textureMemory = 0;
+
     friend detail::ProgramDeleter;
     friend detail::ShaderDeleter;
     friend detail::BufferDeleter;
@@ -296,6 +382,9 @@ private:
     std::vector<FramebufferID> abandonedFramebuffers;
     std::vector<RenderbufferID> abandonedRenderbuffers;
 
+    // Declared after the abandoned objects, which the deleters of the buffers add to.
+    std::vector<UniqueBuffer> pooledPixelBuffers;
+
 public:
     // For testing and Windows because Qt + ANGLE
     // crashes with VAO enabled.
@@ -19,11 +19,13 @@ void ShaderDeleter::operator()(ShaderID id) const {
 
 void BufferDeleter::operator()(BufferID id) const {
     assert(context);
+    context->setBufferSize(id, 0);
     context->abandonedBuffers.push_back(id);
 }
 
 void TextureDeleter::operator()(TextureID id) const {
     assert(context);
+    context->setTextureSize(id, 0);
     if (context->pooledTextures.size() >= TextureMax) {
         context->abandonedTextures.push_back(id);
     } else {
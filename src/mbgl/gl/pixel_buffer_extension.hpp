@@ -0,0 +1,38 @@
+#pragma once
+
+#include <mbgl/gl/extension.hpp>
+#include <mbgl/gl/gl.hpp>
+
+#define GL_PIXEL_PACK_BUFFER                       0x88EB
+#define GL_STREAM_READ                             0x88E1
+#define GL_MAP_READ_BIT                            0x0001
+
+namespace mbgl {
+namespace gl {
+namespace extension {
+
+// Mapping buffers for reading, which is what makes pixel buffer objects useful for reading back
+// framebuffers. The pixel buffer object extension itself adds no functions.
+class PixelBuffer {
+public:
+    template <typename Fn>
+    PixelBuffer(const Fn& loadExtension)
+        : mapBufferRange(loadExtension({
+              { "GL_ARB_map_buffer_range", "glMapBufferRange" },
+              { "GL_EXT_map_buffer_range", "glMapBufferRangeEXT" },
+          })),
+          unmapBuffer(loadExtension({
+              { "GL_ARB_map_buffer_range", "glUnmapBuffer" },
+              { "GL_OES_mapbuffer", "glUnmapBufferOES" },
+          })) {
+    }
+
+    const ExtensionFunction<void*(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)>
+        mapBufferRange;
+
+    const ExtensionFunction<GLboolean(GLenum target)> unmapBuffer;
+};
+
+} // namespace extension
+} // namespace gl
+} // namespace mbgl
@@ -9,9 +9,9 @@
 #include <mbgl/gl/attribute.hpp>
 #include <mbgl/gl/uniform.hpp>
 
-#include <mbgl/util/io.hpp>
 #include <mbgl/util/logging.hpp>
 #include <mbgl/programs/binary_program.hpp>
+#include <mbgl/programs/binary_program_cache.hpp>
 #include <mbgl/programs/program_parameters.hpp>
 #include <mbgl/shaders/shaders.hpp>
 
@@ -61,20 +61,14 @@ public:
         const std::string fragmentSource = shaders::fragmentSource(programParameters, fragmentSource_);
 
 #if MBGL_HAS_BINARY_PROGRAMS
-        optional<std::string> cachePath = programParameters.cachePath(name);
-        if (cachePath && context.supportsProgramBinaries()) {
+        BinaryProgramCache* cache = programParameters.getCache();
+        if (cache && context.supportsProgramBinaries()) {
+            const std::string key = programParameters.cacheKey(name);
             const std::string identifier = shaders::programIdentifier(vertexSource, fragmentSource);
 
             try {
-                if (auto cachedBinaryProgram = util::readFile(*cachePath)) {
-                    const BinaryProgram binaryProgram(std::move(*cachedBinaryProgram));
-                    if (binaryProgram.identifier() == identifier) {
-                        return Program { context, binaryProgram };
-                    } else {
-                        Log::Warning(Event::OpenGL,
-                                     "Cached program %s changed. Recompilation required.",
-                                     name);
-                    }
+                if (auto cachedBinaryProgram = cache->get(key, identifier)) {
+                    return Program { context, *cachedBinaryProgram };
                 }
             } catch (std::runtime_error& error) {
                 Log::Warning(Event::OpenGL, "Could not load cached program: %s",
@@ -84,14 +78,10 @@ public:
             // Compile the shader
             Program result{ context, vertexSource, fragmentSource };
 
-            try {
-                if (const auto binaryProgram =
-                        result.template get<BinaryProgram>(context, identifier)) {
-                    util::write_file(*cachePath, binaryProgram->serialize());
-                    Log::Warning(Event::OpenGL, "Caching program in: %s", (*cachePath).c_str());
-                }
-            } catch (std::runtime_error& error) {
-                Log::Warning(Event::OpenGL, "Failed to cache program: %s", error.what());
+            if (const auto binaryProgram =
+                    result.template get<BinaryProgram>(context, identifier)) {
+                cache->put(key, *binaryProgram);
+                Log::Info(Event::OpenGL, "Caching program %s", key.c_str());
             }
 
             return std::move(result);
@@ -131,6 +121,9 @@ public:
         context.setStencilMode(stencilMode);
         context.setColorMode(colorMode);
 
+        if (context.program != program) {
+            context.programSwitches++;
+        }
         context.program = program;
 
         Uniforms::bind(uniformsState, uniformValues);
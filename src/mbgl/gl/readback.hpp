@@ -0,0 +1,25 @@
+#pragma once
+
+#include <mbgl/gl/object.hpp>
+#include <mbgl/gl/types.hpp>
+#include <mbgl/util/optional.hpp>
+#include <mbgl/util/size.hpp>
+
+#include <memory>
+
+namespace mbgl {
+namespace gl {
+
+// Pixels that are being read from a framebuffer. When they are read into a pixel buffer object,
+// the GPU copies them once the commands before the read have finished, and the read may still
+// be in progress; otherwise they were read right away.
+class Readback {
+public:
+    Size size;
+    TextureFormat format;
+    optional<UniqueBuffer> buffer;
+    std::unique_ptr<uint8_t[]> data;
+};
+
+} // namespace gl
+} // namespace mbgl
@@ -4,6 +4,7 @@
 #include <mbgl/util/size.hpp>
 #include <mbgl/util/convert.hpp>
 
+#include <algorithm>
 #include <memory>
 
 namespace mbgl {
@@ -53,6 +54,15 @@ void bindUniform<std::array<double, 16>>(UniformLocation location, const std::ar
     MBGL_CHECK_ERROR(glUniformMatrix4fv(location, 1, GL_FALSE, util::convert<float>(t).data()));
 }
 
+template <>
+void bindUniform<std::array<std::array<double, 16>, 16>>(UniformLocation location, const std::array<std::array<double, 16>, 16>& t) {
+    std::array<float, 16 * 16> matrices;
+    for (std::size_t i = 0; i < t.size(); i++) {
+        std::transform(t[i].begin(), t[i].end(), matrices.begin() + i * 16,
+                       [] (double value) { return static_cast<float>(value); });
+    }
+    MBGL_CHECK_ERROR(glUniformMatrix4fv(location, static_cast<GLsizei>(t.size()), GL_FALSE, matrices.data()));
+}
 
 template <>
 void bindUniform<bool>(UniformLocation location, const bool& t) {
@@ -98,8 +108,15 @@ ActiveUniforms activeUniforms(ProgramID id) {
     for (GLint index = 0; index < count; index++) {
         MBGL_CHECK_ERROR(
             glGetActiveUniform(id, index, maxLength, &length, &size, &type, name.get()));
+        std::string uniformName { name.get(), static_cast<size_t>(length) };
+        // Arrays are reported by the name of their first element.
+        const std::string arraySuffix = "[0]";
+        if (uniformName.size() > arraySuffix.size() &&
+            uniformName.compare(uniformName.size() - arraySuffix.size(), arraySuffix.size(), arraySuffix) == 0) {
+            uniformName.resize(uniformName.size() - arraySuffix.size());
+        }
         active.emplace(
-            std::string{ name.get(), static_cast<size_t>(length) },
+            std::move(uniformName),
             ActiveUniform{ static_cast<size_t>(size), static_cast<UniformDataType>(type) });
     }
 
@@ -130,6 +147,12 @@ bool verifyUniform<std::array<double, 16>>(const ActiveUniform& uniform) {
     return true;
 }
 
+template <>
+bool verifyUniform<std::array<std::array<double, 16>, 16>>(const ActiveUniform& uniform) {
+    assert(uniform.size == 16 && uniform.type == UniformDataType::FloatMat4);
+    return true;
+}
+
 template <>
 bool verifyUniform<bool>(const ActiveUniform& uniform) {
     assert(uniform.size == 1 &&
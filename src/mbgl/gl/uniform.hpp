@@ -71,6 +71,9 @@ using UniformVector = Uniform<Tag, std::array<T, N>>;
 template <class Tag, class T, size_t N>
 using UniformMatrix = Uniform<Tag, std::array<T, N*N>>;
 
+template <class Tag, class T, size_t N, size_t Count>
+using UniformMatrixArray = Uniform<Tag, std::array<std::array<T, N*N>, Count>>;
+
 #define MBGL_DEFINE_UNIFORM_SCALAR(type_, name_) \
     struct name_ : ::mbgl::gl::UniformScalar<name_, type_> { static auto name() { return #name_; } }
 
@@ -80,6 +83,9 @@ using UniformMatrix = Uniform<Tag, std::array<T, N*N>>;
 #define MBGL_DEFINE_UNIFORM_MATRIX(type_, n_, name_) \
     struct name_ : ::mbgl::gl::UniformMatrix<name_, type_, n_> { static auto name() { return #name_; } }
 
+#define MBGL_DEFINE_UNIFORM_MATRIX_ARRAY(type_, n_, count_, name_) \
+    struct name_ : ::mbgl::gl::UniformMatrixArray<name_, type_, n_, count_> { static auto name() { return #name_; } }
+
 UniformLocation uniformLocation(ProgramID, const char * name);
 
 template <class... Us>
@@ -82,6 +82,7 @@ public:
     bool cameraMutated = false;
 
     uint8_t prefetchZoomDelta = util::DEFAULT_PREFETCH_ZOOM_DELTA;
+    std::vector<CameraOptions> prefetchCameras;
 
     bool loading = false;
     bool rendererFullyLoaded;
@@ -734,6 +735,10 @@ uint8_t Map::getPrefetchZoomDelta() const {
     return impl->prefetchZoomDelta;
 }
 
+void Map::setPrefetchCameras(std::vector<CameraOptions> cameras) {
+    impl->prefetchCameras = std::move(cameras);
+}
+
 bool Map::isFullyLoaded() const {
     return impl->style->impl->isLoaded() && impl->rendererFullyLoaded;
 }
@@ -756,6 +761,13 @@ void Map::Impl::onUpdate() {
 
     transform.updateTransitions(timePoint);
 
+    std::vector<TransformState> prefetchStates = transform.getPredictedStates(timePoint);
+    for (const auto& camera : prefetchCameras) {
+        Transform prefetch(transform.getState());
+        prefetch.jumpTo(camera);
+        prefetchStates.push_back(prefetch.getState());
+    }
+
     UpdateParameters params = {
         style->impl->isLoaded(),
         mode,
@@ -772,6 +784,7 @@ void Map::Impl::onUpdate() {
         style->impl->getLayerImpls(),
         annotationManager,
         prefetchZoomDelta,
+        std::move(prefetchStates),
         bool(stillImageRequest)
     };
 
@@ -16,6 +16,9 @@
 
 namespace mbgl {
 
+/** How far ahead of the current frame of an animation tiles are requested. */
+static constexpr Duration predictionLookahead = Milliseconds(500);
+
 /** Converts the given angle (in radians) to be numerically close to the anchor angle, allowing it to be interpolated properly without sudden jumps. */
 static double _normalizeAngle(double angle, double anchorAngle)
 {
@@ -577,8 +580,9 @@ void Transform::startTransition(const CameraOptions& camera,
     transitionStart = Clock::now();
     transitionDuration = duration;
 
-    transitionFrameFn = [isAnimated, animation, frame, anchor, anchorLatLng, this](const TimePoint now) {
-        float t = isAnimated ? (std::chrono::duration<float>(now - transitionStart) / transitionDuration) : 1.0;
+    // Moves the state to where the animation is at the given time, and returns the progress.
+    auto applyFrame = [isAnimated, animation, frame, anchor, anchorLatLng, this](const TimePoint time) {
+        float t = isAnimated ? (std::chrono::duration<float>(time - transitionStart) / transitionDuration) : 1.0;
         if (t >= 1.0) {
             frame(1.0);
         } else {
@@ -587,6 +591,19 @@ void Transform::startTransition(const CameraOptions& camera,
         }
 
         if (anchor) state.moveLatLng(anchorLatLng, *anchor);
+        return t;
+    };
+
+    transitionPredictFn = [applyFrame, this](const TimePoint time) {
+        const TransformState current = state;
+        applyFrame(time);
+        TransformState predicted = state;
+        state = current;
+        return predicted;
+    };
+
+    transitionFrameFn = [applyFrame, animation, this](const TimePoint now) {
+        const float t = applyFrame(now);
 
         // At t = 1.0, a DidChangeAnimated notification should be sent from finish().
         if (t < 1.0) {
@@ -623,6 +640,21 @@ bool Transform::inTransition() const {
     return transitionFrameFn != nullptr;
 }
 
+std::vector<TransformState> Transform::getPredictedStates(const TimePoint& now) {
+    std::vector<TransformState> predicted;
+    if (!inTransition()) {
+        return predicted;
+    }
+
+    const TimePoint end = transitionStart + transitionDuration;
+    const TimePoint ahead = now + predictionLookahead;
+    if (ahead < end) {
+        predicted.push_back(transitionPredictFn(ahead));
+    }
+    predicted.push_back(transitionPredictFn(end));
+    return predicted;
+}
+
 void Transform::updateTransitions(const TimePoint& now) {
     if (transitionFrameFn) {
         transitionFrameFn(now);
@@ -636,6 +668,7 @@ void Transform::cancelTransitions() {
 
     transitionFrameFn = nullptr;
     transitionFinishFn = nullptr;
+    transitionPredictFn = nullptr;
 }
 
 void Transform::setGestureInProgress(bool inProgress) {
@@ -12,6 +12,7 @@
 #include <cstdint>
 #include <cmath>
 #include <functional>
+#include <vector>
 
 namespace mbgl {
 
@@ -136,6 +137,10 @@ public:
     // Transitions
     bool inTransition() const;
     void updateTransitions(const TimePoint& now);
+    /** Returns the viewports of the current animation a short time after the given
+        time and at its end, so that their tiles can be loaded before the camera gets
+        there. Returns nothing when no animation is running. */
+    std::vector<TransformState> getPredictedStates(const TimePoint& now);
     TimePoint getTransitionStart() const { return transitionStart; }
     Duration getTransitionDuration() const { return transitionDuration; }
     void cancelTransitions();
@@ -167,6 +172,7 @@ private:
     Duration transitionDuration;
     std::function<void(const TimePoint)> transitionFrameFn;
     std::function<void()> transitionFinishFn;
+    std::function<TransformState(const TimePoint)> transitionPredictFn;
 };
 
 } // namespace mbgl
@@ -0,0 +1,204 @@
+#include <mbgl/programs/binary_program_cache.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/logging.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <protozero/pbf_reader.hpp>
+#include <protozero/pbf_writer.hpp>
+
+#include <cstdio>
+#include <thread>
+
+namespace mbgl {
+
+namespace {
+
+// Bump this when the layout of the cache file changes.
+constexpr uint32_t cacheVersion = 2;
+
+// How often the used time of an entry is updated, and how often changes are written.
+constexpr Seconds usedResolution { 24 * 60 * 60 };
+constexpr Seconds writeInterval { 1 };
+
+} // namespace
+
+BinaryProgramCache::BinaryProgramCache(std::string path_, std::string renderer_, Duration maximumAge_)
+    : path(std::move(path_)),
+      renderer(std::move(renderer_)),
+      maximumAge(maximumAge_) {
+}
+
+BinaryProgramCache::~BinaryProgramCache() {
+    if (dirty) {
+        write();
+    }
+}
+
+void BinaryProgramCache::load() {
+    if (loaded) {
+        return;
+    }
+    loaded = true;
+
+    optional<std::string> data = util::readFile(path);
+    bool valid = false;
+    const Timestamp now = util::now();
+
+    if (data) {
+        try {
+            protozero::pbf_reader pbf(*data);
+            while (pbf.next()) {
+                switch (pbf.tag()) {
+                case 1: { // header
+                    uint32_t version = 0;
+                    std::string writtenBy;
+                    protozero::pbf_reader header = pbf.get_message();
+                    while (header.next()) {
+                        switch (header.tag()) {
+                        case 1: // version
+                            version = header.get_uint32();
+                            break;
+                        case 2: // renderer
+                            writtenBy = header.get_string();
+                            break;
+                        default:
+                            header.skip();
+                            break;
+                        }
+                    }
+                    valid = version == cacheVersion && writtenBy == renderer;
+                    break;
+                }
+                case 2: { // entry
+                    if (!valid) {
+                        pbf.skip();
+                        break;
+                    }
+                    std::string key;
+                    Entry entry;
+                    protozero::pbf_reader message = pbf.get_message();
+                    while (message.next()) {
+                        switch (message.tag()) {
+                        case 1: // key
+                            key = message.get_string();
+                            break;
+                        case 2: // program
+                            entry.program = message.get_bytes();
+                            break;
+                        case 3: // used, in seconds since the epoch
+                            entry.used = Timestamp(Seconds(message.get_int64()));
+                            break;
+                        default:
+                            message.skip();
+                            break;
+                        }
+                    }
+                    if (now - entry.used < maximumAge) {
+                        entries[key] = std::move(entry);
+                    } else {
+                        dirty = true;
+                    }
+                    break;
+                }
+                default:
+                    pbf.skip();
+                    break;
+                }
+            }
+        } catch (const std::exception& error) {
+            Log::Warning(Event::OpenGL, "Truncated program cache: %s", error.what());
+            dirty = true;
+        }
+    }
+
+    if (!valid) {
+        entries.clear();
+        dirty = bool(data);
+    }
+}
+
+void BinaryProgramCache::write() {
+    dirty = false;
+    lastWrite = Clock::now();
+
+    std::string data;
+    protozero::pbf_writer pbf(data);
+    {
+        protozero::pbf_writer header(pbf, 1 /* header */);
+        header.add_uint32(1 /* version */, cacheVersion);
+        header.add_string(2 /* renderer */, renderer);
+    }
+    for (const auto& entry : entries) {
+        protozero::pbf_writer message(pbf, 2 /* entry */);
+        message.add_string(1 /* key */, entry.first);
+        message.add_bytes(2 /* program */, entry.second.program.data(), entry.second.program.size());
+        message.add_int64(3 /* used */, entry.second.used.time_since_epoch().count());
+    }
+
+    // Write the new contents next to the file and rename them over it, so that no process ever
+    // reads a partially written file.
+    const std::string temporaryPath = path + "." + util::toString(std::hash<std::thread::id>()(std::this_thread::get_id())) +
+                                      "." + util::toString(Clock::now().time_since_epoch().count()) + ".tmp";
+    try {
+        util::write_file(temporaryPath, data);
+    } catch (const std::runtime_error& error) {
+        Log::Warning(Event::OpenGL, "Failed to write program cache: %s", error.what());
+        return;
+    }
+
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        // Windows doesn't rename over existing files.
+        std::remove(path.c_str());
+        if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+            Log::Warning(Event::OpenGL, "Failed to replace program cache %s", path.c_str());
+            std::remove(temporaryPath.c_str());
+        }
+    }
+}
+
+optional<BinaryProgram> BinaryProgramCache::get(const std::string& key, const std::string& identifier) {
+    load();
+
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        return {};
+    }
+
+    try {
+        BinaryProgram program(std::string(it->second.program));
+        if (program.identifier() == identifier) {
+            const Timestamp now = util::now();
+            if (now - it->second.used >= usedResolution) {
+                it->second.used = now;
+                dirty = true;
+            }
+            return std::move(program);
+        }
+    } catch (const std::runtime_error& error) {
+        Log::Warning(Event::OpenGL, "Could not load cached program: %s", error.what());
+    }
+
+    entries.erase(it);
+    dirty = true;
+    return {};
+}
+
+void BinaryProgramCache::put(const std::string& key, const BinaryProgram& program) {
+    load();
+
+    entries[key] = Entry { program.serialize(), util::now() };
+    dirty = true;
+
+    // Programs are mostly compiled in bursts, so the writes of a burst are spaced out. The
+    // destructor writes the rest.
+    if (!lastWrite || Clock::now() - *lastWrite >= writeInterval) {
+        write();
+    }
+}
+
+std::size_t BinaryProgramCache::size() {
+    load();
+    return entries.size();
+}
+
+} // namespace mbgl
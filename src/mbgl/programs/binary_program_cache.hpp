@@ -0,0 +1,54 @@
+#pragma once
+
+#include <mbgl/programs/binary_program.hpp>
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
+#include <mbgl/util/chrono.hpp>
+
+#include <map>
+#include <string>
+
+namespace mbgl {
+
+// Stores the binary programs of all program variants in a single file. Entries are keyed by
+// program name and a hash of the program's defines, and the whole file is tied to the GL
+// implementation that produced it: binaries written by a different renderer or driver version
+// are discarded when the file is opened. Entries that weren't used for the maximum age, e.g.
+// those of programs that no longer exist, are dropped as well.
+//
+// Changes are kept in memory and written at most once per second, and when the cache is
+// destroyed. Each write replaces the whole file through a rename, so processes that share the
+// file never see a partial one. If several processes write the file, the last one wins.
+class BinaryProgramCache : private util::noncopyable {
+public:
+    BinaryProgramCache(std::string path, std::string renderer, Duration maximumAge = Seconds(30 * 24 * 60 * 60));
+    ~BinaryProgramCache();
+
+    // Returns the cached program for the given key if it was compiled from sources with the
+    // given identifier. Entries compiled from other sources are stale and are removed.
+    optional<BinaryProgram> get(const std::string& key, const std::string& identifier);
+
+    void put(const std::string& key, const BinaryProgram&);
+
+    std::size_t size();
+
+private:
+    void load();
+    void write();
+
+    const std::string path;
+    const std::string renderer;
+    const Duration maximumAge;
+    bool loaded = false;
+    bool dirty = false;
+    optional<TimePoint> lastWrite;
+
+    struct Entry {
+        // Serialized BinaryProgram object.
+        std::string program;
+        Timestamp used;
+    };
+    std::map<std::string, Entry> entries;
+};
+
+} // namespace mbgl
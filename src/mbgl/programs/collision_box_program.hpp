@@ -69,7 +69,7 @@ public:
               const PaintPropertyBinders& paintPropertyBinders,
               const typename PaintProperties::PossiblyEvaluated& currentProperties,
               float currentZoom,
-              const std::string& layerID) {
+              std::size_t layerIndex) {
         typename AllUniforms::Values allUniformValues = uniformValues
             .concat(paintPropertyBinders.uniformValues(currentZoom, currentProperties));
 
@@ -80,12 +80,6 @@ public:
         assert(layoutVertexBuffer.vertexCount == dynamicVertexBuffer.vertexCount);
 
         for (auto& segment : segments) {
-            auto vertexArrayIt = segment.vertexArrays.find(layerID);
-
-            if (vertexArrayIt == segment.vertexArrays.end()) {
-                vertexArrayIt = segment.vertexArrays.emplace(layerID, context.createVertexArray()).first;
-            }
-
             program.draw(
                     context,
                     std::move(drawMode),
@@ -93,7 +87,7 @@ public:
                     std::move(stencilMode),
                     std::move(colorMode),
                     allUniformValues,
-                    vertexArrayIt->second,
+                    segment.vertexArray(context, layerIndex),
                     Attributes::offsetBindings(allAttributeBindings, segment.vertexOffset),
                     indexBuffer,
                     segment.indexOffset,
@@ -148,7 +142,7 @@ public:
               const PaintPropertyBinders& paintPropertyBinders,
               const typename PaintProperties::PossiblyEvaluated& currentProperties,
               float currentZoom,
-              const std::string& layerID) {
+              std::size_t layerIndex) {
         typename AllUniforms::Values allUniformValues = uniformValues
             .concat(paintPropertyBinders.uniformValues(currentZoom, currentProperties));
 
@@ -157,12 +151,6 @@ public:
             .concat(paintPropertyBinders.attributeBindings(currentProperties));
 
         for (auto& segment : segments) {
-            auto vertexArrayIt = segment.vertexArrays.find(layerID);
-
-            if (vertexArrayIt == segment.vertexArrays.end()) {
-                vertexArrayIt = segment.vertexArrays.emplace(layerID, context.createVertexArray()).first;
-            }
-
             program.draw(
                     context,
                     std::move(drawMode),
@@ -170,7 +158,7 @@ public:
                     std::move(stencilMode),
                     std::move(colorMode),
                     allUniformValues,
-                    vertexArrayIt->second,
+                    segment.vertexArray(context, layerIndex),
                     Attributes::offsetBindings(allAttributeBindings, segment.vertexOffset),
                     indexBuffer,
                     segment.indexOffset,
@@ -5,12 +5,22 @@
 #include <mbgl/map/transform_state.hpp>
 #include <mbgl/util/mat2.hpp>
 #include <mbgl/geometry/line_atlas.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <cassert>
 
 namespace mbgl {
 
 using namespace style;
 
 static_assert(sizeof(LineLayoutVertex) == 12, "expected LineLayoutVertex size");
+static_assert(sizeof(LineBatchedLayoutVertex) == 14, "expected LineBatchedLayoutVertex size");
+static_assert(std::tuple_size<uniforms::u_matrices::Type>::value == LineBatchedProgram::maxTiles,
+              "expected a matrix for each batched tile");
+static_assert(util::EXTENT == 8192, "line_batched.vertex.glsl assumes an extent of 8192");
+
+constexpr std::size_t LineBatchedProgram::maxTiles;
+constexpr std::size_t LineBatchedProgram::maxTileVertices;
 
 template <class Values, class...Args>
 Values makeValues(const RenderLinePaintProperties::PossiblyEvaluated& properties,
@@ -116,4 +126,25 @@ LinePatternProgram::uniformValues(const RenderLinePaintProperties::PossiblyEvalu
     );
 }
 
+LineBatchedProgram::UniformValues
+LineBatchedProgram::uniformValues(const RenderLinePaintProperties::PossiblyEvaluated& properties,
+                                  const std::vector<std::reference_wrapper<const RenderTile>>& tiles,
+                                  const TransformState& state,
+                                  const std::array<float, 2>& pixelsToGLUnits) {
+    assert(!tiles.empty() && tiles.size() <= maxTiles);
+
+    std::array<mat4, maxTiles> matrices {};
+    for (std::size_t i = 0; i < tiles.size(); i++) {
+        matrices[i] = tiles[i].get().translatedMatrix(properties.get<LineTranslate>(),
+                                                      properties.get<LineTranslateAnchor>(),
+                                                      state);
+    }
+
+    return LineBatchedProgram::UniformValues {
+        uniforms::u_matrices::Value{ matrices },
+        uniforms::u_ratio::Value{ 1.0f / tiles.front().get().id.pixelsToTileUnits(1.0, state.getZoom()) },
+        uniforms::u_gl_units_to_pixels::Value{{{ 1.0f / pixelsToGLUnits[0], 1.0f / pixelsToGLUnits[1] }}}
+    };
+}
+
 } // namespace mbgl
@@ -4,12 +4,15 @@
 #include <mbgl/programs/attributes.hpp>
 #include <mbgl/programs/uniforms.hpp>
 #include <mbgl/shaders/line.hpp>
+#include <mbgl/shaders/line_batched.hpp>
 #include <mbgl/shaders/line_pattern.hpp>
 #include <mbgl/shaders/line_sdf.hpp>
 #include <mbgl/util/geometry.hpp>
 #include <mbgl/renderer/layers/render_line_layer.hpp>
 
 #include <cmath>
+#include <functional>
+#include <vector>
 
 namespace mbgl {
 
@@ -27,6 +30,7 @@ MBGL_DEFINE_UNIFORM_SCALAR(float, u_fade);
 MBGL_DEFINE_UNIFORM_VECTOR(float, 2, u_patternscale_a);
 MBGL_DEFINE_UNIFORM_VECTOR(float, 2, u_patternscale_b);
 MBGL_DEFINE_UNIFORM_VECTOR(float, 2, u_gl_units_to_pixels);
+MBGL_DEFINE_UNIFORM_MATRIX_ARRAY(double, 4, 16, u_matrices);
 } // namespace uniforms
 
 struct LineLayoutAttributes : gl::Attributes<
@@ -159,7 +163,57 @@ public:
                                        float atlasWidth);
 };
 
+struct LineBatchedLayoutAttributes : gl::Attributes<
+    attributes::a_pos_normal,
+    attributes::a_data<uint8_t, 4>,
+    attributes::a_tile>
+{};
+
+/*
+ * Draws the lines of up to `maxTiles` tiles in a single call. Each vertex carries the index of
+ * its tile, which picks the tile's matrix from `u_matrices`. The tiles aren't clipped with the
+ * stencil buffer: the fragment shader discards whatever lies outside of the tile instead, so the
+ * tiles must not overlap, and their stencil clip must cover the whole tile. Only used when no
+ * paint property is data-driven.
+ */
+class LineBatchedProgram : public Program<
+    shaders::line_batched,
+    gl::Triangle,
+    LineBatchedLayoutAttributes,
+    gl::Uniforms<
+        uniforms::u_matrices,
+        uniforms::u_ratio,
+        uniforms::u_gl_units_to_pixels>,
+    RenderLinePaintProperties>
+{
+public:
+    using Program::Program;
+
+    // Bounded by the 128 vertex uniform vectors OpenGL ES 2.0 guarantees, four per matrix.
+    static constexpr std::size_t maxTiles = 16;
+
+    // Buckets with more vertices are drawn on their own. Their geometry would be expensive to
+    // copy, and their draw calls are few compared to the work they do.
+    static constexpr std::size_t maxTileVertices = 4096;
+
+    static LayoutVertex layoutVertex(const LineProgram::LayoutVertex& vertex, uint8_t tile) {
+        return LayoutVertex {
+            vertex.a1,
+            vertex.a2,
+            {{ tile }}
+        };
+    }
+
+    // All tiles must have the same zoom level.
+    static UniformValues uniformValues(const RenderLinePaintProperties::PossiblyEvaluated&,
+                                       const std::vector<std::reference_wrapper<const RenderTile>>&,
+                                       const TransformState&,
+                                       const std::array<float, 2>& pixelsToGLUnits);
+};
+
 using LineLayoutVertex = LineProgram::LayoutVertex;
 using LineAttributes = LineProgram::Attributes;
+using LineBatchedLayoutVertex = LineBatchedProgram::LayoutVertex;
+using LineBatchedAttributes = LineBatchedProgram::Attributes;
 
 } // namespace mbgl
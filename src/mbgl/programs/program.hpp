@@ -59,7 +59,7 @@ public:
               const PaintPropertyBinders& paintPropertyBinders,
               const typename PaintProperties::PossiblyEvaluated& currentProperties,
               float currentZoom,
-              const std::string& layerID) {
+              std::size_t layerIndex) {
         typename AllUniforms::Values allUniformValues = uniformValues
             .concat(paintPropertyBinders.uniformValues(currentZoom, currentProperties));
 
@@ -67,12 +67,6 @@ public:
             .concat(paintPropertyBinders.attributeBindings(currentProperties));
 
         for (auto& segment : segments) {
-            auto vertexArrayIt = segment.vertexArrays.find(layerID);
-
-            if (vertexArrayIt == segment.vertexArrays.end()) {
-                vertexArrayIt = segment.vertexArrays.emplace(layerID, context.createVertexArray()).first;
-            }
-
             program.draw(
                 context,
                 std::move(drawMode),
@@ -80,7 +74,7 @@ public:
                 std::move(stencilMode),
                 std::move(colorMode),
                 allUniformValues,
-                vertexArrayIt->second,
+                segment.vertexArray(context, layerIndex),
                 Attributes::offsetBindings(allAttributeBindings, segment.vertexOffset),
                 indexBuffer,
                 segment.indexOffset,
@@ -7,7 +7,7 @@ namespace mbgl {
 
 ProgramParameters::ProgramParameters(const float pixelRatio,
                                      const bool overdraw,
-                                     optional<std::string> cacheDir_)
+                                     std::shared_ptr<BinaryProgramCache> cache_)
     : defines([&] {
           std::ostringstream ss;
           ss.imbue(std::locale("C"));
@@ -18,22 +18,22 @@ ProgramParameters::ProgramParameters(const float pixelRatio,
           }
           return ss.str();
       }()),
-      cacheDir(std::move(cacheDir_)) {
+      cache(std::move(cache_)) {
 }
 
 const std::string& ProgramParameters::getDefines() const {
     return defines;
 }
 
-optional<std::string> ProgramParameters::cachePath(const char* name) const {
-    if (!cacheDir) {
-        return {};
-    } else {
-        std::ostringstream ss;
-        ss << *cacheDir << "/com.mapbox.gl.shader." << name << "." << std::setfill('0')
-           << std::setw(sizeof(size_t) * 2) << std::hex << std::hash<std::string>()(defines) << ".pbf";
-        return ss.str();
-    }
+BinaryProgramCache* ProgramParameters::getCache() const {
+    return cache.get();
+}
+
+std::string ProgramParameters::cacheKey(const char* name) const {
+    std::ostringstream ss;
+    ss << name << "." << std::setfill('0') << std::setw(sizeof(size_t) * 2) << std::hex
+       << std::hash<std::string>()(defines);
+    return ss.str();
 }
 
 ProgramParameters ProgramParameters::withAdditionalDefines(const std::vector<std::string>& additionalDefines) const {
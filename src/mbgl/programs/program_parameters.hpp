@@ -1,24 +1,30 @@
 #pragma once
 
-#include <mbgl/util/optional.hpp>
-
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace mbgl {
 
+class BinaryProgramCache;
+
 class ProgramParameters {
 public:
-    ProgramParameters(float pixelRatio, bool overdraw, optional<std::string> cacheDir);
+    ProgramParameters(float pixelRatio, bool overdraw, std::shared_ptr<BinaryProgramCache> cache = {});
 
     const std::string& getDefines() const;
-    optional<std::string> cachePath(const char* name) const;
+
+    // Returns the cache for binary programs, or nullptr if programs shouldn't be cached.
+    BinaryProgramCache* getCache() const;
+
+    // Identifies the variant of the named program that is compiled with these parameters.
+    std::string cacheKey(const char* name) const;
 
     ProgramParameters withAdditionalDefines(const std::vector<std::string>& defines) const;
 
 private:
     std::string defines;
-    optional<std::string> cacheDir;
+    std::shared_ptr<BinaryProgramCache> cache;
 };
 
 } // namespace mbgl
@@ -39,6 +39,7 @@ public:
           line(context, programParameters),
           lineSDF(context, programParameters),
           linePattern(context, programParameters),
+          lineBatched(context, programParameters),
           raster(context, programParameters),
           symbolIcon(context, programParameters),
           symbolIconSDF(context, programParameters),
@@ -66,6 +67,7 @@ public:
     ProgramMap<LineProgram> line;
     ProgramMap<LineSDFProgram> lineSDF;
     ProgramMap<LinePatternProgram> linePattern;
+    ProgramMap<LineBatchedProgram> lineBatched;
     RasterProgram raster;
     ProgramMap<SymbolIconProgram> symbolIcon;
     ProgramMap<SymbolSDFIconProgram> symbolIconSDF;
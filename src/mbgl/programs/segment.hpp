@@ -2,13 +2,19 @@
 
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/vertex_array.hpp>
+#include <mbgl/util/optional.hpp>
 
 #include <cstddef>
 #include <vector>
-#include <map>
 
 namespace mbgl {
 
+// Segments cache vertex arrays by the index of the render layer drawing them (see
+// RenderLayer::getIndex()). Draws that don't belong to a style layer use these reserved indices.
+constexpr std::size_t ClippingVertexArrayIndex = 0;
+constexpr std::size_t DebugVertexArrayIndex = 1;
+constexpr std::size_t ReservedVertexArrayIndices = 2;
+
 template <class Attributes>
 class Segment {
 public:
@@ -27,14 +33,36 @@ public:
     std::size_t vertexLength;
     std::size_t indexLength;
 
-    // One VertexArray per layer ID. This minimizes rebinding in cases where
+    // Returns the vertex array for the layer with the given index, creating it if needed.
+    gl::VertexArray& vertexArray(gl::Context& context, std::size_t layerIndex) const {
+        if (vertexArraysGeneration != context.getSegmentVertexArrayGeneration()) {
+            vertexArrays.clear();
+            vertexArraysGeneration = context.getSegmentVertexArrayGeneration();
+        }
+        if (layerIndex >= vertexArrays.size()) {
+            vertexArrays.resize(layerIndex + 1);
+        }
+        auto& vertexArray_ = vertexArrays[layerIndex];
+        if (!vertexArray_) {
+            vertexArray_ = context.createVertexArray();
+        }
+        return *vertexArray_;
+    }
+
+    // One VertexArray per layer. This minimizes rebinding in cases where
     // several layers share buckets but have different sets of active attributes.
     // This can happen:
     //   * when two layers have the same layout properties, but differing
     //     data-driven paint properties
     //   * when two fill layers have the same layout properties, but one
     //     uses fill-color and the other uses fill-pattern
-    mutable std::map<std::string, gl::VertexArray> vertexArrays;
+    //
+    // Layer indices are small and reused after a layer is removed, so this stays as
+    // long as the number of layers in the style. The vertex arrays are released with the
+    // segment, or on the segment's next draw after a removed layer's index is given out
+    // again (see gl::Context::releaseSegmentVertexArrays()).
+    mutable std::vector<optional<gl::VertexArray>> vertexArrays;
+    mutable std::size_t vertexArraysGeneration = 0;
 };
 
 template <class Attributes>
@@ -13,6 +13,12 @@ class Context;
 
 class RenderLayer;
 
+namespace style {
+namespace expression {
+class FeatureBatch;
+} // namespace expression
+} // namespace style
+
 class Bucket : private util::noncopyable {
 public:
     Bucket() = default;
@@ -24,6 +30,11 @@ public:
     virtual void addFeature(const GeometryTileFeature&,
                             const GeometryCollection&) {};
 
+    // Called with the features that are about to be added, so that data-driven paint
+    // properties can be evaluated for all of them at once. Each feature of the batch
+    // must then be added exactly once, in batch order.
+    virtual void prepare(const style::expression::FeatureBatch&) {};
+
     // As long as this bucket has a Prepare render pass, this function is getting called. Typically,
     // this only happens once when the bucket is being rendered for the first time.
     virtual void upload(gl::Context&) = 0;
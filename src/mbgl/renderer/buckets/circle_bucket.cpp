@@ -37,6 +37,12 @@ bool CircleBucket::hasData() const {
     return !segments.empty();
 }
 
+void CircleBucket::prepare(const style::expression::FeatureBatch& batch) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.prepare(batch);
+    }
+}
+
 void CircleBucket::addFeature(const GeometryTileFeature& feature,
                               const GeometryCollection& geometry) {
     constexpr const uint16_t vertexLength = 4;
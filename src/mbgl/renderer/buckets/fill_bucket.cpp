@@ -38,6 +38,12 @@ FillBucket::FillBucket(const BucketParameters& parameters, const std::vector<con
     }
 }
 
+void FillBucket::prepare(const style::expression::FeatureBatch& batch) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.prepare(batch);
+    }
+}
+
 void FillBucket::addFeature(const GeometryTileFeature& feature,
                             const GeometryCollection& geometry) {
     for (auto& polygon : classifyRings(geometry)) {
@@ -44,6 +44,12 @@ FillExtrusionBucket::FillExtrusionBucket(const BucketParameters& parameters, con
     }
 }
 
+void FillExtrusionBucket::prepare(const style::expression::FeatureBatch& batch) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.prepare(batch);
+    }
+}
+
 void FillExtrusionBucket::addFeature(const GeometryTileFeature& feature,
                                      const GeometryCollection& geometry) {
     for (auto& polygon : classifyRings(geometry)) {
@@ -18,6 +18,7 @@ public:
 
     void addFeature(const GeometryTileFeature&,
                     const GeometryCollection&) override;
+    void prepare(const style::expression::FeatureBatch&) override;
     bool hasData() const override;
 
     void upload(gl::Context&) override;
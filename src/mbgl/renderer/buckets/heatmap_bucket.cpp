@@ -37,6 +37,12 @@ bool HeatmapBucket::hasData() const {
     return !segments.empty();
 }
 
+void HeatmapBucket::prepare(const style::expression::FeatureBatch& batch) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.prepare(batch);
+    }
+}
+
 void HeatmapBucket::addFeature(const GeometryTileFeature& feature,
                               const GeometryCollection& geometry) {
     constexpr const uint16_t vertexLength = 4;
@@ -27,6 +27,12 @@ LineBucket::LineBucket(const BucketParameters& parameters,
     }
 }
 
+void LineBucket::prepare(const style::expression::FeatureBatch& batch) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.prepare(batch);
+    }
+}
+
 void LineBucket::addFeature(const GeometryTileFeature& feature,
                             const GeometryCollection& geometryCollection) {
     for (auto& line : geometryCollection) {
@@ -451,8 +457,15 @@ void LineBucket::addPieSliceVertex(const GeometryCoordinate& currentVertex,
 }
 
 void LineBucket::upload(gl::Context& context) {
-    vertexBuffer = context.createVertexBuffer(std::move(vertices));
-    indexBuffer = context.createIndexBuffer(std::move(triangles));
+    // The vertices stay on the CPU until the bucket goes away, so small buckets hand them over
+    // to be merged with those of other tiles once they are uploaded.
+    vertexBuffer = context.createVertexBuffer(vertices);
+    indexBuffer = context.createIndexBuffer(triangles);
+
+    if (segments.size() == 1 && vertexBuffer->vertexCount <= LineBatchedProgram::maxTileVertices) {
+        batchGeometry = std::make_shared<LineBatchGeometry>(
+            LineBatchGeometry { std::move(vertices), std::move(triangles) });
+    }
 
     for (auto& pair : paintPropertyBinders) {
         pair.second.upload(context);
@@ -8,6 +8,7 @@
 #include <mbgl/programs/line_program.hpp>
 #include <mbgl/style/layers/line_layer_properties.hpp>
 
+#include <memory>
 #include <vector>
 
 namespace mbgl {
@@ -15,6 +16,14 @@ namespace mbgl {
 class BucketParameters;
 class RenderLineLayer;
 
+// The layout geometry of a bucket that is small enough to be drawn together with other tiles.
+// Shared, so that a batch can tell whether it still holds the geometry of the same buckets.
+class LineBatchGeometry {
+public:
+    gl::VertexVector<LineLayoutVertex> vertices;
+    gl::IndexVector<gl::Triangles> triangles;
+};
+
 class LineBucket : public Bucket {
 public:
     LineBucket(const BucketParameters&,
@@ -23,6 +32,7 @@ public:
 
     void addFeature(const GeometryTileFeature&,
                     const GeometryCollection&) override;
+    void prepare(const style::expression::FeatureBatch&) override;
     bool hasData() const override;
 
     void upload(gl::Context&) override;
@@ -38,6 +48,11 @@ public:
     optional<gl::VertexBuffer<LineLayoutVertex>> vertexBuffer;
     optional<gl::IndexBuffer<gl::Triangles>> indexBuffer;
 
+    // Set on upload when the bucket qualifies for LineBatchedProgram. It takes over `vertices` and
+    // `triangles`, which buckets keep after upload anyway, so it doesn't add to the bucket's memory.
+    // It holds at most LineBatchedProgram::maxTileVertices vertices.
+    std::shared_ptr<const LineBatchGeometry> batchGeometry;
+
     std::map<std::string, LineProgram::PaintPropertyBinders> paintPropertyBinders;
 
 private:
@@ -38,6 +38,19 @@ SymbolBucket::SymbolBucket(style::SymbolLayoutProperties::PossiblyEvaluated layo
     }
 }
 
+template <class Buffer>
+static void uploadOpacity(gl::Context& context, Buffer& buffer) {
+    if (!buffer.opacityVertexBuffer) {
+        // The vertices are kept, since later placements update them in place.
+        buffer.opacityVertexBuffer = context.createVertexBuffer(buffer.opacityVertices, gl::BufferUsage::StreamDraw);
+    } else {
+        for (const auto& change : buffer.opacityChanges) {
+            context.updateVertexBuffer(*buffer.opacityVertexBuffer, buffer.opacityVertices, change.first, change.second - change.first);
+        }
+    }
+    buffer.opacityChanges.clear();
+}
+
 void SymbolBucket::upload(gl::Context& context) {
     if (hasTextData()) {
         if (!staticUploaded) {
@@ -51,11 +64,7 @@ void SymbolBucket::upload(gl::Context& context) {
             text.dynamicVertexBuffer = context.createVertexBuffer(std::move(text.dynamicVertices), gl::BufferUsage::StreamDraw);
         }
         if (!placementChangesUploaded) {
-            if (!text.opacityVertexBuffer) {
-                text.opacityVertexBuffer = context.createVertexBuffer(std::move(text.opacityVertices), gl::BufferUsage::StreamDraw);
-            } else {
-                context.updateVertexBuffer(*text.opacityVertexBuffer, std::move(text.opacityVertices));
-            }
+            uploadOpacity(context, text);
         }
     }
 
@@ -70,11 +79,7 @@ void SymbolBucket::upload(gl::Context& context) {
             icon.dynamicVertexBuffer = context.createVertexBuffer(std::move(icon.dynamicVertices), gl::BufferUsage::StreamDraw);
         }
         if (!placementChangesUploaded) {
-            if (!icon.opacityVertexBuffer) {
-                icon.opacityVertexBuffer = context.createVertexBuffer(std::move(icon.opacityVertices), gl::BufferUsage::StreamDraw);
-            } else {
-                context.updateVertexBuffer(*icon.opacityVertexBuffer, std::move(icon.opacityVertices));
-            }
+            uploadOpacity(context, icon);
         }
     }
 
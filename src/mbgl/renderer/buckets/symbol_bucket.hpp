@@ -59,6 +59,27 @@ public:
     void updateOpacity();
     void sortFeatures(const float angle);
 
+    // Sets `count` opacity vertices of a text or icon buffer, starting at `first`. Opacity
+    // vertices are kept after they are uploaded, and only the vertices that changed are
+    // uploaded again.
+    template <class Buffer>
+    static void setOpacity(Buffer& buffer, std::size_t first, std::size_t count, SymbolOpacityAttributes::Vertex vertex) {
+        for (std::size_t i = first; i < first + count; i++) {
+            auto& existing = buffer.opacityVertices.at(i);
+            if (existing.a1 == vertex.a1) {
+                continue;
+            }
+            existing = vertex;
+            // Changes arrive in ascending order. Nearby runs are merged, since uploading a few
+            // unchanged bytes is cheaper than another buffer update.
+            if (!buffer.opacityChanges.empty() && i <= buffer.opacityChanges.back().second + 64) {
+                buffer.opacityChanges.back().second = i + 1;
+            } else {
+                buffer.opacityChanges.emplace_back(i, i + 1);
+            }
+        }
+    }
+
     const style::SymbolLayoutProperties::PossiblyEvaluated layout;
     const bool sdfIcons;
     const bool iconsNeedLinear;
@@ -83,6 +104,7 @@ public:
         gl::VertexVector<SymbolLayoutVertex> vertices;
         gl::VertexVector<SymbolDynamicLayoutAttributes::Vertex> dynamicVertices;
         gl::VertexVector<SymbolOpacityAttributes::Vertex> opacityVertices;
+        std::vector<std::pair<std::size_t, std::size_t>> opacityChanges;
         gl::IndexVector<gl::Triangles> triangles;
         SegmentVector<SymbolTextAttributes> segments;
         std::vector<PlacedSymbol> placedSymbols;
@@ -99,6 +121,7 @@ public:
         gl::VertexVector<SymbolLayoutVertex> vertices;
         gl::VertexVector<SymbolDynamicLayoutAttributes::Vertex> dynamicVertices;
         gl::VertexVector<SymbolOpacityAttributes::Vertex> opacityVertices;
+        std::vector<std::pair<std::size_t, std::size_t>> opacityChanges;
         gl::IndexVector<gl::Triangles> triangles;
         SegmentVector<SymbolIconAttributes> segments;
         std::vector<PlacedSymbol> placedSymbols;
@@ -82,7 +82,7 @@ void RenderBackgroundLayer::render(PaintParameters& parameters, RenderSource*) {
                 paintAttributeData,
                 properties,
                 parameters.state.getZoom(),
-                getID()
+                getIndex()
             );
         }
     } else {
@@ -104,7 +104,7 @@ void RenderBackgroundLayer::render(PaintParameters& parameters, RenderSource*) {
                 paintAttributeData,
                 properties,
                 parameters.state.getZoom(),
-                getID()
+                getIndex()
             );
         }
     }
@@ -47,6 +47,10 @@ bool RenderCircleLayer::hasTransition() const {
     return unevaluated.hasTransition();
 }
 
+void RenderCircleLayer::warmUpPrograms(Programs& programs) {
+    programs.circle.get(evaluated);
+}
+
 void RenderCircleLayer::render(PaintParameters& parameters, RenderSource*) {
     if (parameters.pass == RenderPass::Opaque) {
         return;
@@ -88,7 +92,7 @@ void RenderCircleLayer::render(PaintParameters& parameters, RenderSource*) {
             bucket.paintPropertyBinders.at(getID()),
             evaluated,
             parameters.state.getZoom(),
-            getID()
+            getIndex()
         );
     }
 }
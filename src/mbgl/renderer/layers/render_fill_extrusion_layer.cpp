@@ -46,6 +46,14 @@ bool RenderFillExtrusionLayer::hasTransition() const {
     return unevaluated.hasTransition();
 }
 
+void RenderFillExtrusionLayer::warmUpPrograms(Programs& programs) {
+    if (evaluated.get<FillExtrusionPattern>().from.empty()) {
+        programs.fillExtrusion.get(evaluated);
+    } else {
+        programs.fillExtrusionPattern.get(evaluated);
+    }
+}
+
 void RenderFillExtrusionLayer::render(PaintParameters& parameters, RenderSource*) {
     if (parameters.pass == RenderPass::Opaque) {
         return;
@@ -85,7 +93,7 @@ void RenderFillExtrusionLayer::render(PaintParameters& parameters, RenderSource*
                         parameters.state, parameters.evaluatedLight),
                     *bucket.vertexBuffer, *bucket.indexBuffer, bucket.triangleSegments,
                     bucket.paintPropertyBinders.at(getID()), evaluated, parameters.state.getZoom(),
-                    getID());
+                    getIndex());
             }
         } else {
             optional<ImagePosition> imagePosA =
@@ -118,7 +126,7 @@ void RenderFillExtrusionLayer::render(PaintParameters& parameters, RenderSource*
                         parameters.evaluatedLight),
                     *bucket.vertexBuffer, *bucket.indexBuffer, bucket.triangleSegments,
                     bucket.paintPropertyBinders.at(getID()), evaluated, parameters.state.getZoom(),
-                    getID());
+                    getIndex());
             }
         }
 
@@ -143,7 +151,7 @@ void RenderFillExtrusionLayer::render(PaintParameters& parameters, RenderSource*
             parameters.staticData.quadTriangleIndexBuffer,
             parameters.staticData.extrusionTextureSegments,
             ExtrusionTextureProgram::PaintPropertyBinders{ properties, 0 }, properties,
-            parameters.state.getZoom(), getID());
+            parameters.state.getZoom(), getIndex());
     }
 }
 
@@ -17,6 +17,7 @@ public:
     void evaluate(const PropertyEvaluationParameters&) override;
     bool hasTransition() const override;
     void render(PaintParameters&, RenderSource*) override;
+    void warmUpPrograms(Programs&) override;
 
     bool queryIntersectsFeature(
         const GeometryCoordinates&,
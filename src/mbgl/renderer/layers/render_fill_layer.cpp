@@ -58,6 +58,20 @@ bool RenderFillLayer::hasTransition() const {
     return unevaluated.hasTransition();
 }
 
+void RenderFillLayer::warmUpPrograms(Programs& programs) {
+    if (evaluated.get<FillPattern>().from.empty()) {
+        programs.fill.get(evaluated);
+        if (evaluated.get<FillAntialias>()) {
+            programs.fillOutline.get(evaluated);
+        }
+    } else {
+        programs.fillPattern.get(evaluated);
+        if (evaluated.get<FillAntialias>() && unevaluated.get<FillOutlineColor>().isUndefined()) {
+            programs.fillOutlinePattern.get(evaluated);
+        }
+    }
+}
+
 void RenderFillLayer::render(PaintParameters& parameters, RenderSource*) {
     if (evaluated.get<FillPattern>().from.empty()) {
         for (const RenderTile& tile : renderTiles) {
@@ -89,7 +103,7 @@ void RenderFillLayer::render(PaintParameters& parameters, RenderSource*) {
                     bucket.paintPropertyBinders.at(getID()),
                     evaluated,
                     parameters.state.getZoom(),
-                    getID()
+                    getIndex()
                 );
             };
 
@@ -163,7 +177,7 @@ void RenderFillLayer::render(PaintParameters& parameters, RenderSource*) {
                     bucket.paintPropertyBinders.at(getID()),
                     evaluated,
                     parameters.state.getZoom(),
-                    getID()
+                    getIndex()
                 );
             };
 
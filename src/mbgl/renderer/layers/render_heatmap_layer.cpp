@@ -45,6 +45,10 @@ bool RenderHeatmapLayer::hasTransition() const {
     return unevaluated.hasTransition();
 }
 
+void RenderHeatmapLayer::warmUpPrograms(Programs& programs) {
+    programs.heatmap.get(evaluated);
+}
+
 void RenderHeatmapLayer::render(PaintParameters& parameters, RenderSource*) {
     if (parameters.pass == RenderPass::Opaque) {
         return;
@@ -109,7 +113,7 @@ void RenderHeatmapLayer::render(PaintParameters& parameters, RenderSource*) {
                 bucket.paintPropertyBinders.at(getID()),
                 evaluated,
                 parameters.state.getZoom(),
-                getID()
+                getIndex()
             );
         }
 
@@ -136,7 +140,7 @@ void RenderHeatmapLayer::render(PaintParameters& parameters, RenderSource*) {
             parameters.staticData.quadTriangleIndexBuffer,
             parameters.staticData.extrusionTextureSegments,
             HeatmapTextureProgram::PaintPropertyBinders{ properties, 0 }, properties,
-            parameters.state.getZoom(), getID());
+            parameters.state.getZoom(), getIndex());
     }
 }
 
@@ -90,7 +90,7 @@ void RenderHillshadeLayer::render(PaintParameters& parameters, RenderSource* src
             HillshadeProgram::PaintPropertyBinders { evaluated, 0 },
             evaluated,
             parameters.state.getZoom(),
-            getID()
+            getIndex()
         );
     };
 
@@ -132,7 +132,7 @@ void RenderHillshadeLayer::render(PaintParameters& parameters, RenderSource* src
                 HillshadePrepareProgram::PaintPropertyBinders { properties, 0 },
                 properties,
                 parameters.state.getZoom(),
-                getID()
+                getIndex()
             );
             bucket.texture = std::move(view.getTexture());
             bucket.setPrepared(true);
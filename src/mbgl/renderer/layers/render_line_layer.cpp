@@ -1,6 +1,7 @@
 #include <mbgl/renderer/layers/render_line_layer.hpp>
 #include <mbgl/renderer/buckets/line_bucket.hpp>
 #include <mbgl/renderer/render_tile.hpp>
+#include <mbgl/renderer/render_source.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/programs/programs.hpp>
@@ -12,15 +13,78 @@
 #include <mbgl/util/math.hpp>
 #include <mbgl/util/intersection_tests.hpp>
 
+#include <algorithm>
+#include <limits>
+
 namespace mbgl {
 
 using namespace style;
 
+// The geometry of the tiles drawn with LineBatchedProgram, merged into shared buffers. Each draw
+// covers up to LineBatchedProgram::maxTiles tiles with a single segment.
+class RenderLineLayer::Batches {
+public:
+    class Draw {
+    public:
+        Draw(std::size_t vertexOffset, std::size_t indexOffset) {
+            segments.emplace_back(vertexOffset, indexOffset);
+        }
+
+        std::size_t tileCount = 0;
+        SegmentVector<LineBatchedAttributes> segments;
+    };
+
+    Batches(gl::Context& context, std::vector<std::shared_ptr<const LineBatchGeometry>> geometry_)
+        : geometry(std::move(geometry_)) {
+        gl::VertexVector<LineBatchedLayoutVertex> vertices;
+        gl::IndexVector<gl::Triangles> triangles;
+
+        for (const auto& tileGeometry : geometry) {
+            const auto& tileVertices = tileGeometry->vertices.vector();
+            const auto& tileIndices = tileGeometry->triangles.vector();
+
+            if (draws.empty() || draws.back().tileCount == LineBatchedProgram::maxTiles ||
+                draws.back().segments.front().vertexLength + tileVertices.size() > std::numeric_limits<uint16_t>::max()) {
+                draws.emplace_back(vertices.vertexSize(), triangles.indexSize());
+            }
+
+            Draw& draw = draws.back();
+            auto& segment = draw.segments.front();
+            const auto tile = static_cast<uint8_t>(draw.tileCount++);
+            const auto base = static_cast<uint16_t>(segment.vertexLength);
+
+            for (const auto& vertex : tileVertices) {
+                vertices.emplace_back(LineBatchedProgram::layoutVertex(vertex, tile));
+            }
+            for (std::size_t i = 0; i + 2 < tileIndices.size(); i += 3) {
+                triangles.emplace_back(static_cast<uint16_t>(base + tileIndices[i]),
+                                       static_cast<uint16_t>(base + tileIndices[i + 1]),
+                                       static_cast<uint16_t>(base + tileIndices[i + 2]));
+            }
+
+            segment.vertexLength += tileVertices.size();
+            segment.indexLength += tileIndices.size();
+        }
+
+        vertexBuffer = context.createVertexBuffer(std::move(vertices));
+        indexBuffer = context.createIndexBuffer(std::move(triangles));
+    }
+
+    // One entry per tile, in the order of the draws.
+    const std::vector<std::shared_ptr<const LineBatchGeometry>> geometry;
+
+    std::vector<Draw> draws;
+    optional<gl::VertexBuffer<LineBatchedLayoutVertex>> vertexBuffer;
+    optional<gl::IndexBuffer<gl::Triangles>> indexBuffer;
+};
+
 RenderLineLayer::RenderLineLayer(Immutable<style::LineLayer::Impl> _impl)
     : RenderLayer(style::LayerType::Line, _impl),
       unevaluated(impl().paint.untransitioned()) {
 }
 
+RenderLineLayer::~RenderLineLayer() = default;
+
 const style::LineLayer::Impl& RenderLineLayer::impl() const {
     return static_cast<const style::LineLayer::Impl&>(*baseImpl);
 }
@@ -52,14 +116,86 @@ bool RenderLineLayer::hasTransition() const {
     return unevaluated.hasTransition();
 }
 
-void RenderLineLayer::render(PaintParameters& parameters, RenderSource*) {
+void RenderLineLayer::warmUpPrograms(Programs& programs) {
+    if (!evaluated.get<LineDasharray>().from.empty()) {
+        programs.lineSDF.get(evaluated);
+    } else if (!evaluated.get<LinePattern>().from.empty()) {
+        programs.linePattern.get(evaluated);
+    } else {
+        programs.line.get(evaluated);
+        if (LineProgram::PaintPropertyBinders::constants(evaluated).all()) {
+            programs.lineBatched.get(evaluated);
+        }
+    }
+}
+
+void RenderLineLayer::render(PaintParameters& parameters, RenderSource* src) {
     if (parameters.pass == RenderPass::Opaque) {
         return;
     }
 
-    for (const RenderTile& tile : renderTiles) {
+    // Look up atlas positions and bind atlases once per layer instead of once per tile. Dash
+    // positions depend on the line cap, which is part of each bucket's layout.
+    const bool dashed = !evaluated.get<LineDasharray>().from.empty();
+    optional<std::pair<LinePatternPos, LinePatternPos>> dashPositions[2];
+    auto getDashPositions = [&] (const LineBucket& bucket) -> const std::pair<LinePatternPos, LinePatternPos>& {
+        const LinePatternCap cap = bucket.layout.get<LineCap>() == LineCapType::Round
+            ? LinePatternCap::Round : LinePatternCap::Square;
+        auto& positions = dashPositions[cap == LinePatternCap::Round];
+        if (!positions) {
+            positions = std::make_pair(parameters.lineAtlas.getDashPosition(evaluated.get<LineDasharray>().from, cap),
+                                       parameters.lineAtlas.getDashPosition(evaluated.get<LineDasharray>().to, cap));
+            // Uploads the atlas if the lookup added dashes to it.
+            parameters.lineAtlas.bind(parameters.context, 0);
+        }
+        return *positions;
+    };
+
+    const bool patterned = !dashed && !evaluated.get<LinePattern>().from.empty();
+    optional<ImagePosition> patternPosA;
+    optional<ImagePosition> patternPosB;
+    if (patterned) {
+        patternPosA = parameters.imageManager.getPattern(evaluated.get<LinePattern>().from);
+        patternPosB = parameters.imageManager.getPattern(evaluated.get<LinePattern>().to);
+
+        if (!patternPosA || !patternPosB)
+            return;
+
+        parameters.imageManager.bind(parameters.context, 0);
+    }
+
+    auto getBucket = [&] (const RenderTile& tile) -> LineBucket& {
         assert(dynamic_cast<LineBucket*>(tile.tile.getBucket(*baseImpl)));
-        LineBucket& bucket = *reinterpret_cast<LineBucket*>(tile.tile.getBucket(*baseImpl));
+        return *reinterpret_cast<LineBucket*>(tile.tile.getBucket(*baseImpl));
+    };
+
+    // Tiles of a single zoom level don't overlap. When no paint property varies by feature, the
+    // small ones among them are drawn together, and clipped by the shader instead of the stencil
+    // buffer. The shader clips to the whole tile, which is what the stencil clip covers unless the
+    // source has other tiles within the tile, or the lines are translated away from the tile.
+    std::vector<std::reference_wrapper<const RenderTile>> batchedTiles;
+    if (src && !dashed && !patterned && LineProgram::PaintPropertyBinders::constants(evaluated).all() &&
+        evaluated.get<LineTranslate>() == std::array<float, 2> {{ 0, 0 }} &&
+        std::all_of(renderTiles.begin(), renderTiles.end(), [&] (const RenderTile& tile) {
+            return tile.tile.id.overscaledZ == renderTiles.front().get().tile.id.overscaledZ;
+        })) {
+        const auto sourceTiles = src->getRenderTiles();
+        for (const RenderTile& tile : renderTiles) {
+            if (getBucket(tile).batchGeometry &&
+                std::none_of(sourceTiles.begin(), sourceTiles.end(), [&] (const RenderTile& other) {
+                    return other.id.isChildOf(tile.id);
+                })) {
+                batchedTiles.push_back(tile);
+            }
+        }
+    }
+    const bool batched = batchedTiles.size() > 1;
+
+    for (const RenderTile& tile : renderTiles) {
+        LineBucket& bucket = getBucket(tile);
+        if (batched && bucket.batchGeometry) {
+            continue;
+        }
 
         auto draw = [&] (auto& program, auto&& uniformValues) {
             program.get(evaluated).draw(
@@ -75,17 +211,12 @@ void RenderLineLayer::render(PaintParameters& parameters, RenderSource*) {
                 bucket.paintPropertyBinders.at(getID()),
                 evaluated,
                 parameters.state.getZoom(),
-                getID()
+                getIndex()
             );
         };
 
-        if (!evaluated.get<LineDasharray>().from.empty()) {
-            const LinePatternCap cap = bucket.layout.get<LineCap>() == LineCapType::Round
-                ? LinePatternCap::Round : LinePatternCap::Square;
-            LinePatternPos posA = parameters.lineAtlas.getDashPosition(evaluated.get<LineDasharray>().from, cap);
-            LinePatternPos posB = parameters.lineAtlas.getDashPosition(evaluated.get<LineDasharray>().to, cap);
-
-            parameters.lineAtlas.bind(parameters.context, 0);
+        if (dashed) {
+            const auto& positions = getDashPositions(bucket);
 
             draw(parameters.programs.lineSDF,
                  LineSDFProgram::uniformValues(
@@ -94,19 +225,11 @@ void RenderLineLayer::render(PaintParameters& parameters, RenderSource*) {
                      tile,
                      parameters.state,
                      parameters.pixelsToGLUnits,
-                     posA,
-                     posB,
+                     positions.first,
+                     positions.second,
                      parameters.lineAtlas.getSize().width));
 
-        } else if (!evaluated.get<LinePattern>().from.empty()) {
-            optional<ImagePosition> posA = parameters.imageManager.getPattern(evaluated.get<LinePattern>().from);
-            optional<ImagePosition> posB = parameters.imageManager.getPattern(evaluated.get<LinePattern>().to);
-
-            if (!posA || !posB)
-                return;
-
-            parameters.imageManager.bind(parameters.context, 0);
-
+        } else if (patterned) {
             draw(parameters.programs.linePattern,
                  LinePatternProgram::uniformValues(
                      evaluated,
@@ -114,8 +237,8 @@ void RenderLineLayer::render(PaintParameters& parameters, RenderSource*) {
                      parameters.state,
                      parameters.pixelsToGLUnits,
                      parameters.imageManager.getPixelSize(),
-                     *posA,
-                     *posB));
+                     *patternPosA,
+                     *patternPosB));
 
         } else {
             draw(parameters.programs.line,
@@ -126,6 +249,48 @@ void RenderLineLayer::render(PaintParameters& parameters, RenderSource*) {
                      parameters.pixelsToGLUnits));
         }
     }
+
+    if (!batched) {
+        batches.reset();
+        return;
+    }
+
+    std::vector<std::shared_ptr<const LineBatchGeometry>> geometry;
+    for (const RenderTile& tile : batchedTiles) {
+        geometry.push_back(getBucket(tile).batchGeometry);
+    }
+    if (!batches || batches->geometry != geometry) {
+        batches = std::make_unique<Batches>(parameters.context, std::move(geometry));
+    }
+
+    auto& program = parameters.programs.lineBatched.get(evaluated);
+    const auto& paintPropertyBinders = getBucket(batchedTiles.front()).paintPropertyBinders.at(getID());
+
+    auto firstTile = batchedTiles.begin();
+    for (const auto& draw : batches->draws) {
+        const std::vector<std::reference_wrapper<const RenderTile>> tiles(firstTile, firstTile + draw.tileCount);
+        firstTile += draw.tileCount;
+
+        program.draw(
+            parameters.context,
+            gl::Triangles(),
+            parameters.depthModeForSublayer(0, gl::DepthMode::ReadOnly),
+            gl::StencilMode::disabled(),
+            parameters.colorModeForRenderPass(),
+            LineBatchedProgram::uniformValues(
+                evaluated,
+                tiles,
+                parameters.state,
+                parameters.pixelsToGLUnits),
+            *batches->vertexBuffer,
+            *batches->indexBuffer,
+            draw.segments,
+            paintPropertyBinders,
+            evaluated,
+            parameters.state.getZoom(),
+            getIndex()
+        );
+    }
 }
 
 optional<GeometryCollection> offsetLine(const GeometryCollection& rings, const double offset) {
@@ -18,12 +18,13 @@ class RenderLinePaintProperties : public style::ConcatenateProperties<
 class RenderLineLayer: public RenderLayer {
 public:
     RenderLineLayer(Immutable<style::LineLayer::Impl>);
-    ~RenderLineLayer() final = default;
+    ~RenderLineLayer() final;
 
     void transition(const TransitionParameters&) override;
     void evaluate(const PropertyEvaluationParameters&) override;
     bool hasTransition() const override;
     void render(PaintParameters&, RenderSource*) override;
+    void warmUpPrograms(Programs&) override;
 
     bool queryIntersectsFeature(
             const GeometryCoordinates&,
@@ -43,6 +44,10 @@ public:
 
 private:
     float getLineWidth(const GeometryTileFeature&, const float) const;
+
+    // Geometry of the tiles drawn with LineBatchedProgram, kept across frames.
+    class Batches;
+    std::unique_ptr<Batches> batches;
 };
 
 template <>
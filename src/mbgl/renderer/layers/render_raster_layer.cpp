@@ -104,7 +104,7 @@ void RenderRasterLayer::render(PaintParameters& parameters, RenderSource* source
             RasterProgram::PaintPropertyBinders { evaluated, 0 },
             evaluated,
             parameters.state.getZoom(),
-            getID()
+            getIndex()
         );
     };
 
@@ -69,6 +69,17 @@ bool RenderSymbolLayer::hasTransition() const {
     return unevaluated.hasTransition();
 }
 
+void RenderSymbolLayer::warmUpPrograms(Programs& programs) {
+    // Whether icons are drawn as SDFs is only known once the bucket is built, so only the
+    // plain icon program is compiled ahead of time.
+    if (!impl().layout.get<IconImage>().isUndefined()) {
+        programs.symbolIcon.get(iconPaintProperties());
+    }
+    if (!impl().layout.get<TextField>().isUndefined()) {
+        programs.symbolGlyph.get(textPaintProperties());
+    }
+}
+
 void RenderSymbolLayer::render(PaintParameters& parameters, RenderSource*) {
     if (parameters.pass == RenderPass::Opaque) {
         return;
@@ -106,7 +117,7 @@ void RenderSymbolLayer::render(PaintParameters& parameters, RenderSource*) {
                 binders,
                 paintProperties,
                 parameters.state.getZoom(),
-                getID()
+                getIndex()
             );
         };
 
@@ -120,16 +131,11 @@ void RenderSymbolLayer::render(PaintParameters& parameters, RenderSource*) {
             const bool alongLine = layout.get<SymbolPlacement>() == SymbolPlacementType::Line &&
                 layout.get<IconRotationAlignment>() == AlignmentType::Map;
 
-            if (alongLine) {
-                reprojectLineLabels(bucket.icon.dynamicVertices,
-                                    bucket.icon.placedSymbols,
-                                    tile.matrix,
-                                    values,
-                                    tile,
-                                    *bucket.iconSizeBinder,
-                                    parameters.state);
-
+            // Projected by projectLineLabels(). Clearing the vertices once they're uploaded makes
+            // other layers that share the bucket skip the upload for the rest of the frame.
+            if (alongLine && !bucket.icon.dynamicVertices.empty()) {
                 parameters.context.updateVertexBuffer(*bucket.icon.dynamicVertexBuffer, std::move(bucket.icon.dynamicVertices));
+                bucket.icon.dynamicVertices.clear();
             }
 
             const bool iconScaled = layout.get<IconSize>().constantOr(1.0) != 1.0 || bucket.iconsNeedLinear;
@@ -181,16 +187,9 @@ void RenderSymbolLayer::render(PaintParameters& parameters, RenderSource*) {
             const bool alongLine = layout.get<SymbolPlacement>() == SymbolPlacementType::Line &&
                 layout.get<TextRotationAlignment>() == AlignmentType::Map;
 
-            if (alongLine) {
-                reprojectLineLabels(bucket.text.dynamicVertices,
-                                    bucket.text.placedSymbols,
-                                    tile.matrix,
-                                    values,
-                                    tile,
-                                    *bucket.textSizeBinder,
-                                    parameters.state);
-
+            if (alongLine && !bucket.text.dynamicVertices.empty()) {
                 parameters.context.updateVertexBuffer(*bucket.text.dynamicVertexBuffer, std::move(bucket.text.dynamicVertices));
+                bucket.text.dynamicVertices.clear();
             }
 
             const Size texsize = geometryTile.glyphAtlasTexture->size;
@@ -246,7 +245,7 @@ void RenderSymbolLayer::render(PaintParameters& parameters, RenderSource*) {
                 paintAttributeData,
                 properties,
                 parameters.state.getZoom(),
-                getID()
+                getIndex()
             );
         }
         if (bucket.hasCollisionCircleData()) {
@@ -281,13 +280,43 @@ void RenderSymbolLayer::render(PaintParameters& parameters, RenderSource*) {
                 paintAttributeData,
                 properties,
                 parameters.state.getZoom(),
-                getID()
+                getIndex()
             );
 
         }
     }
 }
 
+void RenderSymbolLayer::projectLineLabels(const RenderTile& tile, const TransformState& state) const {
+    assert(dynamic_cast<SymbolBucket*>(tile.tile.getBucket(*baseImpl)));
+    SymbolBucket& bucket = *reinterpret_cast<SymbolBucket*>(tile.tile.getBucket(*baseImpl));
+
+    const auto& layout = bucket.layout;
+    if (layout.get<SymbolPlacement>() != SymbolPlacementType::Line) {
+        return;
+    }
+
+    if (bucket.hasIconData() && layout.get<IconRotationAlignment>() == AlignmentType::Map) {
+        reprojectLineLabels(bucket.icon.dynamicVertices,
+                            bucket.icon.placedSymbols,
+                            tile.matrix,
+                            iconPropertyValues(layout),
+                            tile,
+                            *bucket.iconSizeBinder,
+                            state);
+    }
+
+    if (bucket.hasTextData() && layout.get<TextRotationAlignment>() == AlignmentType::Map) {
+        reprojectLineLabels(bucket.text.dynamicVertices,
+                            bucket.text.placedSymbols,
+                            tile.matrix,
+                            textPropertyValues(layout),
+                            tile,
+                            *bucket.textSizeBinder,
+                            state);
+    }
+}
+
 style::IconPaintProperties::PossiblyEvaluated RenderSymbolLayer::iconPaintProperties() const {
     return style::IconPaintProperties::PossiblyEvaluated {
             evaluated.get<style::IconOpacity>(),
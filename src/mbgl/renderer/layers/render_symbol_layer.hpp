@@ -67,6 +67,12 @@ public:
     void evaluate(const PropertyEvaluationParameters&) override;
     bool hasTransition() const override;
     void render(PaintParameters&, RenderSource*) override;
+    void warmUpPrograms(Programs&) override;
+
+    // Projects the glyphs of the tile's along-line labels for the current frame into the
+    // bucket's dynamic vertices, which render() uploads. Touches only the tile's bucket, so
+    // tiles with distinct buckets can be projected on several threads at once.
+    void projectLineLabels(const RenderTile&, const TransformState&) const;
 
     style::IconPaintProperties::PossiblyEvaluated iconPaintProperties() const;
     style::TextPaintProperties::PossiblyEvaluated textPaintProperties() const;
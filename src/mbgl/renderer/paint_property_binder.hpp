@@ -49,6 +49,36 @@ std::array<float, N*2> zoomInterpolatedAttributeValue(const std::array<float, N>
     return result;
 }
 
+/*
+   Values of a data-driven property evaluated ahead of time for a batch of features.
+   Buckets populate vertex vectors once for each feature they add, so the value for a
+   feature is the one at the feature's position in the batch.
+*/
+template <class T>
+class BatchValues {
+public:
+    void assign(std::vector<T> values_) {
+        values = std::move(values_);
+        next = 0;
+    }
+
+    optional<T> take() {
+        if (next < values.size()) {
+            return std::move(values[next++]);
+        }
+        return {};
+    }
+
+    void clear() {
+        values.clear();
+        next = 0;
+    }
+
+private:
+    std::vector<T> values;
+    std::size_t next = 0;
+};
+
 /*
    PaintPropertyBinder is an abstract class serving as the interface definition for
    the strategy used for constructing, uploading, and binding paint property data as
@@ -80,6 +110,9 @@ public:
 
     virtual ~PaintPropertyBinder() = default;
 
+    // Evaluates the property for all features of the batch up front. The next calls to
+    // populateVertexVector() must be for the features of the batch, in batch order.
+    virtual void prepare(const style::expression::FeatureBatch&) {}
     virtual void populateVertexVector(const GeometryTileFeature& feature, std::size_t length) = 0;
     virtual void upload(gl::Context& context) = 0;
     virtual optional<AttributeBinding> attributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const = 0;
@@ -135,8 +168,13 @@ public:
           defaultValue(std::move(defaultValue_)) {
     }
 
+    void prepare(const style::expression::FeatureBatch& batch) override {
+        batchValues.assign(function.evaluate(batch, defaultValue));
+    }
+
     void populateVertexVector(const GeometryTileFeature& feature, std::size_t length) override {
-        auto evaluated = function.evaluate(feature, defaultValue);
+        optional<T> prepared = batchValues.take();
+        auto evaluated = prepared ? std::move(*prepared) : function.evaluate(feature, defaultValue);
         this->statistics.add(evaluated);
         auto value = attributeValue(evaluated);
         for (std::size_t i = vertexVector.vertexSize(); i < length; ++i) {
@@ -145,6 +183,7 @@ public:
     }
 
     void upload(gl::Context& context) override {
+        batchValues.clear();
         vertexBuffer = context.createVertexBuffer(std::move(vertexVector));
     }
 
@@ -172,6 +211,7 @@ public:
 private:
     style::SourceFunction<T> function;
     T defaultValue;
+    BatchValues<T> batchValues;
     gl::VertexVector<BaseVertex> vertexVector;
     optional<gl::VertexBuffer<BaseVertex>> vertexBuffer;
 };
@@ -193,8 +233,13 @@ public:
           zoomRange({zoom, zoom + 1}) {
     }
 
+    void prepare(const style::expression::FeatureBatch& batch) override {
+        batchValues.assign(function.evaluate(zoomRange, batch, defaultValue));
+    }
+
     void populateVertexVector(const GeometryTileFeature& feature, std::size_t length) override {
-        Range<T> range = function.evaluate(zoomRange, feature, defaultValue);
+        optional<Range<T>> prepared = batchValues.take();
+        Range<T> range = prepared ? std::move(*prepared) : function.evaluate(zoomRange, feature, defaultValue);
         this->statistics.add(range.min);
         this->statistics.add(range.max);
         AttributeValue value = zoomInterpolatedAttributeValue(
@@ -206,6 +251,7 @@ public:
     }
 
     void upload(gl::Context& context) override {
+        batchValues.clear();
         vertexBuffer = context.createVertexBuffer(std::move(vertexVector));
     }
 
@@ -238,6 +284,7 @@ private:
     style::CompositeFunction<T> function;
     T defaultValue;
     Range<float> zoomRange;
+    BatchValues<Range<T>> batchValues;
     gl::VertexVector<Vertex> vertexVector;
     optional<gl::VertexBuffer<Vertex>> vertexBuffer;
 };
@@ -294,6 +341,12 @@ public:
     PaintPropertyBinders(PaintPropertyBinders&&) = default;
     PaintPropertyBinders(const PaintPropertyBinders&) = delete;
 
+    void prepare(const style::expression::FeatureBatch& batch) {
+        util::ignore({
+            (binders.template get<Ps>()->prepare(batch), 0)...
+        });
+    }
+
     void populateVertexVectors(const GeometryTileFeature& feature, std::size_t length) {
         util::ignore({
             (binders.template get<Ps>()->populateVertexVector(feature, length), 0)...
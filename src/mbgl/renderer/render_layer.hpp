@@ -16,6 +16,7 @@ class BucketParameters;
 class TransitionParameters;
 class PropertyEvaluationParameters;
 class PaintParameters;
+class Programs;
 class RenderSource;
 class RenderTile;
 class TransformState;
@@ -57,6 +58,11 @@ public:
 
     const std::string& getID() const;
 
+    // Small index that identifies this layer for as long as it is part of the style. It is
+    // assigned by the renderer and reused for another layer once this one is removed.
+    std::size_t getIndex() const { return index; }
+    void setIndex(std::size_t index_) { index = index_; }
+
     // Checks whether this layer needs to be rendered in the given render pass.
     bool hasRenderPass(RenderPass) const;
 
@@ -65,6 +71,11 @@ public:
 
     virtual void render(PaintParameters&, RenderSource*) = 0;
 
+    // Compile the program variants that rendering this layer with its currently evaluated
+    // paint properties requires, so that the first frame drawing it does not stall on
+    // shader compilation. Layers drawn with fixed programs don't need to override this.
+    virtual void warmUpPrograms(Programs&) {}
+
     // Check wether the given geometry intersects
     // with the feature
     virtual bool queryIntersectsFeature(
@@ -78,6 +89,7 @@ public:
     virtual std::unique_ptr<Bucket> createBucket(const BucketParameters&, const std::vector<const RenderLayer*>&) const = 0;
 
     void setRenderTiles(std::vector<std::reference_wrapper<RenderTile>>);
+    const std::vector<std::reference_wrapper<RenderTile>>& getRenderTiles() const { return renderTiles; }
     // Private implementation
     Immutable<style::Layer::Impl> baseImpl;
     void setImpl(Immutable<style::Layer::Impl>);
@@ -95,6 +107,9 @@ protected:
     // Stores what render passes this layer is currently enabled for. This depends on the
     // evaluated StyleProperties object and is updated accordingly.
     RenderPass passes = RenderPass::None;
+
+private:
+    std::size_t index = 0;
 };
 
 } // namespace mbgl
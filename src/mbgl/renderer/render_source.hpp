@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/renderer/query.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/tile/tile_observer.hpp>
 #include <mbgl/util/mat4.hpp>
@@ -8,6 +9,7 @@
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/layer_impl.hpp>
 
+#include <functional>
 #include <unordered_map>
 #include <vector>
 #include <map>
@@ -25,6 +27,7 @@ class Tile;
 class RenderSourceObserver;
 class TileParameters;
 class CollisionIndex;
+class Scheduler;
 
 class RenderSource : protected TileObserver {
 public:
@@ -48,6 +51,9 @@ public:
     bool isEnabled() const;
     virtual bool isLoaded() const = 0;
 
+    // The number of tiles that are still being loaded or parsed.
+    virtual std::size_t getPendingTileCount() const = 0;
+
     virtual void update(Immutable<style::Source::Impl>,
                         const std::vector<Immutable<style::Layer::Impl>>&,
                         bool needsRendering,
@@ -60,15 +66,16 @@ public:
     // Returns an unsorted list of RenderTiles.
     virtual std::vector<std::reference_wrapper<RenderTile>> getRenderTiles() = 0;
 
-    virtual std::unordered_map<std::string, std::vector<Feature>>
+    virtual std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>
     queryRenderedFeatures(const ScreenLineString& geometry,
                           const TransformState& transformState,
                           const std::vector<const RenderLayer*>& layers,
                           const RenderedQueryOptions& options,
-                          const mat4& projMatrix) const = 0;
+                          const mat4& projMatrix,
+                          Scheduler& scheduler) const = 0;
 
-    virtual std::vector<Feature>
-    querySourceFeatures(const SourceQueryOptions&) const = 0;
+    virtual void querySourceFeatures(const std::function<void (Feature&&)>& callback,
+                                     const SourceQueryOptions&) const = 0;
 
     virtual void reduceMemoryUse() = 0;
 
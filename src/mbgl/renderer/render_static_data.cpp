@@ -53,9 +53,13 @@ RenderStaticData::RenderStaticData(gl::Context& context, float pixelRatio, const
       extrusionTextureVertexBuffer(context.createVertexBuffer(extrusionTextureVertices())),
       quadTriangleIndexBuffer(context.createIndexBuffer(quadTriangleIndices())),
       tileBorderIndexBuffer(context.createIndexBuffer(tileLineStripIndices())),
-      programs(context, ProgramParameters { pixelRatio, false, programCacheDir })
+      programCache(programCacheDir
+          ? std::make_shared<BinaryProgramCache>(*programCacheDir + "/com.mapbox.gl.shaders.pbf",
+                                                 context.getRendererIdentifier())
+          : nullptr),
+      programs(context, ProgramParameters { pixelRatio, false, programCache })
 #ifndef NDEBUG
-    , overdrawPrograms(context, ProgramParameters { pixelRatio, true, programCacheDir })
+    , overdrawPrograms(context, ProgramParameters { pixelRatio, true, programCache })
 #endif
 {
     tileTriangleSegments.emplace_back(0, 0, 4, 6);
@@ -3,8 +3,10 @@
 #include <mbgl/gl/vertex_buffer.hpp>
 #include <mbgl/gl/index_buffer.hpp>
 #include <mbgl/programs/programs.hpp>
+#include <mbgl/programs/binary_program_cache.hpp>
 #include <mbgl/util/optional.hpp>
 
+#include <memory>
 #include <string>
 
 namespace mbgl {
@@ -29,6 +31,8 @@ public:
     bool has3D = false;
     Size backendSize;
 
+    // Declared before the programs, which share it.
+    std::shared_ptr<BinaryProgramCache> programCache;
     Programs programs;
 
 #ifndef NDEBUG
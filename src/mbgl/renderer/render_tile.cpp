@@ -101,7 +101,7 @@ void RenderTile::finishRender(PaintParameters& parameters) {
             paintAttributeData,
             properties,
             parameters.state.getZoom(),
-            "debug"
+            DebugVertexArrayIndex
         );
 
         parameters.programs.debug.draw(
@@ -120,7 +120,7 @@ void RenderTile::finishRender(PaintParameters& parameters) {
             paintAttributeData,
             properties,
             parameters.state.getZoom(),
-            "debug"
+            DebugVertexArrayIndex
         );
     }
 
@@ -141,7 +141,7 @@ void RenderTile::finishRender(PaintParameters& parameters) {
             paintAttributeData,
             properties,
             parameters.state.getZoom(),
-            "debug"
+            DebugVertexArrayIndex
         );
     }
 }
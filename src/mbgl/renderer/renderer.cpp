@@ -54,9 +54,36 @@ std::vector<Feature> Renderer::queryRenderedFeatures(const ScreenBox& box, const
     );
 }
 
+std::vector<RenderedFeatureHandle> Renderer::queryRenderedFeatureHandles(const ScreenLineString& geometry, const RenderedQueryOptions& options) const {
+    return impl->queryRenderedFeatureHandles(geometry, options);
+}
+
+std::vector<RenderedFeatureHandle> Renderer::queryRenderedFeatureHandles(const ScreenCoordinate& point, const RenderedQueryOptions& options) const {
+    return impl->queryRenderedFeatureHandles({ point }, options);
+}
+
+std::vector<RenderedFeatureHandle> Renderer::queryRenderedFeatureHandles(const ScreenBox& box, const RenderedQueryOptions& options) const {
+    return impl->queryRenderedFeatureHandles(
+            {
+                    box.min,
+                    {box.max.x, box.min.y},
+                    box.max,
+                    {box.min.x, box.max.y},
+                    box.min
+            },
+            options
+    );
+}
+
+std::vector<Feature> Renderer::getFeatures(const std::vector<RenderedFeatureHandle>& handles, const RenderedQueryOptions& options) const {
+    return impl->getFeatures(handles, options);
+}
+
 AnnotationIDs Renderer::queryPointAnnotations(const ScreenBox& box) const {
     RenderedQueryOptions options;
     options.layerIDs = {{ AnnotationManager::PointLayerID }};
+    options.properties = std::vector<std::string>();
+    options.geometry = false;
     auto features = queryRenderedFeatures(box, options);
     return getAnnotationIDs(features);
 }
@@ -90,6 +117,11 @@ std::vector<Feature> Renderer::querySourceFeatures(const std::string& sourceID,
     return impl->querySourceFeatures(sourceID, options);
 }
 
+void Renderer::querySourceFeatures(const std::string& sourceID, const SourceQueryOptions& options,
+                                   const std::function<void (Feature&&)>& callback) const {
+    impl->querySourceFeatures(sourceID, options, callback);
+}
+
 void Renderer::dumpDebugLogs() {
     impl->dumDebugLogs();
 }
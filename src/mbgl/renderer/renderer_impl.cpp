@@ -16,19 +16,25 @@
 #include <mbgl/renderer/layers/render_fill_extrusion_layer.hpp>
 #include <mbgl/renderer/layers/render_heatmap_layer.hpp>
 #include <mbgl/renderer/layers/render_hillshade_layer.hpp>
+#include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/renderer/style_diff.hpp>
 #include <mbgl/renderer/query.hpp>
 #include <mbgl/renderer/backend_scope.hpp>
 #include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/programs/segment.hpp>
 #include <mbgl/gl/debugging.hpp>
+#include <mbgl/geometry/feature_index.hpp>
 #include <mbgl/geometry/line_atlas.hpp>
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/text/glyph_manager.hpp>
 #include <mbgl/tile/tile.hpp>
+#include <mbgl/util/chrono.hpp>
 #include <mbgl/util/math.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/parallel_for.hpp>
+#include <mbgl/util/trace.hpp>
 
 namespace mbgl {
 
@@ -59,6 +65,7 @@ Renderer::Impl::Impl(RendererBackend& backend_,
     , imageImpls(makeMutable<std::vector<Immutable<style::Image::Impl>>>())
     , sourceImpls(makeMutable<std::vector<Immutable<style::Source::Impl>>>())
     , layerImpls(makeMutable<std::vector<Immutable<style::Layer::Impl>>>())
+    , nextLayerIndex(ReservedVertexArrayIndices)
     , renderLight(makeMutable<Light::Impl>())
     , placement(std::make_unique<Placement>(TransformState{}, MapMode::Static)) {
     glyphManager->setObserver(this);
@@ -84,6 +91,8 @@ void Renderer::Impl::setObserver(RendererObserver* observer_) {
 }
 
 void Renderer::Impl::render(const UpdateParameters& updateParameters) {
+    MBGL_TRACE(Event::Render, "Renderer::Impl::render");
+
     if (updateParameters.mode != MapMode::Continuous) {
         // Reset zoom history state.
         zoomHistory.first = true;
@@ -116,7 +125,8 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
         updateParameters.annotationManager,
         *imageManager,
         *glyphManager,
-        updateParameters.prefetchZoomDelta
+        updateParameters.prefetchZoomDelta,
+        updateParameters.prefetchStates
     };
 
     glyphManager->setURL(updateParameters.glyphURL);
@@ -160,12 +170,24 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
 
     // Remove render layers for removed layers.
     for (const auto& entry : layerDiff.removed) {
-        renderLayers.erase(entry.first);
+        auto it = renderLayers.find(entry.first);
+        unusedLayerIndices.push_back(it->second->getIndex());
+        renderLayers.erase(it);
+    }
+    if (!layerDiff.removed.empty()) {
+        backend.getContext().releaseSegmentVertexArrays();
     }
 
     // Create render layers for newly added layers.
     for (const auto& entry : layerDiff.added) {
-        renderLayers.emplace(entry.first, RenderLayer::create(entry.second));
+        std::unique_ptr<RenderLayer> renderLayer = RenderLayer::create(entry.second);
+        if (unusedLayerIndices.empty()) {
+            renderLayer->setIndex(nextLayerIndex++);
+        } else {
+            renderLayer->setIndex(unusedLayerIndices.back());
+            unusedLayerIndices.pop_back();
+        }
+        renderLayers.emplace(entry.first, std::move(renderLayer));
     }
 
     // Update render layers for changed layers.
@@ -190,6 +212,17 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
         if (layerAdded || layerChanged || zoomChanged || layer.hasTransition()) {
             layer.evaluate(evaluationParameters);
         }
+
+        // Layers visible at the current zoom level are drawn first, so compile their programs first.
+        // A layer that is already queued is warmed up with its properties at that time, so it
+        // isn't queued again.
+        if ((layerAdded || layerChanged) && queuedProgramWarmUps.insert(entry.first).second) {
+            if (layer.needsRendering(zoomHistory.lastZoom)) {
+                pendingProgramWarmUps.push_front(entry.first);
+            } else {
+                pendingProgramWarmUps.push_back(entry.first);
+            }
+        }
     }
 
 
@@ -247,6 +280,8 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
         staticData = std::make_unique<RenderStaticData>(backend.getContext(), pixelRatio, programCacheDir);
     }
 
+    warmUpPrograms();
+
     PaintParameters parameters {
         backend.getContext(),
         pixelRatio,
@@ -270,6 +305,16 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
 
     observer->onWillStartRenderingFrame();
 
+    const TimePoint renderStart = Clock::now();
+    // The counters start out as the totals of the context, and become the differences when the
+    // frame is finished.
+    RenderingStats stats;
+    stats.drawCalls = parameters.context.drawCalls;
+    stats.programSwitches = parameters.context.programSwitches;
+    stats.textureBinds = parameters.context.textureBinds;
+    stats.uploadedVertexBytes = parameters.context.uploadedVertexBytes;
+    stats.uploadedIndexBytes = parameters.context.uploadedIndexBytes;
+
     backend.updateAssumedState();
 
     if (parameters.contextMode == GLContextMode::Shared) {
@@ -386,6 +431,9 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
 
     bool placementChanged = false;
     if (!placement->stillRecent(parameters.timePoint)) {
+        MBGL_TRACE(Event::Render, "placement");
+        const TimePoint placementStart = Clock::now();
+
         auto newPlacement = std::make_unique<Placement>(parameters.state, parameters.mapMode);
         std::set<std::string> usedSymbolLayers;
         for (auto it = order.rbegin(); it != order.rend(); ++it) {
@@ -395,6 +443,9 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
             }
         }
 
+        stats.placedSymbols = newPlacement->getPlacedSymbolCount();
+        stats.collidedSymbols = newPlacement->getCollidedSymbolCount();
+
         placementChanged = newPlacement->commit(*placement, parameters.timePoint);
         crossTileSymbolIndex.pruneUnusedLayers(usedSymbolLayers);
         if (placementChanged || symbolBucketsChanged) {
@@ -404,6 +455,8 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
         placement->setRecent(parameters.timePoint);
         
         updateFadingTiles();
+
+        stats.placementTime = Clock::now() - placementStart;
     } else {
         placement->setStale();
     }
@@ -422,6 +475,7 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
     // Uploads all required buffers and images before we do any actual rendering.
     {
         MBGL_DEBUG_GROUP(parameters.context, "upload");
+        MBGL_TRACE(Event::Render, "upload");
 
         parameters.imageManager.upload(parameters.context, 0);
         parameters.lineAtlas.upload(parameters.context, 0);
@@ -434,6 +488,32 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
         }
     }
 
+    // - LABEL PROJECTION ----------------------------------------------------------------------------
+    // Projects along-line labels onto the screen for this frame, once per bucket. Buckets are
+    // independent, so this runs on the worker threads; the results are uploaded when the layers
+    // are rendered.
+    {
+        MBGL_TRACE(Event::Render, "label projection");
+
+        std::vector<std::pair<const RenderSymbolLayer*, std::reference_wrapper<const RenderTile>>> labelTiles;
+        std::unordered_set<const Bucket*> labelBuckets;
+        for (const auto& item : order) {
+            const RenderSymbolLayer* symbolLayer = item.layer.as<RenderSymbolLayer>();
+            if (!symbolLayer || !symbolLayer->hasRenderPass(RenderPass::Translucent)) {
+                continue;
+            }
+            for (const RenderTile& tile : symbolLayer->getRenderTiles()) {
+                if (labelBuckets.insert(tile.tile.getBucket(*symbolLayer->baseImpl)).second) {
+                    labelTiles.emplace_back(symbolLayer, tile);
+                }
+            }
+        }
+
+        util::parallelFor(scheduler, labelTiles.size(), [&](std::size_t i) {
+            labelTiles[i].first->projectLineLabels(labelTiles[i].second, parameters.state);
+        });
+    }
+
     // - 3D PASS -------------------------------------------------------------------------------------
     // Renders any 3D layers bottom-to-top to unique FBOs with texture attachments, but share the same
     // depth rbo between them.
@@ -441,6 +521,7 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
         parameters.staticData.backendSize = parameters.backend.getFramebufferSize();
 
         MBGL_DEBUG_GROUP(parameters.context, "3d");
+        MBGL_TRACE(Event::Render, "3d");
         parameters.pass = RenderPass::Pass3D;
 
         if (!parameters.staticData.depthRenderbuffer ||
@@ -455,6 +536,7 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
             parameters.currentLayer = i;
             if (it->layer.hasRenderPass(parameters.pass)) {
                 MBGL_DEBUG_GROUP(parameters.context, it->layer.getID());
+                MBGL_TRACE_DETAIL(Event::Render, "RenderLayer::render", it->layer.getID());
                 it->layer.render(parameters, it->source);
             }
         }
@@ -508,7 +590,7 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
                 paintAttributeData,
                 properties,
                 parameters.state.getZoom(),
-                "clipping"
+                ClippingVertexArrayIndex
             );
         }
     }
@@ -553,12 +635,14 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
     {
         parameters.pass = RenderPass::Opaque;
         MBGL_DEBUG_GROUP(parameters.context, "opaque");
+        MBGL_TRACE(Event::Render, "opaque");
 
         uint32_t i = 0;
         for (auto it = order.rbegin(); it != order.rend(); ++it, ++i) {
             parameters.currentLayer = i;
             if (it->layer.hasRenderPass(parameters.pass)) {
                 MBGL_DEBUG_GROUP(parameters.context, it->layer.getID());
+                MBGL_TRACE_DETAIL(Event::Render, "RenderLayer::render", it->layer.getID());
                 it->layer.render(parameters, it->source);
             }
         }
@@ -569,12 +653,14 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
     {
         parameters.pass = RenderPass::Translucent;
         MBGL_DEBUG_GROUP(parameters.context, "translucent");
+        MBGL_TRACE(Event::Render, "translucent");
 
         uint32_t i = static_cast<uint32_t>(order.size()) - 1;
         for (auto it = order.begin(); it != order.end(); ++it, --i) {
             parameters.currentLayer = i;
             if (it->layer.hasRenderPass(parameters.pass)) {
                 MBGL_DEBUG_GROUP(parameters.context, it->layer.getID());
+                MBGL_TRACE_DETAIL(Event::Render, "RenderLayer::render", it->layer.getID());
                 it->layer.render(parameters, it->source);
             }
         }
@@ -632,6 +718,22 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
         parameters.context.bindVertexArray = 0;
     }
 
+    stats.drawCalls = parameters.context.drawCalls - stats.drawCalls;
+    stats.programSwitches = parameters.context.programSwitches - stats.programSwitches;
+    stats.textureBinds = parameters.context.textureBinds - stats.textureBinds;
+    stats.uploadedVertexBytes = parameters.context.uploadedVertexBytes - stats.uploadedVertexBytes;
+    stats.uploadedIndexBytes = parameters.context.uploadedIndexBytes - stats.uploadedIndexBytes;
+    for (const auto& entry : renderSources) {
+        if (entry.second->isEnabled()) {
+            stats.renderedTiles += entry.second->getRenderTiles().size();
+            stats.pendingTiles += entry.second->getPendingTileCount();
+        }
+    }
+    stats.bufferMemory = parameters.context.getBufferMemory();
+    stats.textureMemory = parameters.context.getTextureMemory();
+    stats.renderTime = Clock::now() - renderStart;
+    observer->onRenderingStats(stats);
+
     observer->onDidFinishRenderingFrame(
         loaded ? RendererObserver::RenderMode::Full : RendererObserver::RenderMode::Partial,
         updateParameters.mode == MapMode::Continuous && hasTransitions(parameters.timePoint)
@@ -649,6 +751,10 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
 }
 
 std::vector<Feature> Renderer::Impl::queryRenderedFeatures(const ScreenLineString& geometry, const RenderedQueryOptions& options) const {
+    return getFeatures(queryRenderedFeatureHandles(geometry, options), options);
+}
+
+std::vector<RenderedFeatureHandle> Renderer::Impl::queryRenderedFeatureHandles(const ScreenLineString& geometry, const RenderedQueryOptions& options) const {
     std::vector<const RenderLayer*> layers;
     if (options.layerIDs) {
         for (const auto& layerID : *options.layerIDs) {
@@ -662,10 +768,38 @@ std::vector<Feature> Renderer::Impl::queryRenderedFeatures(const ScreenLineStrin
         }
     }
 
-    return queryRenderedFeatures(geometry, options, layers);
+    return queryRenderedFeatureHandles(geometry, options, layers);
+}
+
+std::vector<Feature> Renderer::Impl::getFeatures(const std::vector<RenderedFeatureHandle>& handles, const RenderedQueryOptions& options) const {
+    // Features are converted from their tile's data, which is parsed lazily and can't be read
+    // from multiple threads at once. Convert the features of each tile on a single thread.
+    std::vector<std::vector<std::size_t>> tiles;
+    std::unordered_map<const FeatureIndex*, std::size_t> tileIndices;
+    for (std::size_t i = 0; i < handles.size(); i++) {
+        auto it = tileIndices.emplace(handles[i].index.get(), tiles.size()).first;
+        if (it->second == tiles.size()) {
+            tiles.emplace_back();
+        }
+        tiles[it->second].push_back(i);
+    }
+
+    std::vector<optional<Feature>> features(handles.size());
+    util::parallelFor(scheduler, tiles.size(), [&](std::size_t tile) {
+        for (std::size_t i : tiles[tile]) {
+            features[i] = handles[i].index->getFeature(handles[i], options);
+        }
+    });
+
+    std::vector<Feature> result;
+    result.reserve(features.size());
+    for (auto& feature : features) {
+        result.push_back(std::move(*feature));
+    }
+    return result;
 }
     
-void Renderer::Impl::queryRenderedSymbols(std::unordered_map<std::string, std::vector<Feature>>& resultsByLayer,
+void Renderer::Impl::queryRenderedSymbols(std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>& resultsByLayer,
                                           const ScreenLineString& geometry,
                                           const std::vector<const RenderLayer*>& layers,
                                           const RenderedQueryOptions& options) const {
@@ -698,26 +832,34 @@ void Renderer::Impl::queryRenderedSymbols(std::unordered_map<std::string, std::v
     }
 }
 
-std::vector<Feature> Renderer::Impl::queryRenderedFeatures(const ScreenLineString& geometry, const RenderedQueryOptions& options, const std::vector<const RenderLayer*>& layers) const {
+std::vector<RenderedFeatureHandle> Renderer::Impl::queryRenderedFeatureHandles(const ScreenLineString& geometry, const RenderedQueryOptions& options, const std::vector<const RenderLayer*>& layers) const {
+    std::vector<const RenderSource*> sources;
     std::unordered_set<std::string> sourceIDs;
     for (const RenderLayer* layer : layers) {
-        sourceIDs.emplace(layer->baseImpl->source);
+        if (sourceIDs.emplace(layer->baseImpl->source).second) {
+            if (const RenderSource* renderSource = getRenderSource(layer->baseImpl->source)) {
+                sources.push_back(renderSource);
+            }
+        }
     }
 
     mat4 projMatrix;
     transformState.getProjMatrix(projMatrix);
 
-    std::unordered_map<std::string, std::vector<Feature>> resultsByLayer;
-    for (const auto& sourceID : sourceIDs) {
-        if (RenderSource* renderSource = getRenderSource(sourceID)) {
-            auto sourceResults = renderSource->queryRenderedFeatures(geometry, transformState, layers, options, projMatrix);
-            std::move(sourceResults.begin(), sourceResults.end(), std::inserter(resultsByLayer, resultsByLayer.begin()));
-        }
+    // Sources query their tiles in parallel as well.
+    std::vector<std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>> sourceResults(sources.size());
+    util::parallelFor(scheduler, sources.size(), [&](std::size_t i) {
+        sourceResults[i] = sources[i]->queryRenderedFeatures(geometry, transformState, layers, options, projMatrix, scheduler);
+    });
+
+    std::unordered_map<std::string, std::vector<RenderedFeatureHandle>> resultsByLayer;
+    for (auto& sourceResult : sourceResults) {
+        std::move(sourceResult.begin(), sourceResult.end(), std::inserter(resultsByLayer, resultsByLayer.begin()));
     }
     
     queryRenderedSymbols(resultsByLayer, geometry, layers, options);
 
-    std::vector<Feature> result;
+    std::vector<RenderedFeatureHandle> result;
 
     if (resultsByLayer.empty()) {
         return result;
@@ -741,6 +883,9 @@ std::vector<Feature> Renderer::Impl::queryRenderedFeatures(const ScreenLineStrin
 std::vector<Feature> Renderer::Impl::queryShapeAnnotations(const ScreenLineString& geometry) const {
     std::vector<const RenderLayer*> shapeAnnotationLayers;
     RenderedQueryOptions options;
+    // Only the annotation IDs are needed.
+    options.properties = std::vector<std::string>();
+    options.geometry = false;
     for (const auto& layerImpl : *layerImpls) {
         if (std::mismatch(layerImpl->id.begin(), layerImpl->id.end(),
                           AnnotationManager::ShapeLayerID.begin(), AnnotationManager::ShapeLayerID.end()).second == AnnotationManager::ShapeLayerID.end()) {
@@ -750,14 +895,23 @@ std::vector<Feature> Renderer::Impl::queryShapeAnnotations(const ScreenLineStrin
         }
     }
 
-    return queryRenderedFeatures(geometry, options, shapeAnnotationLayers);
+    return getFeatures(queryRenderedFeatureHandles(geometry, options, shapeAnnotationLayers), options);
 }
 
 std::vector<Feature> Renderer::Impl::querySourceFeatures(const std::string& sourceID, const SourceQueryOptions& options) const {
+    std::vector<Feature> result;
+    querySourceFeatures(sourceID, options, [&](Feature&& feature) {
+        result.push_back(std::move(feature));
+    });
+    return result;
+}
+
+void Renderer::Impl::querySourceFeatures(const std::string& sourceID, const SourceQueryOptions& options,
+                                         const std::function<void (Feature&&)>& callback) const {
     const RenderSource* source = getRenderSource(sourceID);
-    if (!source) return {};
+    if (!source) return;
 
-    return source->querySourceFeatures(options);
+    source->querySourceFeatures(callback, options);
 }
 
 void Renderer::Impl::reduceMemoryUse() {
@@ -814,6 +968,27 @@ bool Renderer::Impl::hasTransitions(TimePoint timePoint) const {
     return false;
 }
 
+void Renderer::Impl::warmUpPrograms() {
+    // Compile programs for layers that were added or changed within a small per-frame budget,
+    // instead of stalling on all of them in the frame whose tiles first draw those layers. This
+    // also runs while a still image is waiting for resources to load. Programs already present in
+    // the binary program cache are loaded from it rather than compiled.
+    static constexpr Duration budget = Milliseconds(4);
+    const TimePoint deadline = Clock::now() + budget;
+
+    while (!pendingProgramWarmUps.empty()) {
+        if (RenderLayer* layer = getRenderLayer(pendingProgramWarmUps.front())) {
+            layer->warmUpPrograms(staticData->programs);
+        }
+        queuedProgramWarmUps.erase(pendingProgramWarmUps.front());
+        pendingProgramWarmUps.pop_front();
+
+        if (Clock::now() >= deadline) {
+            break;
+        }
+    }
+}
+
 void Renderer::Impl::updateFadingTiles() {
     fadingTiles = false;
     for (auto& source : renderSources) {
@@ -13,8 +13,10 @@
 #include <mbgl/text/glyph_manager_observer.hpp>
 #include <mbgl/text/placement.hpp>
 
+#include <deque>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace mbgl {
@@ -50,7 +52,10 @@ public:
     void render(const UpdateParameters&);
 
     std::vector<Feature> queryRenderedFeatures(const ScreenLineString&, const RenderedQueryOptions&) const;
+    std::vector<RenderedFeatureHandle> queryRenderedFeatureHandles(const ScreenLineString&, const RenderedQueryOptions&) const;
+    std::vector<Feature> getFeatures(const std::vector<RenderedFeatureHandle>&, const RenderedQueryOptions&) const;
     std::vector<Feature> querySourceFeatures(const std::string& sourceID, const SourceQueryOptions&) const;
+    void querySourceFeatures(const std::string& sourceID, const SourceQueryOptions&, const std::function<void (Feature&&)>&) const;
     std::vector<Feature> queryShapeAnnotations(const ScreenLineString&) const;
 
     void reduceMemoryUse();
@@ -65,12 +70,12 @@ private:
           RenderLayer* getRenderLayer(const std::string& id);
     const RenderLayer* getRenderLayer(const std::string& id) const;
               
-    void queryRenderedSymbols(std::unordered_map<std::string, std::vector<Feature>>& resultsByLayer,
+    void queryRenderedSymbols(std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>& resultsByLayer,
                               const ScreenLineString& geometry,
                               const std::vector<const RenderLayer*>& layers,
                               const RenderedQueryOptions& options) const;
     
-    std::vector<Feature> queryRenderedFeatures(const ScreenLineString&, const RenderedQueryOptions&, const std::vector<const RenderLayer*>&) const;
+    std::vector<RenderedFeatureHandle> queryRenderedFeatureHandles(const ScreenLineString&, const RenderedQueryOptions&, const std::vector<const RenderLayer*>&) const;
 
     // GlyphManagerObserver implementation.
     void onGlyphsError(const FontStack&, const GlyphRange&, std::exception_ptr) override;
@@ -80,6 +85,7 @@ private:
     void onTileError(RenderSource&, const OverscaledTileID&, std::exception_ptr) override;
 
     void updateFadingTiles();
+    void warmUpPrograms();
 
     friend class Renderer;
 
@@ -114,8 +120,16 @@ private:
 
     std::unordered_map<std::string, std::unique_ptr<RenderSource>> renderSources;
     std::unordered_map<std::string, std::unique_ptr<RenderLayer>> renderLayers;
+
+    // Indices of removed layers, handed out again to layers added later.
+    std::vector<std::size_t> unusedLayerIndices;
+    std::size_t nextLayerIndex;
     RenderLight renderLight;
 
+    // IDs of added or changed layers whose program variants haven't been compiled yet.
+    std::deque<std::string> pendingProgramWarmUps;
+    std::unordered_set<std::string> queuedProgramWarmUps;
+
     CrossTileSymbolIndex crossTileSymbolIndex;
     std::unique_ptr<Placement> placement;
 
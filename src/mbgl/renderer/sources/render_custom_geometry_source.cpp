@@ -23,6 +23,10 @@ bool RenderCustomGeometrySource::isLoaded() const {
     return tilePyramid.isLoaded();
 }
 
+std::size_t RenderCustomGeometrySource::getPendingTileCount() const {
+    return tilePyramid.getPendingTileCount();
+}
+
 void RenderCustomGeometrySource::update(Immutable<style::Source::Impl> baseImpl_,
                                  const std::vector<Immutable<Layer::Impl>>& layers,
                                  const bool needsRendering,
@@ -46,7 +50,7 @@ void RenderCustomGeometrySource::update(Immutable<style::Source::Impl> baseImpl_
                        impl().getZoomRange(),
                        {},
                        [&] (const OverscaledTileID& tileID) {
-                           return std::make_unique<CustomGeometryTile>(tileID, impl().id, parameters, impl().getTileOptions(), *tileLoader);
+                           return std::make_unique<CustomGeometryTile>(tileID, impl().id, parameters, *tileLoader);
                        });
 }
 
@@ -63,17 +67,19 @@ std::vector<std::reference_wrapper<RenderTile>> RenderCustomGeometrySource::getR
     return tilePyramid.getRenderTiles();
 }
 
-std::unordered_map<std::string, std::vector<Feature>>
+std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>
 RenderCustomGeometrySource::queryRenderedFeatures(const ScreenLineString& geometry,
                                            const TransformState& transformState,
                                            const std::vector<const RenderLayer*>& layers,
                                            const RenderedQueryOptions& options,
-                                           const mat4& projMatrix) const {
-   return tilePyramid.queryRenderedFeatures(geometry, transformState, layers, options, projMatrix);
+                                           const mat4& projMatrix,
+                                           Scheduler& scheduler) const {
+   return tilePyramid.queryRenderedFeatures(geometry, transformState, layers, options, projMatrix, scheduler);
 }
 
-std::vector<Feature> RenderCustomGeometrySource::querySourceFeatures(const SourceQueryOptions& options) const {
-    return tilePyramid.querySourceFeatures(options);
+void RenderCustomGeometrySource::querySourceFeatures(const std::function<void (Feature&&)>& callback,
+                                                     const SourceQueryOptions& options) const {
+    tilePyramid.querySourceFeatures(callback, options);
 }
 
 void RenderCustomGeometrySource::reduceMemoryUse() {
@@ -24,6 +24,10 @@ bool RenderGeoJSONSource::isLoaded() const {
     return tilePyramid.isLoaded();
 }
 
+std::size_t RenderGeoJSONSource::getPendingTileCount() const {
+    return tilePyramid.getPendingTileCount();
+}
+
 void RenderGeoJSONSource::update(Immutable<style::Source::Impl> baseImpl_,
                                  const std::vector<Immutable<Layer::Impl>>& layers,
                                  const bool needsRendering,
@@ -81,17 +85,19 @@ std::vector<std::reference_wrapper<RenderTile>> RenderGeoJSONSource::getRenderTi
     return tilePyramid.getRenderTiles();
 }
 
-std::unordered_map<std::string, std::vector<Feature>>
+std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>
 RenderGeoJSONSource::queryRenderedFeatures(const ScreenLineString& geometry,
                                            const TransformState& transformState,
                                            const std::vector<const RenderLayer*>& layers,
                                            const RenderedQueryOptions& options,
-                                           const mat4& projMatrix) const {
-    return tilePyramid.queryRenderedFeatures(geometry, transformState, layers, options, projMatrix);
+                                           const mat4& projMatrix,
+                                           Scheduler& scheduler) const {
+    return tilePyramid.queryRenderedFeatures(geometry, transformState, layers, options, projMatrix, scheduler);
 }
 
-std::vector<Feature> RenderGeoJSONSource::querySourceFeatures(const SourceQueryOptions& options) const {
-    return tilePyramid.querySourceFeatures(options);
+void RenderGeoJSONSource::querySourceFeatures(const std::function<void (Feature&&)>& callback,
+                                              const SourceQueryOptions& options) const {
+    tilePyramid.querySourceFeatures(callback, options);
 }
 
 void RenderGeoJSONSource::reduceMemoryUse() {
@@ -15,6 +15,7 @@ public:
     RenderGeoJSONSource(Immutable<style::GeoJSONSource::Impl>);
 
     bool isLoaded() const final;
+    std::size_t getPendingTileCount() const final;
 
     void update(Immutable<style::Source::Impl>,
                 const std::vector<Immutable<style::Layer::Impl>>&,
@@ -27,15 +28,16 @@ public:
 
     std::vector<std::reference_wrapper<RenderTile>> getRenderTiles() final;
 
-    std::unordered_map<std::string, std::vector<Feature>>
+    std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>
     queryRenderedFeatures(const ScreenLineString& geometry,
                           const TransformState& transformState,
                           const std::vector<const RenderLayer*>& layers,
                           const RenderedQueryOptions& options,
-                          const mat4& projMatrix) const final;
+                          const mat4& projMatrix,
+                          Scheduler& scheduler) const final;
 
-    std::vector<Feature>
-    querySourceFeatures(const SourceQueryOptions&) const final;
+    void querySourceFeatures(const std::function<void (Feature&&)>& callback,
+                             const SourceQueryOptions&) const final;
 
     void reduceMemoryUse() final;
     void dumpDebugLogs() const final;
@@ -30,6 +30,10 @@ bool RenderImageSource::isLoaded() const {
     return !!bucket;
 }
 
+std::size_t RenderImageSource::getPendingTileCount() const {
+    return 0;
+}
+
 void RenderImageSource::startRender(PaintParameters& parameters) {
     if (!isLoaded()) {
         return;
@@ -75,22 +79,23 @@ void RenderImageSource::finishRender(PaintParameters& parameters) {
             paintAttributeData,
             properties,
             parameters.state.getZoom(),
-            "debug"
+            DebugVertexArrayIndex
         );
     }
 }
 
-std::unordered_map<std::string, std::vector<Feature>>
+std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>
 RenderImageSource::queryRenderedFeatures(const ScreenLineString&,
                                          const TransformState&,
                                          const std::vector<const RenderLayer*>&,
                                          const RenderedQueryOptions&,
-                                         const mat4&) const {
-    return std::unordered_map<std::string, std::vector<Feature>> {};
+                                         const mat4&,
+                                         Scheduler&) const {
+    return std::unordered_map<std::string, std::vector<RenderedFeatureHandle>> {};
 }
 
-std::vector<Feature> RenderImageSource::querySourceFeatures(const SourceQueryOptions&) const {
-    return {};
+void RenderImageSource::querySourceFeatures(const std::function<void (Feature&&)>&,
+                                            const SourceQueryOptions&) const {
 }
 
 void RenderImageSource::update(Immutable<style::Source::Impl> baseImpl_,
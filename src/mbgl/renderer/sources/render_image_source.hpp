@@ -14,6 +14,7 @@ public:
     ~RenderImageSource() override;
 
     bool isLoaded() const final;
+    std::size_t getPendingTileCount() const final;
 
     void startRender(PaintParameters&) final;
     void finishRender(PaintParameters&) final;
@@ -28,14 +29,16 @@ public:
         return {};
     }
 
-    std::unordered_map<std::string, std::vector<Feature>>
+    std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>
     queryRenderedFeatures(const ScreenLineString& geometry,
                           const TransformState& transformState,
                           const std::vector<const RenderLayer*>& layers,
                           const RenderedQueryOptions& options,
-                          const mat4& projMatrix) const final;
+                          const mat4& projMatrix,
+                          Scheduler& scheduler) const final;
 
-    std::vector<Feature> querySourceFeatures(const SourceQueryOptions&) const final;
+    void querySourceFeatures(const std::function<void (Feature&&)>& callback,
+                             const SourceQueryOptions&) const final;
 
     void reduceMemoryUse() final {
     }
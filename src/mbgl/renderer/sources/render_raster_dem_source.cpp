@@ -23,6 +23,10 @@ bool RenderRasterDEMSource::isLoaded() const {
     return tilePyramid.isLoaded();
 }
 
+std::size_t RenderRasterDEMSource::getPendingTileCount() const {
+    return tilePyramid.getPendingTileCount();
+}
+
 void RenderRasterDEMSource::update(Immutable<style::Source::Impl> baseImpl_,
                                 const std::vector<Immutable<Layer::Impl>>& layers,
                                 const bool needsRendering,
@@ -142,17 +146,18 @@ std::vector<std::reference_wrapper<RenderTile>> RenderRasterDEMSource::getRender
     return tilePyramid.getRenderTiles();
 }
 
-std::unordered_map<std::string, std::vector<Feature>>
+std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>
 RenderRasterDEMSource::queryRenderedFeatures(const ScreenLineString&,
                                           const TransformState&,
                                           const std::vector<const RenderLayer*>&,
                                           const RenderedQueryOptions&,
-                                          const mat4&) const {
-    return std::unordered_map<std::string, std::vector<Feature>> {};
+                                          const mat4&,
+                                          Scheduler&) const {
+    return std::unordered_map<std::string, std::vector<RenderedFeatureHandle>> {};
 }
 
-std::vector<Feature> RenderRasterDEMSource::querySourceFeatures(const SourceQueryOptions&) const {
-    return {};
+void RenderRasterDEMSource::querySourceFeatures(const std::function<void (Feature&&)>&,
+                                                const SourceQueryOptions&) const {
 }
 
 void RenderRasterDEMSource::reduceMemoryUse() {
@@ -20,6 +20,10 @@ bool RenderRasterSource::isLoaded() const {
     return tilePyramid.isLoaded();
 }
 
+std::size_t RenderRasterSource::getPendingTileCount() const {
+    return tilePyramid.getPendingTileCount();
+}
+
 void RenderRasterSource::update(Immutable<style::Source::Impl> baseImpl_,
                                 const std::vector<Immutable<Layer::Impl>>& layers,
                                 const bool needsRendering,
@@ -72,17 +76,18 @@ std::vector<std::reference_wrapper<RenderTile>> RenderRasterSource::getRenderTil
     return tilePyramid.getRenderTiles();
 }
 
-std::unordered_map<std::string, std::vector<Feature>>
+std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>
 RenderRasterSource::queryRenderedFeatures(const ScreenLineString&,
                                           const TransformState&,
                                           const std::vector<const RenderLayer*>&,
                                           const RenderedQueryOptions&,
-                                          const mat4&) const {
-    return std::unordered_map<std::string, std::vector<Feature>> {};
+                                          const mat4&,
+                                          Scheduler&) const {
+    return std::unordered_map<std::string, std::vector<RenderedFeatureHandle>> {};
 }
 
-std::vector<Feature> RenderRasterSource::querySourceFeatures(const SourceQueryOptions&) const {
-    return {};
+void RenderRasterSource::querySourceFeatures(const std::function<void (Feature&&)>&,
+                                             const SourceQueryOptions&) const {
 }
 
 void RenderRasterSource::reduceMemoryUse() {
@@ -23,6 +23,10 @@ bool RenderVectorSource::isLoaded() const {
     return tilePyramid.isLoaded();
 }
 
+std::size_t RenderVectorSource::getPendingTileCount() const {
+    return tilePyramid.getPendingTileCount();
+}
+
 void RenderVectorSource::update(Immutable<style::Source::Impl> baseImpl_,
                                 const std::vector<Immutable<Layer::Impl>>& layers,
                                 const bool needsRendering,
@@ -75,17 +79,19 @@ std::vector<std::reference_wrapper<RenderTile>> RenderVectorSource::getRenderTil
     return tilePyramid.getRenderTiles();
 }
 
-std::unordered_map<std::string, std::vector<Feature>>
+std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>
 RenderVectorSource::queryRenderedFeatures(const ScreenLineString& geometry,
                                           const TransformState& transformState,
                                           const std::vector<const RenderLayer*>& layers,
                                           const RenderedQueryOptions& options,
-                                          const mat4& projMatrix) const {
-    return tilePyramid.queryRenderedFeatures(geometry, transformState, layers, options, projMatrix);
+                                          const mat4& projMatrix,
+                                          Scheduler& scheduler) const {
+    return tilePyramid.queryRenderedFeatures(geometry, transformState, layers, options, projMatrix, scheduler);
 }
 
-std::vector<Feature> RenderVectorSource::querySourceFeatures(const SourceQueryOptions& options) const {
-    return tilePyramid.querySourceFeatures(options);
+void RenderVectorSource::querySourceFeatures(const std::function<void (Feature&&)>& callback,
+                                             const SourceQueryOptions& options) const {
+    tilePyramid.querySourceFeatures(callback, options);
 }
 
 void RenderVectorSource::reduceMemoryUse() {
@@ -2,6 +2,8 @@
 
 #include <mbgl/map/mode.hpp>
 
+#include <vector>
+
 namespace mbgl {
 
 class TransformState;
@@ -23,6 +25,7 @@ public:
     ImageManager& imageManager;
     GlyphManager& glyphManager;
     const uint8_t prefetchZoomDelta;
+    const std::vector<TransformState>& prefetchStates;
 };
 
 } // namespace mbgl
@@ -10,12 +10,14 @@
 #include <mbgl/util/tile_range.hpp>
 #include <mbgl/util/enum.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/parallel_for.hpp>
 
 #include <mbgl/algorithm/update_renderables.hpp>
 
 #include <mapbox/geometry/envelope.hpp>
 
 #include <cmath>
+#include <set>
 #include <algorithm>
 
 namespace mbgl {
@@ -32,7 +34,7 @@ TilePyramid::~TilePyramid() = default;
 
 bool TilePyramid::isLoaded() const {
     for (const auto& pair : tiles) {
-        if (!pair.second->isComplete()) {
+        if (!pair.second->isComplete() && !prefetchedTiles.count(pair.first)) {
             return false;
         }
     }
@@ -40,6 +42,16 @@ bool TilePyramid::isLoaded() const {
     return true;
 }
 
+std::size_t TilePyramid::getPendingTileCount() const {
+    std::size_t count = 0;
+    for (const auto& pair : tiles) {
+        if (!pair.second->isComplete() && !prefetchedTiles.count(pair.first)) {
+            count++;
+        }
+    }
+    return count;
+}
+
 void TilePyramid::startRender(PaintParameters& parameters) {
     for (auto& tile : renderTiles) {
         tile.startRender(parameters);
@@ -86,6 +98,7 @@ void TilePyramid::update(const std::vector<Immutable<style::Layer::Impl>>& layer
 
         tiles.clear();
         renderTiles.clear();
+        prefetchedTiles.clear();
 
         return;
     }
@@ -123,6 +136,24 @@ void TilePyramid::update(const std::vector<Immutable<style::Layer::Impl>>& layer
         idealTiles = util::tileCover(parameters.transformState, idealZoom);
     }
 
+    // The ideal tiles of the viewports that the camera is expected to move to.
+    std::vector<OverscaledTileID> prefetchTileIDs;
+    int32_t maxTileZoom = tileZoom;
+    for (const auto& prefetchState : parameters.prefetchStates) {
+        int32_t prefetchZoom = util::coveringZoomLevel(prefetchState.getZoom(), type, tileSize);
+        if (prefetchZoom < zoomRange.min) {
+            continue;
+        }
+        const int32_t idealPrefetchZoom = std::min<int32_t>(zoomRange.max, prefetchZoom);
+        if (type == SourceType::Raster) {
+            prefetchZoom = idealPrefetchZoom;
+        }
+        for (const auto& tileID : util::tileCover(prefetchState, idealPrefetchZoom)) {
+            prefetchTileIDs.emplace_back(prefetchZoom, tileID.wrap, tileID.canonical);
+        }
+        maxTileZoom = std::max(maxTileZoom, prefetchZoom);
+    }
+
     // Stores a list of all the tiles that we're definitely going to retain. There are two
     // kinds of tiles we need: the ideal tiles determined by the tile cover. They may not yet be in
     // use because they're still loading. In addition to that, we also need to retain all tiles that
@@ -149,7 +180,7 @@ void TilePyramid::update(const std::vector<Immutable<style::Layer::Impl>>& layer
     // tiles are used from the cache, but not created.
     optional<util::TileRange> tileRange = {};
     if (bounds) {
-        tileRange = util::TileRange::fromLatLngBounds(*bounds, zoomRange.min, std::min(tileZoom, (int32_t)zoomRange.max));
+        tileRange = util::TileRange::fromLatLngBounds(*bounds, zoomRange.min, std::min(maxTileZoom, (int32_t)zoomRange.max));
     }
     auto createTileFn = [&](const OverscaledTileID& tileID) -> Tile* {
         if (tileRange && !tileRange->contains(tileID.canonical)) {
@@ -190,7 +221,24 @@ void TilePyramid::update(const std::vector<Immutable<style::Layer::Impl>>& layer
 
     algorithm::updateRenderables(getTileFn, createTileFn, retainTileFn, renderTileFn,
                                  idealTiles, zoomRange, tileZoom);
-    
+
+    // Prefetched tiles are requested like ideal tiles, but without falling back to parents or
+    // children. They are tracked separately so that they don't hold up loading of the map.
+    prefetchedTiles.clear();
+    for (const auto& tileID : prefetchTileIDs) {
+        if (retain.count(tileID)) {
+            continue;
+        }
+        Tile* tile = getTileFn(tileID);
+        if (!tile) {
+            tile = createTileFn(tileID);
+        }
+        if (tile) {
+            retainTileFn(*tile, TileNecessity::Required);
+            prefetchedTiles.insert(tileID);
+        }
+    }
+
     for (auto previouslyRenderedTile : previouslyRenderedTiles) {
         Tile& tile = *previouslyRenderedTile.second;
         tile.markRenderedPreviously();
@@ -238,12 +286,13 @@ void TilePyramid::update(const std::vector<Immutable<style::Layer::Impl>>& layer
     }
 }
 
-std::unordered_map<std::string, std::vector<Feature>> TilePyramid::queryRenderedFeatures(const ScreenLineString& geometry,
+std::unordered_map<std::string, std::vector<RenderedFeatureHandle>> TilePyramid::queryRenderedFeatures(const ScreenLineString& geometry,
                                            const TransformState& transformState,
                                            const std::vector<const RenderLayer*>& layers,
                                            const RenderedQueryOptions& options,
-                                           const mat4& projMatrix) const {
-    std::unordered_map<std::string, std::vector<Feature>> result;
+                                           const mat4& projMatrix,
+                                           Scheduler& scheduler) const {
+    std::unordered_map<std::string, std::vector<RenderedFeatureHandle>> result;
     if (renderTiles.empty() || geometry.empty()) {
         return result;
     }
@@ -266,6 +315,9 @@ std::unordered_map<std::string, std::vector<Feature>> TilePyramid::queryRendered
 
     auto maxPitchScaleFactor = transformState.maxPitchScaleFactor();
 
+    std::vector<std::reference_wrapper<const RenderTile>> queriedTiles;
+    std::vector<GeometryCoordinates> tileSpaceQueryGeometries;
+
     for (const RenderTile& renderTile : sortedTiles) {
         const float scale = std::pow(2, transformState.getZoom() - renderTile.id.canonical.z);
         auto queryPadding = maxPitchScaleFactor * renderTile.tile.getQueryPadding(layers) * util::EXTENT / util::tileSize / scale;
@@ -286,25 +338,56 @@ std::unordered_map<std::string, std::vector<Feature>> TilePyramid::queryRendered
             tileSpaceQueryGeometry.push_back(TileCoordinate::toGeometryCoordinate(renderTile.id, c));
         }
 
-        renderTile.tile.queryRenderedFeatures(result,
-                                              tileSpaceQueryGeometry,
-                                              transformState,
-                                              layers,
-                                              options,
-                                              projMatrix);
+        queriedTiles.push_back(renderTile);
+        tileSpaceQueryGeometries.push_back(std::move(tileSpaceQueryGeometry));
+    }
+
+    // Tiles don't share any data, so they can be queried in parallel. Results are merged
+    // in the order of the sorted tiles, as if they were queried one after the other.
+    std::vector<std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>> tileResults(queriedTiles.size());
+    util::parallelFor(scheduler, queriedTiles.size(), [&](std::size_t i) {
+        queriedTiles[i].get().tile.queryRenderedFeatures(tileResults[i],
+                                                         tileSpaceQueryGeometries[i],
+                                                         transformState,
+                                                         layers,
+                                                         options,
+                                                         projMatrix);
+    });
+
+    for (auto& tileResult : tileResults) {
+        for (auto& layerResult : tileResult) {
+            auto& features = result[layerResult.first];
+            std::move(layerResult.second.begin(), layerResult.second.end(), std::back_inserter(features));
+        }
     }
 
     return result;
 }
 
-std::vector<Feature> TilePyramid::querySourceFeatures(const SourceQueryOptions& options) const {
-    std::vector<Feature> result;
+void TilePyramid::querySourceFeatures(const std::function<void (Feature&&)>& callback,
+                                      const SourceQueryOptions& options) const {
+    if (!options.bounds) {
+        for (const auto& pair : tiles) {
+            pair.second->querySourceFeatures([&](const std::string&, Feature&& feature) {
+                callback(std::move(feature));
+            }, options);
+        }
+        return;
+    }
+
+    // Features that cross tile boundaries are found in each tile they intersect. IDs are only
+    // unique within a source layer, so features of different layers may share them.
+    std::unordered_map<std::string, std::set<FeatureIdentifier>> seen;
+    auto deduplicate = [&](const std::string& sourceLayer, Feature&& feature) {
+        if (feature.id && !seen[sourceLayer].insert(*feature.id).second) {
+            return;
+        }
+        callback(std::move(feature));
+    };
 
     for (const auto& pair : tiles) {
-        pair.second->querySourceFeatures(result, options);
+        pair.second->querySourceFeatures(deduplicate, options);
     }
-
-    return result;
 }
 
 void TilePyramid::setCacheSize(size_t size) {
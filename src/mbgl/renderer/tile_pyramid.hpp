@@ -11,10 +11,12 @@
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/range.hpp>
 
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 #include <map>
+#include <set>
 
 namespace mbgl {
 
@@ -25,6 +27,7 @@ class RenderLayer;
 class RenderedQueryOptions;
 class SourceQueryOptions;
 class TileParameters;
+class Scheduler;
 
 class TilePyramid {
 public:
@@ -32,6 +35,7 @@ public:
     ~TilePyramid();
 
     bool isLoaded() const;
+    std::size_t getPendingTileCount() const;
 
     void update(const std::vector<Immutable<style::Layer::Impl>>&,
                 bool needsRendering,
@@ -49,14 +53,16 @@ public:
     std::vector<std::reference_wrapper<RenderTile>> getRenderTiles();
     Tile* getTile(const OverscaledTileID&);
 
-    std::unordered_map<std::string, std::vector<Feature>>
+    std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>
     queryRenderedFeatures(const ScreenLineString& geometry,
                           const TransformState& transformState,
                           const std::vector<const RenderLayer*>&,
                           const RenderedQueryOptions& options,
-                          const mat4& projMatrix) const;
+                          const mat4& projMatrix,
+                          Scheduler& scheduler) const;
 
-    std::vector<Feature> querySourceFeatures(const SourceQueryOptions&) const;
+    void querySourceFeatures(const std::function<void (Feature&&)>& callback,
+                             const SourceQueryOptions&) const;
 
     void setCacheSize(size_t);
     void reduceMemoryUse();
@@ -71,6 +77,9 @@ public:
 
     std::vector<RenderTile> renderTiles;
 
+    // Tiles that are only loaded for the viewports in TileParameters::prefetchStates.
+    std::set<OverscaledTileID> prefetchedTiles;
+
     TileObserver* observer = nullptr;
 };
 
@@ -35,7 +35,10 @@ public:
     AnnotationManager& annotationManager;
 
     const uint8_t prefetchZoomDelta;
-    
+
+    // Viewports whose tiles are loaded ahead of time, but not rendered.
+    const std::vector<TransformState> prefetchStates;
+
     // For still image requests, render requested
     const bool stillImageRequest;
 };
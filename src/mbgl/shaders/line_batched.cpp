@@ -0,0 +1,127 @@
+// NOTE: DO NOT CHANGE THIS FILE. IT IS AUTOMATICALLY GENERATED.
+
+#include <mbgl/shaders/line_batched.hpp>
+
+namespace mbgl {
+namespace shaders {
+
+const char* line_batched::name = "line_batched";
+const char* line_batched::vertexSource = R"MBGL_SHADER(
+// Like the line shader, but draws the lines of up to MAX_TILES tiles at once. Each vertex picks
+// the matrix of its tile, and passes on its position in the tile so that the fragment shader can
+// clip to it. Only used when no paint property is data-driven.
+
+// the distance over which the line edge fades out.
+// Retina devices need a smaller distance to avoid aliasing.
+#define ANTIALIASING 1.0 / DEVICE_PIXEL_RATIO / 2.0
+
+// floor(127 / 2) == 63.0
+// the maximum allowed miter limit is 2.0 at the moment. the extrude normal is
+// stored in a byte (-128..127). we scale regular normals up to length 63, but
+// there are also "special" normals that have a bigger length (of up to 126 in
+// this case).
+// #define scale 63.0
+#define scale 0.015873016
+
+// Must match LineBatchedProgram::maxTiles and util::EXTENT.
+#define MAX_TILES 16
+#define EXTENT 8192.0
+
+attribute vec4 a_pos_normal;
+attribute vec4 a_data;
+attribute float a_tile;
+
+uniform mat4 u_matrices[MAX_TILES];
+uniform mediump float u_ratio;
+uniform vec2 u_gl_units_to_pixels;
+
+uniform mediump float u_gapwidth;
+uniform lowp float u_offset;
+uniform mediump float u_width;
+
+varying vec2 v_normal;
+varying vec2 v_width2;
+varying float v_gamma_scale;
+varying highp vec2 v_tile_pos;
+
+void main() {
+    mat4 matrix = u_matrices[int(a_tile)];
+
+    vec2 a_extrude = a_data.xy - 128.0;
+    float a_direction = mod(a_data.z, 4.0) - 1.0;
+
+    vec2 pos = a_pos_normal.xy;
+
+    // x is 1 if it's a round cap, 0 otherwise
+    // y is 1 if the normal points up, and -1 if it points down
+    mediump vec2 normal = a_pos_normal.zw;
+    v_normal = normal;
+
+    mediump float gapwidth = u_gapwidth / 2.0;
+    float halfwidth = u_width / 2.0;
+    lowp float offset = -1.0 * u_offset;
+
+    float inset = gapwidth + (gapwidth > 0.0 ? ANTIALIASING : 0.0);
+    float outset = gapwidth + halfwidth * (gapwidth > 0.0 ? 2.0 : 1.0) + ANTIALIASING;
+
+    // Scale the extrusion vector down to a normal and then up by the line width
+    // of this vertex.
+    mediump vec2 dist = outset * a_extrude * scale;
+
+    // Calculate the offset when drawing a line that is to the side of the actual line.
+    // We do this by creating a vector that points towards the extrude, but rotate
+    // it when we're drawing round end points (a_direction = -1 or 1) since their
+    // extrude vector points in another direction.
+    mediump float u = 0.5 * a_direction;
+    mediump float t = 1.0 - abs(u);
+    mediump vec2 offset2 = offset * a_extrude * scale * normal.y * mat2(t, -u, u, t);
+
+    vec4 projected_extrude = matrix * vec4(dist / u_ratio, 0.0, 0.0);
+    gl_Position = matrix * vec4(pos + offset2 / u_ratio, 0.0, 1.0) + projected_extrude;
+
+    // calculate how much the perspective view squishes or stretches the extrude
+    float extrude_length_without_perspective = length(dist);
+    float extrude_length_with_perspective = length(projected_extrude.xy / gl_Position.w * u_gl_units_to_pixels);
+    v_gamma_scale = extrude_length_without_perspective / extrude_length_with_perspective;
+
+    v_width2 = vec2(outset, inset);
+    v_tile_pos = (pos + (offset2 + dist) / u_ratio) / EXTENT;
+}
+
+)MBGL_SHADER";
+const char* line_batched::fragmentSource = R"MBGL_SHADER(
+uniform highp vec4 u_color;
+uniform lowp float u_blur;
+uniform lowp float u_opacity;
+
+varying vec2 v_width2;
+varying vec2 v_normal;
+varying float v_gamma_scale;
+varying highp vec2 v_tile_pos;
+
+void main() {
+    // Clip to the tile, which covers the same pixels as the tile's stencil clipping mask.
+    if (v_tile_pos.x < 0.0 || v_tile_pos.y < 0.0 || v_tile_pos.x >= 1.0 || v_tile_pos.y >= 1.0) {
+        discard;
+    }
+
+    // Calculate the distance of the pixel from the line in pixels.
+    float dist = length(v_normal) * v_width2.s;
+
+    // Calculate the antialiasing fade factor. This is either when fading in
+    // the line in case of an offset line (v_width2.t) or when fading out
+    // (v_width2.s)
+    float blur2 = (u_blur + 1.0 / DEVICE_PIXEL_RATIO) * v_gamma_scale;
+    float alpha = clamp(min(dist - (v_width2.t - blur2), v_width2.s - dist) / blur2, 0.0, 1.0);
+
+    gl_FragColor = u_color * (alpha * u_opacity);
+
+#ifdef OVERDRAW_INSPECTOR
+    gl_FragColor = vec4(1.0);
+#endif
+}
+
+)MBGL_SHADER";
+
+} // namespace shaders
+} // namespace mbgl
@@ -1,11 +1,20 @@
 #include <mbgl/style/custom_tile_loader.hpp>
 #include <mbgl/tile/custom_geometry_tile.hpp>
+#include <mbgl/util/feature.hpp>
 #include <mbgl/util/tile_range.hpp>
 
+#include <mapbox/geojsonvt.hpp>
+
+#include <algorithm>
+#include <cmath>
+
 namespace mbgl {
 namespace style {
 
-CustomTileLoader::CustomTileLoader(const TileFunction& fetchTileFn, const TileFunction& cancelTileFn) {
+CustomTileLoader::CustomTileLoader(const TileFunction& fetchTileFn,
+                                   const TileFunction& cancelTileFn,
+                                   CustomGeometrySource::TileOptions options_)
+    : options(std::move(options_)) {
     fetchTileFunction = fetchTileFn;
     cancelTileFunction = cancelTileFn;
 }
@@ -13,30 +22,35 @@ CustomTileLoader::CustomTileLoader(const TileFunction& fetchTileFn, const TileFu
 void CustomTileLoader::fetchTile(const OverscaledTileID& tileID, ActorRef<CustomGeometryTile> tileRef) {
     auto cachedTileData = dataCache.find(tileID.canonical);
     if (cachedTileData != dataCache.end()) {
-        tileRef.invoke(&CustomGeometryTile::setTileData, *(cachedTileData->second));
+        tileRef.invoke(&CustomGeometryTile::setTileData, cachedTileData->second);
     }
-    auto tileCallbacks = tileCallbackMap.find(tileID.canonical);
-    if (tileCallbacks == tileCallbackMap.end()) {
-        auto tuple = std::make_tuple(tileID.overscaledZ, tileID.wrap, tileRef);
-        tileCallbackMap.insert({ tileID.canonical, std::vector<OverscaledIDFunctionTuple>(1, tuple) });
+    auto& tileCallbacks = tileCallbackMap[tileID.canonical];
+    auto iter = std::find_if(tileCallbacks.begin(), tileCallbacks.end(), [&](const auto& tuple) {
+        return std::get<0>(tuple) == tileID.overscaledZ && std::get<1>(tuple) == tileID.wrap;
+    });
+    if (iter != tileCallbacks.end()) {
+        std::get<2>(*iter) = tileRef;
+        std::get<3>(*iter) = true;
     } else {
-        for (auto iter = tileCallbacks->second.begin(); iter != tileCallbacks->second.end(); iter++) {
-            if (std::get<0>(*iter) == tileID.overscaledZ && std::get<1>(*iter) == tileID.wrap ) {
-                std::get<2>(*iter) = tileRef;
-                return;
-            }
-        }
-        tileCallbacks->second.emplace_back(std::make_tuple(tileID.overscaledZ, tileID.wrap, tileRef));
+        tileCallbacks.emplace_back(std::make_tuple(tileID.overscaledZ, tileID.wrap, tileRef, true));
     }
-    if (cachedTileData == dataCache.end()) {
+
+    // The data of a canonical tile is fetched once, and shared by its wrapped and overscaled
+    // tiles, including the ones that are added while it's being fetched.
+    if (cachedTileData == dataCache.end() && pendingFetches.insert(tileID.canonical).second) {
         invokeTileFetch(tileID.canonical);
     }
 }
 
 void CustomTileLoader::cancelTile(const OverscaledTileID& tileID) {
-    if (tileCallbackMap.find(tileID.canonical) != tileCallbackMap.end()) {
-        invokeTileCancel(tileID.canonical);
+    auto tileCallbacks = tileCallbackMap.find(tileID.canonical);
+    if (tileCallbacks == tileCallbackMap.end()) return;
+    for (auto& tuple : tileCallbacks->second) {
+        if (std::get<0>(tuple) == tileID.overscaledZ && std::get<1>(tuple) == tileID.wrap) {
+            std::get<3>(tuple) = false;
+        }
     }
+    cancelUnrequiredFetch(tileID.canonical);
 }
 
 void CustomTileLoader::removeTile(const OverscaledTileID& tileID) {
@@ -45,26 +59,53 @@ void CustomTileLoader::removeTile(const OverscaledTileID& tileID) {
     for (auto iter = tileCallbacks->second.begin(); iter != tileCallbacks->second.end(); iter++) {
         if (std::get<0>(*iter) == tileID.overscaledZ && std::get<1>(*iter) == tileID.wrap ) {
             tileCallbacks->second.erase(iter);
-            invokeTileCancel(tileID.canonical);
             break;
         }
     }
+    cancelUnrequiredFetch(tileID.canonical);
     if (tileCallbacks->second.size() == 0) {
         tileCallbackMap.erase(tileCallbacks);
         dataCache.erase(tileID.canonical);
     }
 }
 
-void CustomTileLoader::setTileData(const CanonicalTileID& tileID, const GeoJSON& data) {
+void CustomTileLoader::cancelUnrequiredFetch(const CanonicalTileID& tileID) {
+    if (pendingFetches.find(tileID) == pendingFetches.end()) return;
+    auto tileCallbacks = tileCallbackMap.find(tileID);
+    if (tileCallbacks != tileCallbackMap.end() &&
+        std::any_of(tileCallbacks->second.begin(), tileCallbacks->second.end(),
+                    [](const auto& tuple) { return std::get<3>(tuple); })) {
+        return;
+    }
+    pendingFetches.erase(tileID);
+    invokeTileCancel(tileID);
+}
+
+void CustomTileLoader::setTileData(const CanonicalTileID& tileID, std::shared_ptr<const GeoJSON> data) {
+    if (tileCallbackMap.find(tileID) == tileCallbackMap.end()) return;
 
+    auto features = std::make_shared<TileFeatures>();
+    if (data->is<FeatureCollection>() && !data->get<FeatureCollection>().empty()) {
+        const double scale = util::EXTENT / options.tileSize;
+
+        mapbox::geojsonvt::TileOptions vtOptions;
+        vtOptions.extent = util::EXTENT;
+        vtOptions.buffer = ::round(scale * options.buffer);
+        vtOptions.tolerance = scale * options.tolerance;
+        *features = mapbox::geojsonvt::geoJSONToTile(*data, tileID.z, tileID.x, tileID.y, vtOptions, options.wrap, options.clip).features;
+    }
+    setTileFeatures(tileID, std::move(features));
+}
+
+void CustomTileLoader::setTileFeatures(const CanonicalTileID& tileID, std::shared_ptr<const TileFeatures> features) {
     auto iter = tileCallbackMap.find(tileID);
     if (iter == tileCallbackMap.end()) return;
-    auto dataPtr = std::make_unique<mapbox::geojson::geojson>(std::move(data));
     for (auto tuple : iter->second) {
         auto actor = std::get<2>(tuple);
-        actor.invoke(&CustomGeometryTile::setTileData, *dataPtr);
+        actor.invoke(&CustomGeometryTile::setTileData, features);
     }
-    dataCache[tileID] = std::move(dataPtr);
+    pendingFetches.erase(tileID);
+    dataCache[tileID] = std::move(features);
 }
 
 void CustomTileLoader::invalidateTile(const CanonicalTileID& tileID) {
@@ -73,6 +114,8 @@ void CustomTileLoader::invalidateTile(const CanonicalTileID& tileID) {
     for (auto iter = tileCallbacks->second.begin(); iter != tileCallbacks->second.end(); iter++) {
         auto actor = std::get<2>(*iter);
         actor.invoke(&CustomGeometryTile::invalidateTileData);
+    }
+    if (pendingFetches.erase(tileID)) {
         invokeTileCancel(tileID);
     }
     tileCallbackMap.erase(tileCallbacks);
@@ -92,9 +135,11 @@ void CustomTileLoader::invalidateRegion(const LatLngBounds& bounds, Range<uint8_
             for (auto iter = idtuple->second.begin(); iter != idtuple->second.end(); iter++) {
                 auto actor = std::get<2>(*iter);
                 actor.invoke(&CustomGeometryTile::invalidateTileData);
+            }
+            if (pendingFetches.erase(idtuple->first)) {
                 invokeTileCancel(idtuple->first);
-                dataCache.erase(idtuple->first);
             }
+            dataCache.erase(idtuple->first);
             idtuple->second.clear();
         }
     }
@@ -6,6 +6,8 @@
 #include <mbgl/actor/actor_ref.hpp>
 
 #include <map>
+#include <memory>
+#include <unordered_set>
 
 namespace mbgl {
 
@@ -16,15 +18,23 @@ namespace style {
 class CustomTileLoader : private util::noncopyable {
 public:
 
-    using OverscaledIDFunctionTuple = std::tuple<uint8_t, int16_t, ActorRef<CustomGeometryTile>>;
+    // Overscaled zoom, wrap, the tile, and whether the tile is required.
+    using OverscaledIDFunctionTuple = std::tuple<uint8_t, int16_t, ActorRef<CustomGeometryTile>, bool>;
+    using TileFeatures = mapbox::geometry::feature_collection<int16_t>;
 
-    CustomTileLoader(const TileFunction& fetchTileFn, const TileFunction& cancelTileFn);
+    CustomTileLoader(const TileFunction& fetchTileFn,
+                     const TileFunction& cancelTileFn,
+                     CustomGeometrySource::TileOptions = {});
 
     void fetchTile(const OverscaledTileID& tileID, ActorRef<CustomGeometryTile> tileRef);
     void cancelTile(const OverscaledTileID& tileID);
 
     void removeTile(const OverscaledTileID& tileID);
-    void setTileData(const CanonicalTileID& tileID, const GeoJSON& data);
+
+    // Converts the data to tile coordinates once, and shares the result with all tiles of the
+    // canonical tile ID.
+    void setTileData(const CanonicalTileID& tileID, std::shared_ptr<const GeoJSON> data);
+    void setTileFeatures(const CanonicalTileID& tileID, std::shared_ptr<const TileFeatures> features);
 
     void invalidateTile(const CanonicalTileID&);
     void invalidateRegion(const LatLngBounds&, Range<uint8_t>);
@@ -32,12 +42,17 @@ public:
 private:
     void invokeTileFetch(const CanonicalTileID& tileID);
     void invokeTileCancel(const CanonicalTileID& tileID);
+    // Cancels the fetch of the canonical tile once none of its tiles require it.
+    void cancelUnrequiredFetch(const CanonicalTileID& tileID);
 
     TileFunction fetchTileFunction;
     TileFunction cancelTileFunction;
+    const CustomGeometrySource::TileOptions options;
     std::unordered_map<CanonicalTileID, std::vector<OverscaledIDFunctionTuple>> tileCallbackMap;
     // Keep around a cache of tile data to serve back for wrapped and over-zooomed tiles
-    std::map<CanonicalTileID, std::unique_ptr<GeoJSON>> dataCache;
+    std::map<CanonicalTileID, std::shared_ptr<const TileFeatures>> dataCache;
+    // Canonical tiles that were fetched and haven't received data or been cancelled yet.
+    std::unordered_set<CanonicalTileID> pendingFetches;
 
 };
 
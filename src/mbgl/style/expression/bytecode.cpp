@@ -0,0 +1,489 @@
+#include <mbgl/style/expression/bytecode.hpp>
+#include <mbgl/style/expression/assertion.hpp>
+#include <mbgl/style/expression/compound_expression.hpp>
+#include <mbgl/style/expression/feature_batch.hpp>
+#include <mbgl/style/expression/interpolate.hpp>
+#include <mbgl/style/expression/literal.hpp>
+#include <mbgl/style/expression/step.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/math/log2.hpp>
+#include <mbgl/util/interpolate.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace mbgl {
+namespace style {
+namespace expression {
+
+class Bytecode::Compiler {
+public:
+    Compiler(Bytecode& code_) : code(code_) {}
+
+    struct Operand {
+        bool number;
+        uint16_t reg;
+    };
+
+    Operand compile(const Expression& expression) {
+        if (auto literal = dynamic_cast<const Literal*>(&expression)) {
+            return compileLiteral(literal->getValue());
+        } else if (auto compound = dynamic_cast<const CompoundExpressionBase*>(&expression)) {
+            if (auto result = compileCompound(*compound)) {
+                return *result;
+            }
+        } else if (auto assertion = dynamic_cast<const Assertion*>(&expression)) {
+            if (auto result = compileAssertion(*assertion)) {
+                return *result;
+            }
+        } else if (auto interpolate = dynamic_cast<const InterpolateBase*>(&expression)) {
+            if (auto result = compileCurve(expression, interpolate->getInput(), interpolate)) {
+                return *result;
+            }
+        } else if (auto step = dynamic_cast<const Step*>(&expression)) {
+            if (auto result = compileCurve(expression, step->getInput(), nullptr)) {
+                return *result;
+            }
+        }
+
+        Instruction instruction = make(Op::Evaluate, valueRegister());
+        instruction.index = static_cast<uint32_t>(code.fallbacks.size());
+        code.fallbacks.push_back(&expression);
+        return emit(instruction, false);
+    }
+
+    uint16_t asNumber(Operand operand) {
+        if (operand.number) {
+            return operand.reg;
+        }
+        Instruction instruction = make(Op::Unbox, numberRegister());
+        instruction.a = operand.reg;
+        return emit(instruction, true).reg;
+    }
+
+private:
+    static Instruction make(Op op, uint16_t dst) {
+        Instruction instruction;
+        instruction.op = op;
+        instruction.dst = dst;
+        return instruction;
+    }
+
+    uint16_t numberRegister() {
+        return code.numberRegisters++;
+    }
+
+    uint16_t valueRegister() {
+        return code.valueRegisters++;
+    }
+
+    Operand emit(const Instruction& instruction, bool number) {
+        code.instructions.push_back(instruction);
+        return { number, instruction.dst };
+    }
+
+    Operand compileLiteral(const Value& value) {
+        if (value.is<double>()) {
+            Instruction instruction = make(Op::LoadNumber, numberRegister());
+            instruction.number = value.get<double>();
+            return emit(instruction, true);
+        }
+        Instruction instruction = make(Op::LoadValue, valueRegister());
+        instruction.index = static_cast<uint32_t>(code.constants.size());
+        code.constants.push_back(value);
+        return emit(instruction, false);
+    }
+
+    static std::vector<const Expression*> children(const Expression& expression) {
+        std::vector<const Expression*> result;
+        expression.eachChild([&](const Expression& child) {
+            result.push_back(&child);
+        });
+        return result;
+    }
+
+    optional<Operand> compileCompound(const CompoundExpressionBase& expression) {
+        using MathFunction = double (*)(double);
+        static const std::unordered_map<std::string, Op> varargs {
+            { "+", Op::Sum }, { "*", Op::Product }, { "min", Op::Min }, { "max", Op::Max }
+        };
+        static const std::unordered_map<std::string, Op> binary {
+            { "-", Op::Subtract }, { "/", Op::Divide }, { "%", Op::Modulo }, { "^", Op::Power }
+        };
+        static const std::unordered_map<std::string, MathFunction> unary {
+            { "sqrt", [](double x) { return sqrt(x); } },
+            { "log10", [](double x) { return log10(x); } },
+            { "ln", [](double x) { return log(x); } },
+            { "log2", [](double x) { return util::log2(x); } },
+            { "sin", [](double x) { return sin(x); } },
+            { "cos", [](double x) { return cos(x); } },
+            { "tan", [](double x) { return tan(x); } },
+            { "asin", [](double x) { return asin(x); } },
+            { "acos", [](double x) { return acos(x); } },
+            { "atan", [](double x) { return atan(x); } },
+        };
+
+        const std::string name = expression.getName();
+        const std::vector<const Expression*> args = children(expression);
+
+        if (args.empty() && (name == "zoom" || name == "heatmap-density")) {
+            return emit(make(name == "zoom" ? Op::Zoom : Op::HeatmapDensity, numberRegister()), true);
+        }
+
+        if (name == "get" && expression.getParameterCount() == optional<std::size_t>(1)) {
+            auto key = dynamic_cast<const Literal*>(args[0]);
+            if (!key || !key->getValue().is<std::string>()) {
+                return {};
+            }
+            Instruction instruction = make(Op::Get, valueRegister());
+            instruction.index = static_cast<uint32_t>(code.keys.size());
+            code.keys.push_back(key->getValue().get<std::string>());
+            return emit(instruction, false);
+        }
+
+        auto varargsIt = varargs.find(name);
+        if (varargsIt != varargs.end()) {
+            std::vector<uint16_t> regs;
+            for (const Expression* arg : args) {
+                regs.push_back(asNumber(compile(*arg)));
+            }
+            Instruction instruction = make(varargsIt->second, numberRegister());
+            instruction.index = static_cast<uint32_t>(code.operands.size());
+            instruction.count = static_cast<uint16_t>(regs.size());
+            code.operands.insert(code.operands.end(), regs.begin(), regs.end());
+            return emit(instruction, true);
+        }
+
+        auto binaryIt = binary.find(name);
+        if (binaryIt != binary.end() && args.size() == 2) {
+            const uint16_t a = asNumber(compile(*args[0]));
+            const uint16_t b = asNumber(compile(*args[1]));
+            Instruction instruction = make(binaryIt->second, numberRegister());
+            instruction.a = a;
+            instruction.b = b;
+            return emit(instruction, true);
+        }
+
+        if (name == "-" && args.size() == 1) {
+            const uint16_t a = asNumber(compile(*args[0]));
+            Instruction instruction = make(Op::Negate, numberRegister());
+            instruction.a = a;
+            return emit(instruction, true);
+        }
+
+        auto unaryIt = unary.find(name);
+        if (unaryIt != unary.end() && args.size() == 1) {
+            const uint16_t a = asNumber(compile(*args[0]));
+            Instruction instruction = make(Op::Math, numberRegister());
+            instruction.a = a;
+            instruction.function = unaryIt->second;
+            return emit(instruction, true);
+        }
+
+        return {};
+    }
+
+    optional<Operand> compileAssertion(const Assertion& expression) {
+        const std::vector<const Expression*> args = children(expression);
+        if (!expression.getType().is<type::NumberType>() || args.size() != 1) {
+            return {};
+        }
+
+        const Operand input = compile(*args[0]);
+        if (input.number) {
+            return input;
+        }
+        Instruction instruction = make(Op::AssertNumber, numberRegister());
+        instruction.a = input.reg;
+        return emit(instruction, true);
+    }
+
+    optional<Operand> compileCurve(const Expression& expression,
+                                   const std::unique_ptr<Expression>& input,
+                                   const InterpolateBase* interpolate) {
+        Curve curve;
+        curve.interpolate = interpolate;
+
+        bool literalStops = true;
+        auto visit = [&](double stop, const Expression& output) {
+            auto literal = dynamic_cast<const Literal*>(&output);
+            if (!literal) {
+                literalStops = false;
+                return;
+            }
+            curve.inputs.push_back(stop);
+            curve.values.push_back(literal->getValue());
+        };
+        if (interpolate) {
+            interpolate->eachStop(visit);
+        } else {
+            static_cast<const Step&>(expression).eachStop(visit);
+        }
+
+        if (!literalStops || curve.values.empty()) {
+            return {};
+        }
+
+        auto allOf = [&](auto predicate) {
+            return std::all_of(curve.values.begin(), curve.values.end(), predicate);
+        };
+        curve.numeric = allOf([](const Value& v) { return v.is<double>(); });
+
+        // Only number and color interpolation is lowered; the stop types must match the
+        // expression's type exactly, as the tree checks them when interpolating.
+        if (interpolate) {
+            if (expression.getType().is<type::NumberType>()) {
+                if (!curve.numeric) return {};
+            } else if (expression.getType().is<type::ColorType>()) {
+                if (!allOf([](const Value& v) { return v.is<Color>(); })) return {};
+            } else {
+                return {};
+            }
+        }
+
+        if (curve.numeric) {
+            for (const Value& value : curve.values) {
+                curve.numbers.push_back(value.get<double>());
+            }
+            curve.values.clear();
+        }
+
+        const uint16_t a = asNumber(compile(*input));
+        Instruction instruction = make(interpolate ? Op::Interpolate : Op::Step,
+                                       curve.numeric ? numberRegister() : valueRegister());
+        instruction.a = a;
+        instruction.index = static_cast<uint32_t>(code.curves.size());
+        const bool numeric = curve.numeric;
+        code.curves.push_back(std::move(curve));
+        return emit(instruction, numeric);
+    }
+
+    Bytecode& code;
+};
+
+std::unique_ptr<Bytecode> Bytecode::compile(const Expression& expression) {
+    auto code = std::make_unique<Bytecode>();
+    Compiler compiler(*code);
+    const Compiler::Operand root = compiler.compile(expression);
+
+    if (code->instructions.size() == 1 && code->instructions.front().op == Op::Evaluate) {
+        return nullptr;
+    }
+
+    code->resultIsNumber = root.number;
+    code->result = root.reg;
+    return code;
+}
+
+namespace {
+
+// Register storage for a single evaluation. Small expressions don't allocate.
+template <class T, std::size_t N>
+class Registers {
+public:
+    Registers(std::size_t size) {
+        if (size > N) {
+            heap.resize(size);
+        }
+    }
+
+    T& operator[](std::size_t i) {
+        return heap.empty() ? stack[i] : heap[i];
+    }
+
+private:
+    std::array<T, N> stack;
+    std::vector<T> heap;
+};
+
+} // namespace
+
+EvaluationResult Bytecode::evaluate(const EvaluationContext& params) const {
+    return evaluate(params, nullptr, 0);
+}
+
+std::vector<EvaluationResult> Bytecode::evaluate(const FeatureBatch& batch, optional<float> zoom) const {
+    Columns columns;
+    columns.reserve(keys.size());
+    for (const auto& key : keys) {
+        columns.push_back(&batch.column(key));
+    }
+
+    std::vector<EvaluationResult> results;
+    results.reserve(batch.size());
+    for (std::size_t row = 0; row < batch.size(); row++) {
+        results.push_back(evaluate(EvaluationContext(zoom, &batch[row], {}), &columns, row));
+    }
+    return results;
+}
+
+EvaluationResult Bytecode::evaluate(const EvaluationContext& params, const Columns* columns, std::size_t row) const {
+    Registers<double, 16> numbers(numberRegisters);
+    Registers<Value, 8> values(valueRegisters);
+
+    // Writes output i of a curve into the instruction's destination register.
+    auto output = [&](const Instruction& instruction, const Curve& curve, std::size_t i) {
+        if (curve.numeric) {
+            numbers[instruction.dst] = curve.numbers[i];
+        } else {
+            values[instruction.dst] = curve.values[i];
+        }
+    };
+
+    // Matches the evaluation order and results of the corresponding Expression::evaluate()
+    // implementations.
+    for (const Instruction& instruction : instructions) {
+        switch (instruction.op) {
+        case Op::LoadNumber:
+            numbers[instruction.dst] = instruction.number;
+            break;
+        case Op::LoadValue:
+            values[instruction.dst] = constants[instruction.index];
+            break;
+        case Op::Zoom:
+            if (!params.zoom) {
+                return EvaluationError {
+                    "The 'zoom' expression is unavailable in the current evaluation context."
+                };
+            }
+            numbers[instruction.dst] = *params.zoom;
+            break;
+        case Op::HeatmapDensity:
+            if (!params.heatmapDensity) {
+                return EvaluationError {
+                    "The 'heatmap-density' expression is unavailable in the current evaluation context."
+                };
+            }
+            numbers[instruction.dst] = *params.heatmapDensity;
+            break;
+        case Op::Get: {
+            if (!params.feature) {
+                return EvaluationError {
+                    "Feature data is unavailable in the current evaluation context."
+                };
+            }
+            if (columns) {
+                values[instruction.dst] = (*(*columns)[instruction.index])[row];
+                break;
+            }
+            auto propertyValue = params.feature->getValue(keys[instruction.index]);
+            values[instruction.dst] = propertyValue ? Value(toExpressionValue(*propertyValue)) : Value(Null);
+            break;
+        }
+        case Op::AssertNumber: {
+            const Value& value = values[instruction.a];
+            if (!value.is<double>()) {
+                return EvaluationError {
+                    "Expected value to be of type " + toString(type::Type(type::Number)) +
+                    ", but found " + toString(typeOf(value)) + " instead."
+                };
+            }
+            numbers[instruction.dst] = value.get<double>();
+            break;
+        }
+        case Op::Unbox:
+            numbers[instruction.dst] = values[instruction.a].get<double>();
+            break;
+        case Op::Sum: {
+            double sum = 0.0f;
+            for (std::size_t i = 0; i < instruction.count; i++) {
+                sum += numbers[operands[instruction.index + i]];
+            }
+            numbers[instruction.dst] = sum;
+            break;
+        }
+        case Op::Product: {
+            double prod = 1.0f;
+            for (std::size_t i = 0; i < instruction.count; i++) {
+                prod *= numbers[operands[instruction.index + i]];
+            }
+            numbers[instruction.dst] = prod;
+            break;
+        }
+        case Op::Min: {
+            double result_ = std::numeric_limits<double>::infinity();
+            for (std::size_t i = 0; i < instruction.count; i++) {
+                result_ = fmin(numbers[operands[instruction.index + i]], result_);
+            }
+            numbers[instruction.dst] = result_;
+            break;
+        }
+        case Op::Max: {
+            double result_ = -std::numeric_limits<double>::infinity();
+            for (std::size_t i = 0; i < instruction.count; i++) {
+                result_ = fmax(numbers[operands[instruction.index + i]], result_);
+            }
+            numbers[instruction.dst] = result_;
+            break;
+        }
+        case Op::Subtract:
+            numbers[instruction.dst] = numbers[instruction.a] - numbers[instruction.b];
+            break;
+        case Op::Divide:
+            numbers[instruction.dst] = numbers[instruction.a] / numbers[instruction.b];
+            break;
+        case Op::Modulo:
+            numbers[instruction.dst] = fmod(numbers[instruction.a], numbers[instruction.b]);
+            break;
+        case Op::Power:
+            numbers[instruction.dst] = pow(numbers[instruction.a], numbers[instruction.b]);
+            break;
+        case Op::Negate:
+            numbers[instruction.dst] = -numbers[instruction.a];
+            break;
+        case Op::Math:
+            numbers[instruction.dst] = instruction.function(numbers[instruction.a]);
+            break;
+        case Op::Interpolate:
+        case Op::Step: {
+            const Curve& curve = curves[instruction.index];
+            const float x = static_cast<float>(numbers[instruction.a]);
+            if (std::isnan(x)) {
+                return EvaluationError { "Input is not a number." };
+            }
+
+            const std::size_t size = curve.inputs.size();
+            const std::size_t upper = std::upper_bound(curve.inputs.begin(), curve.inputs.end(), double(x)) - curve.inputs.begin();
+            if (upper == size) {
+                output(instruction, curve, size - 1);
+            } else if (upper == 0) {
+                output(instruction, curve, 0);
+            } else if (instruction.op == Op::Step) {
+                output(instruction, curve, upper - 1);
+            } else {
+                const float t = curve.interpolate->interpolationFactor({ curve.inputs[upper - 1], curve.inputs[upper] }, x);
+                if (t == 0.0f) {
+                    output(instruction, curve, upper - 1);
+                } else if (t == 1.0f) {
+                    output(instruction, curve, upper);
+                } else if (curve.numeric) {
+                    numbers[instruction.dst] = util::interpolate(curve.numbers[upper - 1], curve.numbers[upper], t);
+                } else {
+                    values[instruction.dst] = util::interpolate(curve.values[upper - 1].get<Color>(),
+                                                                curve.values[upper].get<Color>(), t);
+                }
+            }
+            break;
+        }
+        case Op::Evaluate: {
+            EvaluationResult evaluated = fallbacks[instruction.index]->evaluate(params);
+            if (!evaluated) {
+                return evaluated;
+            }
+            values[instruction.dst] = std::move(*evaluated);
+            break;
+        }
+        }
+    }
+
+    if (resultIsNumber) {
+        return Value(numbers[result]);
+    }
+    return std::move(values[result]);
+}
+
+} // namespace expression
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,25 @@
+#include <mbgl/style/expression/feature_batch.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+namespace mbgl {
+namespace style {
+namespace expression {
+
+const std::vector<Value>& FeatureBatch::column(const std::string& key) const {
+    auto it = columns.find(key);
+    if (it != columns.end()) {
+        return it->second;
+    }
+
+    std::vector<Value> values;
+    values.reserve(features.size());
+    for (const GeometryTileFeature* feature : features) {
+        auto propertyValue = feature->getValue(key);
+        values.push_back(propertyValue ? Value(toExpressionValue(*propertyValue)) : Value(Null));
+    }
+    return columns.emplace(key, std::move(values)).first->second;
+}
+
+} // namespace expression
+} // namespace style
+} // namespace mbgl
@@ -14,7 +14,7 @@ namespace style {
 CustomGeometrySource::CustomGeometrySource(std::string id,
                                        const CustomGeometrySource::Options options)
     : Source(makeMutable<CustomGeometrySource::Impl>(std::move(id), options)),
-    loader(std::make_unique<Actor<CustomTileLoader>>(*sharedThreadPool(), options.fetchTileFunction, options.cancelTileFunction)) {
+    loader(std::make_unique<Actor<CustomTileLoader>>(*sharedThreadPool(), options.fetchTileFunction, options.cancelTileFunction, options.tileOptions)) {
 }
 
 CustomGeometrySource::~CustomGeometrySource() = default;
@@ -28,9 +28,14 @@ void CustomGeometrySource::loadDescription(FileSource&) {
     loaded = true;
 }
 
-void CustomGeometrySource::setTileData(const CanonicalTileID& tileID,
-                                     const GeoJSON& data) {
-    loader->invoke(&CustomTileLoader::setTileData, tileID, data);
+void CustomGeometrySource::setTileData(const CanonicalTileID& tileID, GeoJSON data) {
+    loader->invoke(&CustomTileLoader::setTileData, tileID, std::make_shared<const GeoJSON>(std::move(data)));
+}
+
+void CustomGeometrySource::setTileFeatures(const CanonicalTileID& tileID,
+                                           mapbox::geometry::feature_collection<int16_t> features) {
+    loader->invoke(&CustomTileLoader::setTileFeatures, tileID,
+                   std::make_shared<const mapbox::geometry::feature_collection<int16_t>>(std::move(features)));
 }
 
 void CustomGeometrySource::invalidateTile(const CanonicalTileID& tileID) {
@@ -167,6 +167,12 @@ void Placement::placeLayerBucket(
                 collisionIndex.insertFeature(symbolInstance.iconCollisionFeature, bucket.layout.get<style::IconIgnorePlacement>(), bucket.bucketInstanceId);
             }
 
+            if (placeText || placeIcon) {
+                placedSymbols++;
+            } else {
+                collidedSymbols++;
+            }
+
             assert(symbolInstance.crossTileID != 0);
 
             if (placements.find(symbolInstance.crossTileID) != placements.end()) {
@@ -235,8 +241,9 @@ void Placement::updateLayerOpacities(RenderSymbolLayer& symbolLayer) {
 }
 
 void Placement::updateBucketOpacities(SymbolBucket& bucket, std::set<uint32_t>& seenCrossTileIDs) {
-    if (bucket.hasTextData()) bucket.text.opacityVertices.clear();
-    if (bucket.hasIconData()) bucket.icon.opacityVertices.clear();
+    // Opacity vertices are updated in place, in the order in which the layout created them.
+    std::size_t textVertexIndex = 0;
+    std::size_t iconVertexIndex = 0;
     if (bucket.hasCollisionBoxData()) bucket.collisionBox.dynamicVertices.clear();
     if (bucket.hasCollisionCircleData()) bucket.collisionCircle.dynamicVertices.clear();
 
@@ -266,12 +273,9 @@ void Placement::updateBucketOpacities(SymbolBucket& bucket, std::set<uint32_t>&
 
         if (symbolInstance.hasText) {
             auto opacityVertex = SymbolOpacityAttributes::vertex(opacityState.text.placed, opacityState.text.opacity);
-            for (size_t i = 0; i < symbolInstance.horizontalGlyphQuads.size() * 4; i++) {
-                bucket.text.opacityVertices.emplace_back(opacityVertex);
-            }
-            for (size_t i = 0; i < symbolInstance.verticalGlyphQuads.size() * 4; i++) {
-                bucket.text.opacityVertices.emplace_back(opacityVertex);
-            }
+            const size_t vertexCount = (symbolInstance.horizontalGlyphQuads.size() + symbolInstance.verticalGlyphQuads.size()) * 4;
+            SymbolBucket::setOpacity(bucket.text, textVertexIndex, vertexCount, opacityVertex);
+            textVertexIndex += vertexCount;
             if (symbolInstance.placedTextIndex) {
                 bucket.text.placedSymbols[*symbolInstance.placedTextIndex].hidden = opacityState.isHidden();
             }
@@ -282,10 +286,8 @@ void Placement::updateBucketOpacities(SymbolBucket& bucket, std::set<uint32_t>&
         if (symbolInstance.hasIcon) {
             auto opacityVertex = SymbolOpacityAttributes::vertex(opacityState.icon.placed, opacityState.icon.opacity);
             if (symbolInstance.iconQuad) {
-                bucket.icon.opacityVertices.emplace_back(opacityVertex);
-                bucket.icon.opacityVertices.emplace_back(opacityVertex);
-                bucket.icon.opacityVertices.emplace_back(opacityVertex);
-                bucket.icon.opacityVertices.emplace_back(opacityVertex);
+                SymbolBucket::setOpacity(bucket.icon, iconVertexIndex, 4, opacityVertex);
+                iconVertexIndex += 4;
             }
             if (symbolInstance.placedIconIndex) {
                 bucket.icon.placedSymbols[*symbolInstance.placedIconIndex].hidden = opacityState.isHidden();
@@ -75,6 +75,11 @@ public:
     void setStale();
     
     const RetainedQueryData& getQueryData(uint32_t bucketInstanceId) const;
+
+    // The number of symbols that placeLayer() placed, and that it hid because they collided.
+    std::size_t getPlacedSymbolCount() const { return placedSymbols; }
+    std::size_t getCollidedSymbolCount() const { return collidedSymbols; }
+
 private:
 
     void placeLayerBucket(
@@ -101,6 +106,9 @@ private:
 
     TimePoint recentUntil;
     bool stale = false;
+
+    std::size_t placedSymbols = 0;
+    std::size_t collidedSymbols = 0;
     
     std::unordered_map<uint32_t, RetainedQueryData> retainedQueryData;
 };
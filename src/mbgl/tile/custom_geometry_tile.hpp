@@ -19,23 +19,22 @@ public:
     CustomGeometryTile(const OverscaledTileID&,
                std::string sourceID,
                const TileParameters&,
-               const style::CustomGeometrySource::TileOptions,
                ActorRef<style::CustomTileLoader> loader);
     ~CustomGeometryTile() override;
 
-    void setTileData(const GeoJSON& data);
+    // The features are shared with the other tiles of the same canonical tile.
+    void setTileData(std::shared_ptr<const mapbox::geometry::feature_collection<int16_t>>);
     void invalidateTileData();
 
     void setNecessity(TileNecessity) final;
 
     void querySourceFeatures(
-        std::vector<Feature>& result,
+        const std::function<void (const std::string& sourceLayer, Feature&&)>& callback,
         const SourceQueryOptions&) override;
 
 private:
     bool stale = true;
     TileNecessity necessity;
-    const style::CustomGeometrySource::TileOptions options;
     ActorRef<style::CustomTileLoader> loader;
     std::shared_ptr<Mailbox> mailbox;
     ActorRef<CustomGeometryTile> actorRef;
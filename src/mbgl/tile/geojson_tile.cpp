@@ -19,25 +19,11 @@ void GeoJSONTile::updateData(mapbox::geometry::feature_collection<int16_t> featu
 }
     
 void GeoJSONTile::querySourceFeatures(
-    std::vector<Feature>& result,
+    const std::function<void (const std::string&, Feature&&)>& callback,
     const SourceQueryOptions& options) {
-    
-    // Ignore the sourceLayer, there is only one
-    if (auto tileData = getData()) {
-        if (auto layer = tileData->getLayer({})) {
-            auto featureCount = layer->featureCount();
-            for (std::size_t i = 0; i < featureCount; i++) {
-                auto feature = layer->getFeature(i);
 
-                // Apply filter, if any
-                if (options.filter && !(*options.filter)(style::expression::EvaluationContext { static_cast<float>(this->id.overscaledZ), feature.get() })) {
-                    continue;
-                }
-
-                result.push_back(convertFeature(*feature, id.canonical));
-            }
-        }
-    }
+    // Ignore the sourceLayer, there is only one
+    querySourceLayer({}, callback, options);
 }
 
 } // namespace mbgl
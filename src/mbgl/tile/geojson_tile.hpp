@@ -17,7 +17,7 @@ public:
     void updateData(mapbox::geometry::feature_collection<int16_t>);
     
     void querySourceFeatures(
-        std::vector<Feature>& result,
+        const std::function<void (const std::string& sourceLayer, Feature&&)>& callback,
         const SourceQueryOptions&) override;
 };
 
@@ -18,6 +18,8 @@
 #include <mbgl/map/transform_state.hpp>
 #include <mbgl/style/filter_evaluator.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/trace.hpp>
 #include <mbgl/actor/scheduler.hpp>
 
 #include <iostream>
@@ -125,6 +127,8 @@ void GeometryTile::setShowCollisionBoxes(const bool showCollisionBoxes_) {
 }
 
 void GeometryTile::onLayout(LayoutResult result, const uint64_t resultCorrelationID) {
+    MBGL_TRACE_DETAIL(Event::ParseTile, "GeometryTile::onLayout", util::toString(id));
+
     loaded = true;
     renderable = true;
     if (resultCorrelationID == correlationID) {
@@ -213,7 +217,7 @@ float GeometryTile::getQueryPadding(const std::vector<const RenderLayer*>& layer
 }
 
 void GeometryTile::queryRenderedFeatures(
-    std::unordered_map<std::string, std::vector<Feature>>& result,
+    std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>& result,
     const GeometryCoordinates& queryGeometry,
     const TransformState& transformState,
     const std::vector<const RenderLayer*>& layers,
@@ -241,7 +245,7 @@ void GeometryTile::queryRenderedFeatures(
 }
 
 void GeometryTile::querySourceFeatures(
-    std::vector<Feature>& result,
+    const std::function<void (const std::string&, Feature&&)>& callback,
     const SourceQueryOptions& options) {
 
     // Data not yet available, or tile is empty
@@ -255,23 +259,53 @@ void GeometryTile::querySourceFeatures(
         return;
     }
 
-    for (auto sourceLayer : *options.sourceLayers) {
+    for (const auto& sourceLayer : *options.sourceLayers) {
         // Go throught all sourceLayers, if any
         // to gather all the features
-        auto layer = getData()->getLayer(sourceLayer);
-        
-        if (layer) {
-            auto featureCount = layer->featureCount();
-            for (std::size_t i = 0; i < featureCount; i++) {
-                auto feature = layer->getFeature(i);
-
-                // Apply filter, if any
-                if (options.filter && !(*options.filter)(style::expression::EvaluationContext { static_cast<float>(this->id.overscaledZ), feature.get() })) {
-                    continue;
-                }
-
-                result.push_back(convertFeature(*feature, id.canonical));
-            }
+        querySourceLayer(sourceLayer, callback, options);
+    }
+}
+
+void GeometryTile::querySourceLayer(
+    const std::string& sourceLayerName,
+    const std::function<void (const std::string&, Feature&&)>& callback,
+    const SourceQueryOptions& options) {
+
+    if (!getData()) {
+        return;
+    }
+
+    auto layer = getData()->getLayer(sourceLayerName);
+    if (!layer) {
+        return;
+    }
+
+    auto visit = [&](std::size_t i) {
+        auto feature = layer->getFeature(i);
+
+        // Apply filter, if any
+        if (options.filter && !(*options.filter)(style::expression::EvaluationContext { static_cast<float>(this->id.overscaledZ), feature.get() })) {
+            return;
+        }
+
+        callback(sourceLayerName, convertFeature(*feature, id.canonical));
+    };
+
+    if (options.bounds) {
+        // Bounds are given in unwrapped coordinates, so compare them with the canonical tile.
+        const UnwrappedTileID tileID(0, id.canonical);
+        const GeometryCoordinate min = TileCoordinate::toGeometryCoordinate(tileID, TileCoordinate::fromLatLng(0, options.bounds->northwest()).p);
+        const GeometryCoordinate max = TileCoordinate::toGeometryCoordinate(tileID, TileCoordinate::fromLatLng(0, options.bounds->southeast()).p);
+        if (min.x >= util::EXTENT || min.y >= util::EXTENT || max.x < 0 || max.y < 0) {
+            return;
+        }
+        for (std::size_t i : latestFeatureIndex->querySourceLayer(sourceLayerName, { min, max })) {
+            visit(i);
+        }
+    } else {
+        auto featureCount = layer->featureCount();
+        for (std::size_t i = 0; i < featureCount; i++) {
+            visit(i);
         }
     }
 }
@@ -50,7 +50,7 @@ public:
     Size bindIconAtlas(gl::Context&);
 
     void queryRenderedFeatures(
-            std::unordered_map<std::string, std::vector<Feature>>& result,
+            std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>& result,
             const GeometryCoordinates& queryGeometry,
             const TransformState&,
             const std::vector<const RenderLayer*>& layers,
@@ -58,7 +58,7 @@ public:
             const mat4& projMatrix) override;
 
     void querySourceFeatures(
-        std::vector<Feature>& result,
+        const std::function<void (const std::string& sourceLayer, Feature&&)>& callback,
         const SourceQueryOptions&) override;
 
     float getQueryPadding(const std::vector<const RenderLayer*>&) override;
@@ -97,6 +97,12 @@ protected:
         return latestFeatureIndex ? latestFeatureIndex->getData() : nullptr;
     }
 
+    // Passes the features of one source layer that match the filter and bounds of the options to
+    // the callback, using the feature index when bounds are given.
+    void querySourceLayer(const std::string& sourceLayerName,
+                          const std::function<void (const std::string& sourceLayer, Feature&&)>& callback,
+                          const SourceQueryOptions&);
+
 private:
     void markObsolete();
 
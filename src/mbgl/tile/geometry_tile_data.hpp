@@ -78,6 +78,11 @@ void limitHoles(GeometryCollection&, uint32_t maxHoles);
 // convert from GeometryTileFeature to Feature (eventually we should eliminate GeometryTileFeature)
 Feature convertFeature(const GeometryTileFeature&, const CanonicalTileID&);
 
+// Like convertFeature(), but copies only the named properties (all of them when not set), and
+// leaves the geometry default-constructed unless `geometry` is true.
+Feature convertFeature(const GeometryTileFeature&, const CanonicalTileID&,
+                       const optional<std::vector<std::string>>& properties, bool geometry);
+
 // Fix up possibly-non-V2-compliant polygon geometry using angus clipper.
 // The result is guaranteed to have correctly wound, strictly simple rings.
 GeometryCollection fixupPolygons(const GeometryCollection&);
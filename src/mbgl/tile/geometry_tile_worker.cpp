@@ -6,6 +6,7 @@
 #include <mbgl/renderer/group_by_layout.hpp>
 #include <mbgl/style/filter.hpp>
 #include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/style/expression/feature_batch.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
@@ -13,6 +14,7 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/exception.hpp>
+#include <mbgl/util/trace.hpp>
 
 #include <unordered_set>
 
@@ -20,6 +22,9 @@ namespace mbgl {
 
 using namespace style;
 
+// The number of features of a source layer that are added to a bucket together.
+static constexpr std::size_t featureBatchSize = 256;
+
 GeometryTileWorker::GeometryTileWorker(ActorRef<GeometryTileWorker> self_,
                                        ActorRef<GeometryTile> parent_,
                                        OverscaledTileID id_,
@@ -320,6 +325,8 @@ void GeometryTileWorker::parse() {
         return;
     }
 
+    MBGL_TRACE_DETAIL(Event::ParseTile, "GeometryTileWorker::parse", util::toString(id));
+
     std::vector<std::string> symbolOrder;
     for (auto it = layers->rbegin(); it != layers->rend(); it++) {
         if ((*it)->type == LayerType::Symbol) {
@@ -372,15 +379,34 @@ void GeometryTileWorker::parse() {
             const std::string& sourceLayerID = leader.baseImpl->sourceLayer;
             std::shared_ptr<Bucket> bucket = leader.createBucket(parameters, group);
 
-            for (std::size_t i = 0; !obsolete && i < geometryLayer->featureCount(); i++) {
-                std::unique_ptr<GeometryTileFeature> feature = geometryLayer->getFeature(i);
-
-                if (!filter(expression::EvaluationContext { static_cast<float>(this->id.overscaledZ), feature.get() }))
-                    continue;
-
-                GeometryCollection geometries = feature->getGeometries();
-                bucket->addFeature(*feature, geometries);
-                featureIndex->insert(geometries, i, sourceLayerID, leader.getID());
+            // Evaluate data-driven paint properties for batches of features at once. Batches have a
+            // fixed size, so that only a limited number of decoded features is held at a time.
+            std::size_t i = 0;
+            while (!obsolete && i < geometryLayer->featureCount()) {
+                std::vector<std::unique_ptr<GeometryTileFeature>> features;
+                std::vector<std::size_t> featureIndices;
+                for (; !obsolete && i < geometryLayer->featureCount() && features.size() < featureBatchSize; i++) {
+                    std::unique_ptr<GeometryTileFeature> feature = geometryLayer->getFeature(i);
+
+                    if (!filter(expression::EvaluationContext { static_cast<float>(this->id.overscaledZ), feature.get() }))
+                        continue;
+
+                    features.push_back(std::move(feature));
+                    featureIndices.push_back(i);
+                }
+
+                std::vector<const GeometryTileFeature*> batchFeatures;
+                batchFeatures.reserve(features.size());
+                for (const auto& feature : features) {
+                    batchFeatures.push_back(feature.get());
+                }
+                bucket->prepare(expression::FeatureBatch(std::move(batchFeatures)));
+
+                for (std::size_t j = 0; !obsolete && j < features.size(); j++) {
+                    GeometryCollection geometries = features[j]->getGeometries();
+                    bucket->addFeature(*features[j], geometries);
+                    featureIndex->insert(geometries, featureIndices[j], sourceLayerID, leader.getID());
+                }
             }
 
             if (!bucket->hasData()) {
@@ -424,7 +450,9 @@ void GeometryTileWorker::performSymbolLayout() {
     if (!data || !layers || !hasPendingParseResult() || hasPendingSymbolDependencies()) {
         return;
     }
-    
+
+    MBGL_TRACE_DETAIL(Event::ParseTile, "GeometryTileWorker::performSymbolLayout", util::toString(id));
+
     optional<AlphaImage> glyphAtlasImage;
     optional<PremultipliedImage> iconAtlasImage;
 
@@ -33,7 +33,7 @@ void Tile::dumpDebugLogs() const {
 }
 
 void Tile::queryRenderedFeatures(
-        std::unordered_map<std::string, std::vector<Feature>>&,
+        std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>&,
         const GeometryCoordinates&,
         const TransformState&,
         const std::vector<const RenderLayer*>&,
@@ -45,7 +45,7 @@ float Tile::getQueryPadding(const std::vector<const RenderLayer*>&) {
 }
 
 void Tile::querySourceFeatures(
-        std::vector<Feature>&,
+        const std::function<void (const std::string&, Feature&&)>&,
         const SourceQueryOptions&) {}
 
 } // namespace mbgl
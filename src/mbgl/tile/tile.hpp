@@ -8,6 +8,7 @@
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/tile/tile_necessity.hpp>
 #include <mbgl/renderer/tile_mask.hpp>
+#include <mbgl/renderer/query.hpp>
 #include <mbgl/renderer/bucket.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/storage/resource.hpp>
@@ -53,15 +54,17 @@ public:
     virtual void setMask(TileMask&&) {}
 
     virtual void queryRenderedFeatures(
-            std::unordered_map<std::string, std::vector<Feature>>& result,
+            std::unordered_map<std::string, std::vector<RenderedFeatureHandle>>& result,
             const GeometryCoordinates& queryGeometry,
             const TransformState&,
             const std::vector<const RenderLayer*>&,
             const RenderedQueryOptions& options,
             const mat4& projMatrix);
 
+    // Passes each matching feature to the callback, along with the name of the source layer
+    // it was found in. Sources with a single layer pass an empty name.
     virtual void querySourceFeatures(
-            std::vector<Feature>& result,
+            const std::function<void (const std::string& sourceLayer, Feature&&)>& callback,
             const SourceQueryOptions&);
 
     virtual float getQueryPadding(const std::vector<const RenderLayer*>&);
@@ -6,6 +6,7 @@
 #include <zlib.h>
 #endif
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <stdexcept>
@@ -31,12 +32,12 @@ namespace util {
 // cause a link error.
 #undef compress
 
-std::string compress(const std::string &raw) {
+std::string compress(const std::string &raw, int level) {
     z_stream deflate_stream;
     memset(&deflate_stream, 0, sizeof(deflate_stream));
 
     // TODO: reuse z_streams
-    if (deflateInit(&deflate_stream, Z_DEFAULT_COMPRESSION) != Z_OK) {
+    if (deflateInit(&deflate_stream, level) != Z_OK) {
         throw std::runtime_error("failed to initialize deflate");
     }
 
@@ -100,5 +101,195 @@ std::string decompress(const std::string &raw) {
 
     return result;
 }
+
+// The fast codec stores the decompressed size as a varint, followed by LZ4-style sequences.
+// Each sequence is a token byte whose high nibble is the literal length and whose low nibble
+// is the match length minus the minimum match length, with 15 meaning that the length
+// continues in following bytes (each adding up to 255). The literals follow the token, then
+// a 16-bit little-endian match offset and the continuation of the match length. The final
+// sequence consists of literals only.
+namespace {
+
+constexpr std::size_t fastMinMatch = 4;
+constexpr std::size_t fastMaxOffset = 0xFFFF;
+constexpr std::size_t fastHashBits = 12;
+
+inline uint32_t read32(const char* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint32_t fastHash(uint32_t value) {
+    return (value * 2654435761u) >> (32 - fastHashBits);
+}
+
+void writeLength(std::string& out, std::size_t length) {
+    while (length >= 255) {
+        out.push_back(char(255));
+        length -= 255;
+    }
+    out.push_back(char(length));
+}
+
+void writeSequence(std::string& out, const char* literals, std::size_t literalLength,
+                   std::size_t offset, std::size_t matchLength) {
+    const bool hasMatch = matchLength != 0;
+    const std::size_t matchCode = hasMatch ? matchLength - fastMinMatch : 0;
+
+    out.push_back(char(((literalLength < 15 ? literalLength : 15) << 4) | (matchCode < 15 ? matchCode : 15)));
+    if (literalLength >= 15) {
+        writeLength(out, literalLength - 15);
+    }
+    out.append(literals, literalLength);
+
+    if (hasMatch) {
+        out.push_back(char(offset & 0xFF));
+        out.push_back(char(offset >> 8));
+        if (matchCode >= 15) {
+            writeLength(out, matchCode - 15);
+        }
+    }
+}
+
+std::size_t readLength(const unsigned char*& in, const unsigned char* end) {
+    std::size_t length = 0;
+    unsigned char byte;
+    do {
+        if (in == end) {
+            throw std::runtime_error("truncated fast compressed data");
+        }
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+    return length;
+}
+
+} // namespace
+
+std::string compressFast(const std::string& raw) {
+    std::string result;
+    result.reserve(raw.size() / 2 + 16);
+
+    for (uint64_t size = raw.size(); ; size >>= 7) {
+        if (size < 0x80) {
+            result.push_back(char(size));
+            break;
+        }
+        result.push_back(char((size & 0x7F) | 0x80));
+    }
+
+    const char* const begin = raw.data();
+    const char* const end = begin + raw.size();
+    const char* anchor = begin;
+
+    if (raw.size() > fastMinMatch) {
+        // Positions of the most recent occurrence of each hashed 4-byte sequence, or 0 for none.
+        uint32_t table[1 << fastHashBits] = {};
+        const char* const matchLimit = end - fastMinMatch;
+        const char* in = begin + 1;
+
+        while (in <= matchLimit) {
+            const uint32_t value = read32(in);
+            const uint32_t hash = fastHash(value);
+            const char* candidate = begin + table[hash];
+            table[hash] = uint32_t(in - begin);
+
+            if (candidate >= in || std::size_t(in - candidate) > fastMaxOffset || read32(candidate) != value) {
+                in++;
+                continue;
+            }
+
+            // Extend the match backwards over pending literals, then forwards.
+            while (in > anchor && candidate > begin && in[-1] == candidate[-1]) {
+                in--;
+                candidate--;
+            }
+
+            const char* matchEnd = in + fastMinMatch;
+            const char* candidateEnd = candidate + fastMinMatch;
+            while (matchEnd < end && *matchEnd == *candidateEnd) {
+                matchEnd++;
+                candidateEnd++;
+            }
+
+            writeSequence(result, anchor, std::size_t(in - anchor), std::size_t(in - candidate),
+                          std::size_t(matchEnd - in));
+            anchor = in = matchEnd;
+        }
+    }
+
+    writeSequence(result, anchor, std::size_t(end - anchor), 0, 0);
+    return result;
+}
+
+std::string decompressFast(const std::string& raw) {
+    const auto* in = reinterpret_cast<const unsigned char*>(raw.data());
+    const auto* const end = in + raw.size();
+
+    uint64_t size = 0;
+    for (unsigned shift = 0; ; shift += 7) {
+        if (in == end || shift > 63) {
+            throw std::runtime_error("invalid fast compressed data header");
+        }
+        const unsigned char byte = *in++;
+        size |= uint64_t(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+
+    // Each input byte produces at most a few hundred output bytes, which bounds the reservation
+    // for corrupt headers.
+    std::string result;
+    result.reserve(std::min<uint64_t>(size, uint64_t(raw.size()) * 256));
+
+    while (in != end) {
+        const unsigned char token = *in++;
+
+        std::size_t literalLength = token >> 4;
+        if (literalLength == 15) {
+            literalLength += readLength(in, end);
+        }
+        if (std::size_t(end - in) < literalLength || result.size() + literalLength > size) {
+            throw std::runtime_error("corrupt fast compressed data");
+        }
+        result.append(reinterpret_cast<const char*>(in), literalLength);
+        in += literalLength;
+
+        if (in == end) {
+            break;
+        }
+
+        if (end - in < 2) {
+            throw std::runtime_error("truncated fast compressed data");
+        }
+        const std::size_t offset = std::size_t(in[0]) | (std::size_t(in[1]) << 8);
+        in += 2;
+
+        std::size_t matchLength = token & 0x0F;
+        if (matchLength == 15) {
+            matchLength += readLength(in, end);
+        }
+        matchLength += fastMinMatch;
+
+        if (offset == 0 || offset > result.size() || result.size() + matchLength > size) {
+            throw std::runtime_error("corrupt fast compressed data");
+        }
+
+        // Matches may overlap the bytes they produce, so copy one byte at a time.
+        std::size_t from = result.size() - offset;
+        for (std::size_t i = 0; i < matchLength; i++) {
+            result.push_back(result[from + i]);
+        }
+    }
+
+    if (result.size() != size) {
+        throw std::runtime_error("truncated fast compressed data");
+    }
+
+    return result;
+}
+
 } // namespace util
 } // namespace mbgl
@@ -299,5 +299,6 @@ bool GridIndex<T>::empty() const {
 
 
 template class GridIndex<IndexedSubfeature>;
+template class GridIndex<std::size_t>;
 
 } // namespace mbgl
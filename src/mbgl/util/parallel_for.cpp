@@ -0,0 +1,74 @@
+#include <mbgl/util/parallel_for.hpp>
+#include <mbgl/actor/mailbox.hpp>
+#include <mbgl/actor/message.hpp>
+
+#include <exception>
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+class Call {
+public:
+    Call(const std::function<void(std::size_t)>& fn_, std::size_t i_)
+        : fn(fn_), i(i_) {}
+
+    // Worker threads don't expect messages to throw, so exceptions are kept for the caller.
+    void run() {
+        try {
+            fn(i);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        done = true;
+    }
+
+    const std::function<void(std::size_t)>& fn;
+    const std::size_t i;
+    bool done = false;
+    std::exception_ptr error;
+};
+
+} // namespace
+
+void parallelFor(Scheduler& scheduler, std::size_t count, const std::function<void(std::size_t)>& fn) {
+    if (count == 0) {
+        return;
+    } else if (count == 1) {
+        fn(0);
+        return;
+    }
+
+    std::vector<Call> calls;
+    calls.reserve(count);
+    std::vector<std::shared_ptr<Mailbox>> mailboxes;
+    mailboxes.reserve(count);
+
+    for (std::size_t i = 0; i < count; i++) {
+        calls.emplace_back(fn, i);
+        mailboxes.push_back(std::make_shared<Mailbox>(scheduler));
+        mailboxes.back()->push(actor::makeMessage(calls.back(), &Call::run));
+    }
+
+    // The scheduler works from the front of its queue, so start at the back. Closing a mailbox
+    // waits for a call that is in progress, and prevents calls that haven't started yet from
+    // running on the scheduler; we run those here instead.
+    for (std::size_t i = count; i-- > 0;) {
+        mailboxes[i]->close();
+        if (!calls[i].done) {
+            calls[i].run();
+        }
+    }
+
+    for (const auto& call : calls) {
+        if (call.error) {
+            std::rethrow_exception(call.error);
+        }
+    }
+}
+
+} // namespace util
+} // namespace mbgl
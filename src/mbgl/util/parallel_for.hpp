@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace mbgl {
+
+class Scheduler;
+
+namespace util {
+
+// Calls fn(i) for every i in [0, count), spreading the calls over the threads of the
+// scheduler. The calling thread runs every call that no thread has picked up by the
+// time it gets to it, so this doesn't depend on the scheduler having idle threads, and
+// can be nested. Returns once all calls have finished.
+//
+// Calls may run concurrently, so fn must not touch state that is shared between calls.
+// If calls throw, the remaining calls still run, and the exception thrown by the call with
+// the lowest index is rethrown on the calling thread.
+void parallelFor(Scheduler&, std::size_t count, const std::function<void(std::size_t)>& fn);
+
+} // namespace util
+} // namespace mbgl
@@ -2,9 +2,65 @@
 
 #include <cmath>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace mbgl {
 namespace util {
 
+// (c * a + 127) / 255, computed without a division. This is exact for all 8 bit c and a.
+static inline uint8_t premultiplyChannel(uint32_t c, uint32_t a) {
+    const uint32_t x = c * a + 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+void premultiply(uint8_t* data, std::size_t count) {
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    // Four pixels per iteration, two per 16 bit half. The alpha lanes are multiplied by 255,
+    // which leaves them unchanged.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    const __m128i alphaFactor = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i bias = _mm_set1_epi16(128);
+    for (; i + 4 <= count; i += 4) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 4));
+        __m128i result[2];
+        for (int half = 0; half < 2; half++) {
+            const __m128i c = half ? _mm_unpackhi_epi8(pixels, zero) : _mm_unpacklo_epi8(pixels, zero);
+            __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(c, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            a = _mm_or_si128(_mm_and_si128(a, rgbMask), alphaFactor);
+            const __m128i x = _mm_add_epi16(_mm_mullo_epi16(c, a), bias);
+            result[half] = _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i * 4), _mm_packus_epi16(result[0], result[1]));
+    }
+#elif defined(__ARM_NEON)
+    // Eight pixels per iteration, deinterleaved into one register per channel.
+    const uint16x8_t bias = vdupq_n_u16(128);
+    for (; i + 8 <= count; i += 8) {
+        uint8x8x4_t pixels = vld4_u8(data + i * 4);
+        for (int channel = 0; channel < 3; channel++) {
+            const uint16x8_t x = vaddq_u16(vmull_u8(pixels.val[channel], pixels.val[3]), bias);
+            pixels.val[channel] = vshrn_n_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), 8);
+        }
+        vst4_u8(data + i * 4, pixels);
+    }
+#endif
+
+    for (; i < count; i++) {
+        uint8_t* pixel = data + i * 4;
+        const uint8_t a = pixel[3];
+        pixel[0] = premultiplyChannel(pixel[0], a);
+        pixel[1] = premultiplyChannel(pixel[1], a);
+        pixel[2] = premultiplyChannel(pixel[2], a);
+    }
+}
+
 PremultipliedImage premultiply(UnassociatedImage&& src) {
     PremultipliedImage dst;
 
@@ -12,16 +68,7 @@ PremultipliedImage premultiply(UnassociatedImage&& src) {
     src.size = { 0, 0 };
     dst.data = std::move(src.data);
 
-    uint8_t* data = dst.data.get();
-    for (size_t i = 0; i < dst.bytes(); i += 4) {
-        uint8_t& r = data[i + 0];
-        uint8_t& g = data[i + 1];
-        uint8_t& b = data[i + 2];
-        uint8_t& a = data[i + 3];
-        r = (r * a + 127) / 255;
-        g = (g * a + 127) / 255;
-        b = (b * a + 127) / 255;
-    }
+    premultiply(dst.data.get(), dst.bytes() / 4);
 
     return dst;
 }
@@ -3,6 +3,7 @@
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/trace.hpp>
 
 #include <iostream>
 #include <atomic>
@@ -23,7 +24,12 @@ stopwatch::stopwatch(std::string name_, EventSeverity severity_, Event event_)
     : name(std::move(name_)), severity(severity_), event(event_), start(Clock::now()) {}
 
 void stopwatch::report(const std::string &name_) {
-    Duration duration = Clock::now() - start;
+    const TimePoint now = Clock::now();
+    Duration duration = now - start;
+
+    if (Trace::isRecording()) {
+        Trace::record(event, name_, start, now);
+    }
 
     Log::Record(severity, event, "%s: %fms", name_.c_str(), std::chrono::duration<float, std::chrono::milliseconds::period>(duration).count());
     start += duration;
@@ -0,0 +1,188 @@
+#include <mbgl/util/trace.hpp>
+#include <mbgl/util/enum.hpp>
+#include <mbgl/util/platform.hpp>
+
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+std::atomic<bool> Trace::recording { false };
+
+namespace {
+
+class TraceEvent {
+public:
+    Event event;
+    bool async;
+    std::string name;
+    std::string detail;
+    TimePoint begin;
+    TimePoint end;
+    std::size_t thread;
+};
+
+class TraceThread {
+public:
+    std::thread::id id;
+    std::string name;
+};
+
+class TraceLog {
+public:
+    std::mutex mutex;
+    TimePoint start;
+    std::vector<TraceEvent> events;
+    std::vector<TraceThread> threads;
+
+    // Returns the number of the current thread, naming it the first time it's seen.
+    std::size_t currentThread() {
+        const auto id = std::this_thread::get_id();
+        for (std::size_t i = 0; i < threads.size(); i++) {
+            if (threads[i].id == id) {
+                return i + 1;
+            }
+        }
+        threads.push_back({ id, platform::getCurrentThreadName() });
+        return threads.size();
+    }
+
+    void record(Event event, bool async, std::string&& name, std::string&& detail, TimePoint begin, TimePoint end) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (Trace::isRecording()) {
+            events.push_back({ event, async, std::move(name), std::move(detail), begin, end, currentThread() });
+        }
+    }
+};
+
+TraceLog& traceLog() {
+    // Never destroyed, so that threads can still record while static objects are destroyed.
+    static auto* log = new TraceLog();
+    return *log;
+}
+
+} // namespace
+
+void Trace::start() {
+    auto& log = traceLog();
+    std::lock_guard<std::mutex> lock(log.mutex);
+    log.events.clear();
+    log.threads.clear();
+    log.start = Clock::now();
+    recording = true;
+}
+
+void Trace::stop() {
+    auto& log = traceLog();
+    std::lock_guard<std::mutex> lock(log.mutex);
+    recording = false;
+}
+
+void Trace::record(Event event, std::string name, TimePoint begin, TimePoint end, std::string detail) {
+    traceLog().record(event, false, std::move(name), std::move(detail), begin, end);
+}
+
+void Trace::recordAsync(Event event, std::string name, TimePoint begin, TimePoint end, std::string detail) {
+    traceLog().record(event, true, std::move(name), std::move(detail), begin, end);
+}
+
+std::string Trace::toChromeTraceJSON() {
+    auto& log = traceLog();
+    std::lock_guard<std::mutex> lock(log.mutex);
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+
+    // Timestamps are in microseconds since the start of the recording.
+    auto timestamp = [&] (TimePoint time) {
+        return std::chrono::duration<double, std::micro>(time - log.start).count();
+    };
+
+    auto writeCommon = [&] (const TraceEvent& event, const char* phase, TimePoint time) {
+        writer.Key("name");
+        writer.String(event.name);
+        writer.Key("cat");
+        writer.String(Enum<Event>::toString(event.event));
+        writer.Key("ph");
+        writer.String(phase);
+        writer.Key("ts");
+        writer.Double(timestamp(time));
+        writer.Key("pid");
+        writer.Uint(1);
+        writer.Key("tid");
+        writer.Uint64(event.thread);
+    };
+
+    auto writeDetail = [&] (const TraceEvent& event) {
+        if (!event.detail.empty()) {
+            writer.Key("args");
+            writer.StartObject();
+            writer.Key("detail");
+            writer.String(event.detail);
+            writer.EndObject();
+        }
+    };
+
+    writer.StartObject();
+    writer.Key("displayTimeUnit");
+    writer.String("ms");
+    writer.Key("traceEvents");
+    writer.StartArray();
+
+    for (std::size_t i = 0; i < log.threads.size(); i++) {
+        writer.StartObject();
+        writer.Key("name");
+        writer.String("thread_name");
+        writer.Key("ph");
+        writer.String("M");
+        writer.Key("pid");
+        writer.Uint(1);
+        writer.Key("tid");
+        writer.Uint64(i + 1);
+        writer.Key("args");
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(log.threads[i].name);
+        writer.EndObject();
+        writer.EndObject();
+    }
+
+    uint64_t asyncID = 0;
+    for (const auto& event : log.events) {
+        if (event.async) {
+            // Async events are written as a pair of begin and end events with a shared ID.
+            asyncID++;
+            writer.StartObject();
+            writeCommon(event, "b", event.begin);
+            writer.Key("id");
+            writer.Uint64(asyncID);
+            writeDetail(event);
+            writer.EndObject();
+
+            writer.StartObject();
+            writeCommon(event, "e", event.end);
+            writer.Key("id");
+            writer.Uint64(asyncID);
+            writer.EndObject();
+        } else {
+            writer.StartObject();
+            writeCommon(event, "X", event.begin);
+            writer.Key("dur");
+            writer.Double(std::chrono::duration<double, std::micro>(event.end - event.begin).count());
+            writeDetail(event);
+            writer.EndObject();
+        }
+    }
+
+    writer.EndArray();
+    writer.EndObject();
+
+    return buffer.GetString();
+}
+
+} // namespace mbgl
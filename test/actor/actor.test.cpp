@@ -3,10 +3,13 @@
 
 #include <mbgl/test/util.hpp>
 
+#include <array>
 #include <chrono>
 #include <functional>
 #include <future>
 #include <memory>
+#include <thread>
+#include <vector>
 
 using namespace mbgl;
 using namespace std::chrono_literals;
@@ -282,6 +285,45 @@ TEST(Actor, NonConcurrentMailbox) {
     endedFuture.wait();
 }
 
+TEST(Actor, OrderedMailboxConcurrentSenders) {
+    // Messages from each sender are processed in the order sent, even when
+    // several threads send at the same time.
+
+    struct Test {
+        std::array<int, 4> last {{ 0, 0, 0, 0 }};
+
+        Test(ActorRef<Test>) {}
+
+        void receive(std::size_t sender, int i) {
+            EXPECT_EQ(i, last[sender] + 1);
+            last[sender] = i;
+        }
+
+        int sum() {
+            return last[0] + last[1] + last[2] + last[3];
+        }
+    };
+
+    ThreadPool pool { 2 };
+    Actor<Test> test(pool);
+
+    std::vector<std::thread> senders;
+    for (std::size_t sender = 0; sender < 4; ++sender) {
+        senders.emplace_back([&, sender] {
+            auto ref = test.self();
+            for (auto i = 1; i <= 1000; ++i) {
+                ref.invoke(&Test::receive, sender, i);
+            }
+        });
+    }
+
+    for (auto& sender : senders) {
+        sender.join();
+    }
+
+    EXPECT_EQ(4000, test.ask(&Test::sum).get());
+}
+
 TEST(Actor, Ask) {
     // Asking for a result
 
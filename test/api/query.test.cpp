@@ -47,6 +47,22 @@ TEST(Query, QueryRenderedFeatures) {
     EXPECT_EQ(features2.size(), 0u);
 }
 
+TEST(Query, QueryRenderedFeatureHandles) {
+    QueryTest test;
+
+    auto zz = test.map.pixelForLatLng({ 0, 0 });
+    auto features = test.frontend.getRenderer()->queryRenderedFeatures(zz);
+    auto handles = test.frontend.getRenderer()->queryRenderedFeatureHandles(zz);
+    ASSERT_EQ(features.size(), handles.size());
+
+    auto converted = test.frontend.getRenderer()->getFeatures(handles);
+    ASSERT_EQ(features.size(), converted.size());
+    for (std::size_t i = 0; i < features.size(); i++) {
+        EXPECT_TRUE(features[i].id == converted[i].id);
+        EXPECT_TRUE(features[i].properties == converted[i].properties);
+    }
+}
+
 TEST(Query, QueryRenderedFeaturesFilterLayer) {
     QueryTest test;
 
@@ -122,3 +138,73 @@ TEST(Query, QuerySourceFeaturesFilter) {
     EXPECT_EQ(features3.size(), 1u);
 }
 
+TEST(Query, QuerySourceFeaturesBounds) {
+    QueryTest test;
+
+    const EqualsFilter eqFilter = { "key1", std::string("value1") };
+    auto features1 = test.frontend.getRenderer()->querySourceFeatures("source4",
+        {{}, { eqFilter }, LatLngBounds::hull({ -1, -1 }, { 1, 1 })});
+    ASSERT_EQ(features1.size(), 1u);
+    EXPECT_TRUE(features1[0].id == FeatureIdentifier(std::string("feature1")));
+
+    auto features2 = test.frontend.getRenderer()->querySourceFeatures("source4",
+        {{}, {}, LatLngBounds::hull({ 10, 10 }, { 20, 20 })});
+    EXPECT_EQ(features2.size(), 0u);
+
+    std::size_t count = 0;
+    test.frontend.getRenderer()->querySourceFeatures("source4", {{}, {}, LatLngBounds::hull({ -1, -1 }, { 1, 1 })},
+        [&](Feature&& feature) {
+            EXPECT_TRUE(feature.id == FeatureIdentifier(std::string("feature1")));
+            count++;
+        });
+    EXPECT_EQ(count, 1u);
+}
+
+TEST(Query, QuerySourceFeaturesBoundsSharedIDs) {
+    QueryTest test;
+
+    // Source layer "a" has features 1, 2 and another part of 1; "b" has features 1 and 2.
+    test.fileSource.tileResponse = [&](const Resource&) {
+        Response response;
+        response.data = std::make_shared<std::string>(
+            util::read_file("test/fixtures/api/assets/shared_ids.vector.pbf"));
+        return response;
+    };
+    test.map.getStyle().loadJSON(R"STYLE({
+      "version": 8,
+      "sources": {
+        "vector": { "type": "vector", "tiles": [ "shared_ids/{z}-{x}-{y}" ], "maxzoom": 0 }
+      },
+      "layers": [{ "id": "circle", "type": "circle", "source": "vector", "source-layer": "a" }]
+    })STYLE");
+    test.frontend.render(test.map);
+
+    auto features = test.frontend.getRenderer()->querySourceFeatures("vector",
+        {{{ "a", "b" }}, {}, LatLngBounds::hull({ -1, -1 }, { 1, 1 })});
+    ASSERT_EQ(features.size(), 4u);
+    EXPECT_TRUE(features[0].id == FeatureIdentifier(uint64_t(1)));
+    EXPECT_TRUE(features[1].id == FeatureIdentifier(uint64_t(2)));
+    EXPECT_TRUE(features[2].id == FeatureIdentifier(uint64_t(1)));
+    EXPECT_TRUE(features[3].id == FeatureIdentifier(uint64_t(2)));
+}
+
+TEST(Query, QueryRenderedFeaturesProperties) {
+    QueryTest test;
+
+    auto zz = test.map.pixelForLatLng({ 0, 0 });
+
+    RenderedQueryOptions options {{}, { EqualsFilter { "key1", std::string("value1") } }};
+    options.properties = {{ "key2", "missing" }};
+    options.geometry = false;
+    auto features1 = test.frontend.getRenderer()->queryRenderedFeatures(zz, options);
+    ASSERT_EQ(features1.size(), 1u);
+    EXPECT_TRUE(features1[0].id == FeatureIdentifier(std::string("feature1")));
+    ASSERT_EQ(features1[0].properties.size(), 1u);
+    EXPECT_TRUE(features1[0].properties.at("key2") == Value(1.5));
+
+    options.properties = std::vector<std::string>();
+    auto features2 = test.frontend.getRenderer()->queryRenderedFeatures(zz, options);
+    ASSERT_EQ(features2.size(), 1u);
+    EXPECT_TRUE(features2[0].id == FeatureIdentifier(std::string("feature1")));
+    EXPECT_TRUE(features2[0].properties.empty());
+}
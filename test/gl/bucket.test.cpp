@@ -98,8 +98,18 @@ TEST(Buckets, LineBucket) {
     ASSERT_TRUE(bucket.hasData());
     ASSERT_TRUE(bucket.needsUpload());
 
+    const std::size_t vertexCount = bucket.vertices.vertexSize();
+    const std::size_t indexCount = bucket.triangles.indexSize();
+
     bucket.upload(context);
     ASSERT_FALSE(bucket.needsUpload());
+
+    // Small buckets hand their geometry over to be drawn together with other tiles.
+    ASSERT_TRUE(bucket.batchGeometry);
+    EXPECT_EQ(vertexCount, bucket.batchGeometry->vertices.vertexSize());
+    EXPECT_EQ(indexCount, bucket.batchGeometry->triangles.indexSize());
+    EXPECT_EQ(vertexCount, bucket.vertexBuffer->vertexCount);
+    EXPECT_EQ(indexCount, bucket.indexBuffer->indexCount);
 }
 
 TEST(Buckets, SymbolBucket) {
@@ -135,6 +145,43 @@ TEST(Buckets, SymbolBucket) {
     ASSERT_FALSE(bucket.needsUpload());
 }
 
+TEST(Buckets, SymbolBucketOpacity) {
+    HeadlessBackend backend({ 512, 256 });
+    BackendScope scope { backend };
+
+    style::SymbolLayoutProperties::PossiblyEvaluated layout;
+    std::vector<SymbolInstance> symbolInstances;
+
+    gl::Context context;
+    SymbolBucket bucket { layout, {}, 16.0f, 1.0f, 0, false, false, false, std::move(symbolInstances) };
+    bucket.text.segments.emplace_back(0, 0);
+    for (std::size_t i = 0; i < 400; i++) {
+        bucket.text.opacityVertices.emplace_back(SymbolOpacityAttributes::vertex(true, 1.0));
+    }
+
+    // Opacity is tracked before the first upload, which uploads all vertices.
+    SymbolBucket::setOpacity(bucket.text, 0, 4, SymbolOpacityAttributes::vertex(false, 0.0));
+    bucket.upload(context);
+    EXPECT_TRUE(bucket.text.opacityChanges.empty());
+    EXPECT_EQ(400u, bucket.text.opacityVertices.vertexSize());
+
+    // Unchanged vertices aren't recorded; nearby changes are merged into one update.
+    SymbolBucket::setOpacity(bucket.text, 8, 8, SymbolOpacityAttributes::vertex(true, 1.0));
+    EXPECT_TRUE(bucket.text.opacityChanges.empty());
+    SymbolBucket::setOpacity(bucket.text, 8, 4, SymbolOpacityAttributes::vertex(false, 0.5));
+    SymbolBucket::setOpacity(bucket.text, 20, 4, SymbolOpacityAttributes::vertex(false, 0.5));
+    SymbolBucket::setOpacity(bucket.text, 200, 4, SymbolOpacityAttributes::vertex(false, 0.5));
+    ASSERT_EQ(2u, bucket.text.opacityChanges.size());
+    EXPECT_EQ(std::make_pair(std::size_t(8), std::size_t(24)), bucket.text.opacityChanges[0]);
+    EXPECT_EQ(std::make_pair(std::size_t(200), std::size_t(204)), bucket.text.opacityChanges[1]);
+
+    bucket.updateOpacity();
+    ASSERT_TRUE(bucket.needsUpload());
+    bucket.upload(context);
+    EXPECT_TRUE(bucket.text.opacityChanges.empty());
+    ASSERT_FALSE(bucket.needsUpload());
+}
+
 TEST(Buckets, RasterBucket) {
     HeadlessBackend backend({ 512, 256 });
     BackendScope scope { backend };
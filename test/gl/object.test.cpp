@@ -3,6 +3,9 @@
 #include <mbgl/renderer/backend_scope.hpp>
 #include <mbgl/gl/headless_backend.hpp>
 #include <mbgl/gl/context.hpp>
+#include <mbgl/programs/background_program.hpp>
+#include <mbgl/programs/segment.hpp>
+#include <mbgl/util/image.hpp>
 
 #include <memory>
 
@@ -63,3 +66,53 @@ TEST(GLObject, Store) {
     context.reset();
     EXPECT_TRUE(context.empty());
 }
+
+TEST(GLObject, Memory) {
+    HeadlessBackend backend { { 256, 256 } };
+    BackendScope scope { backend };
+
+    gl::Context context;
+    EXPECT_EQ(0u, context.getBufferMemory());
+    EXPECT_EQ(0u, context.getTextureMemory());
+
+    {
+        using Vertex = gl::detail::Vertex<gl::Attribute<int16_t, 2>>;
+        gl::VertexVector<Vertex> vertices;
+        vertices.emplace_back(Vertex { {{ 0, 0 }} });
+        vertices.emplace_back(Vertex { {{ 1, 1 }} });
+        auto buffer = context.createVertexBuffer(std::move(vertices));
+        EXPECT_EQ(8u, context.getBufferMemory());
+        EXPECT_EQ(8u, context.uploadedVertexBytes);
+
+        auto texture = context.createTexture({ 16, 8 });
+        EXPECT_EQ(16u * 8 * 4, context.getTextureMemory());
+
+        context.updateTexture(texture, AlphaImage({ 4, 4 }));
+        EXPECT_EQ(16u, context.getTextureMemory());
+    }
+
+    EXPECT_EQ(0u, context.getBufferMemory());
+    EXPECT_EQ(0u, context.getTextureMemory());
+    context.reset();
+}
+
+TEST(GLObject, SegmentVertexArrays) {
+    HeadlessBackend backend { { 256, 256 } };
+    BackendScope scope { backend };
+
+    gl::Context context;
+    Segment<BackgroundAttributes> segment { 0, 0 };
+
+    segment.vertexArray(context, 3);
+    EXPECT_EQ(4u, segment.vertexArrays.size());
+    segment.vertexArray(context, 1);
+    EXPECT_EQ(4u, segment.vertexArrays.size());
+
+    // Vertex arrays cached for the indices of removed layers aren't reused.
+    context.releaseSegmentVertexArrays();
+    segment.vertexArray(context, 1);
+    EXPECT_EQ(2u, segment.vertexArrays.size());
+    EXPECT_FALSE(segment.vertexArrays[0]);
+    EXPECT_TRUE(segment.vertexArrays[1]);
+    context.reset();
+}
@@ -7,19 +7,27 @@
 #include <mbgl/map/map.hpp>
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/headless_frontend.hpp>
+#include <mbgl/programs/line_program.hpp>
+#include <mbgl/renderer/renderer_observer.hpp>
 #include <mbgl/util/default_thread_pool.hpp>
 #include <mbgl/storage/network_status.hpp>
 #include <mbgl/storage/default_file_source.hpp>
 #include <mbgl/storage/online_file_source.hpp>
+#include <mbgl/tile/tile_id.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
 #include <mbgl/util/async_task.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/image.hpp>
 #include <mbgl/style/layers/background_layer.hpp>
 #include <mbgl/util/color.hpp>
 
+#include <mapbox/pixelmatch.hpp>
+
+#include <cstring>
+
 using namespace mbgl;
 using namespace mbgl::style;
 using namespace std::literals::string_literals;
@@ -419,6 +427,231 @@ TEST(Map, AddLayer) {
     test::checkImage("test/fixtures/map/add_layer", test.frontend.render(test.map));
 }
 
+TEST(Map, RenderMetatile) {
+    MapTest<DefaultFileSource> test { ":memory:", "test/fixtures/api/assets", 2 };
+
+    test.map.getStyle().loadJSON(util::read_file("test/fixtures/api/water.json"));
+
+    // The block covers the whole world, and with the buffer it's taller than the world.
+    const auto tiles = test.frontend.renderMetatile(test.map, { 1, 0, 0 }, 2, 256, 16);
+    ASSERT_EQ(4u, tiles.size());
+    EXPECT_EQ(ConstrainMode::HeightOnly, test.map.getConstrainMode());
+
+    // Each slice matches the tile rendered on its own.
+    test.map.setConstrainMode(ConstrainMode::None);
+    test.frontend.setSize({ 256, 256 });
+    test.map.setSize({ 256, 256 });
+    for (uint32_t i = 0; i < 4; i++) {
+        const CanonicalTileID id { 1, i % 2, i / 2 };
+        CameraOptions camera;
+        camera.center = LatLng(CanonicalTileID(2, 2 * id.x + 1, 2 * id.y + 1));
+        camera.zoom = 0;
+        test.map.jumpTo(camera);
+        const PremultipliedImage expected = test.frontend.render(test.map);
+
+        ASSERT_EQ(expected.size, tiles[i].size);
+        const uint64_t mismatched = mapbox::pixelmatch(tiles[i].data.get(), expected.data.get(),
+                                                       expected.size.width, expected.size.height,
+                                                       nullptr, 0.1);
+        EXPECT_LE(mismatched, expected.size.area() / 1000) << "tile " << i;
+    }
+
+    // The span is clamped to the tiles that exist at the zoom level.
+    test.map.setConstrainMode(ConstrainMode::HeightOnly);
+    const auto clamped = test.frontend.renderMetatile(test.map, { 1, 1, 1 }, 2, 256);
+    ASSERT_EQ(1u, clamped.size());
+    EXPECT_EQ(Size(256, 256), test.frontend.getSize());
+    EXPECT_EQ(Size(512, 512), clamped[0].size);
+}
+
+// Keeps the statistics of each frame, and passes everything on to the map.
+class StatsFrontend : public HeadlessFrontend, private RendererObserver {
+public:
+    using HeadlessFrontend::HeadlessFrontend;
+
+    void setObserver(RendererObserver& observer) override {
+        delegate = &observer;
+        HeadlessFrontend::setObserver(*this);
+    }
+
+    std::vector<RenderingStats> stats;
+
+private:
+    void onInvalidate() override { delegate->onInvalidate(); }
+    void onResourceError(std::exception_ptr error) override { delegate->onResourceError(error); }
+    void onWillStartRenderingMap() override { delegate->onWillStartRenderingMap(); }
+    void onWillStartRenderingFrame() override { delegate->onWillStartRenderingFrame(); }
+    void onRenderingStats(const RenderingStats& frame) override {
+        stats.push_back(frame);
+        delegate->onRenderingStats(frame);
+    }
+    void onDidFinishRenderingFrame(RenderMode mode, bool repaint) override {
+        delegate->onDidFinishRenderingFrame(mode, repaint);
+    }
+    void onDidFinishRenderingMap() override { delegate->onDidFinishRenderingMap(); }
+
+    RendererObserver* delegate = nullptr;
+};
+
+TEST(Map, RenderingStats) {
+    util::RunLoop runLoop;
+    StubFileSource fileSource;
+    ThreadPool threadPool { 4 };
+    StatsFrontend frontend { 1, fileSource, threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, fileSource, threadPool, MapMode::Static };
+
+    map.getStyle().loadJSON(R"STYLE({
+      "version": 8,
+      "sources": {
+        "points": {
+          "type": "geojson",
+          "data": {
+            "type": "MultiPoint",
+            "coordinates": [[ -60, 0 ], [ 0, 0 ], [ 60, 0 ]]
+          }
+        }
+      },
+      "layers": [{
+        "id": "symbols",
+        "type": "symbol",
+        "source": "points",
+        "layout": { "icon-image": "marker" }
+      }]
+    })STYLE");
+    map.getStyle().addImage(std::make_unique<style::Image>("marker",
+        decodeImage(util::read_file("test/fixtures/sprites/default_marker.png")), 1.0));
+
+    frontend.render(map);
+
+    // Still images are only rendered once everything has loaded.
+    ASSERT_FALSE(frontend.stats.empty());
+    const RenderingStats& stats = frontend.stats.back();
+    EXPECT_GT(stats.drawCalls, 0u);
+    EXPECT_EQ(3u, stats.placedSymbols);
+    EXPECT_EQ(0u, stats.collidedSymbols);
+    EXPECT_GT(stats.renderedTiles, 0u);
+    EXPECT_EQ(0u, stats.pendingTiles);
+}
+
+TEST(Map, RenderLineTilesTogether) {
+    util::RunLoop runLoop;
+    StubFileSource fileSource;
+    ThreadPool threadPool { 4 };
+    StatsFrontend frontend { { 1024, 1024 }, 1, fileSource, threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, fileSource, threadPool, MapMode::Static };
+    map.setLatLngZoom({ 10, 10 }, 3);
+
+    // A grid that crosses every tile in view.
+    std::string grid;
+    for (int i = -170; i <= 170; i += 10) {
+        if (!grid.empty()) {
+            grid += ",";
+        }
+        grid += R"({ "type": "LineString", "coordinates": [[)" + util::toString(i) + ", -80], [" +
+            util::toString(i) + R"(, 80]] },)";
+        grid += R"({ "type": "LineString", "coordinates": [[-180, )" + util::toString(i / 2) + "], [180, " +
+            util::toString(i / 2) + "]] }";
+    }
+
+    // The tiles can only be drawn together when the width is the same for all lines.
+    auto style = [&] (const std::string& paint) {
+        return R"STYLE({
+          "version": 8,
+          "sources": {
+            "grid": {
+              "type": "geojson",
+              "data": { "type": "GeometryCollection", "geometries": [)STYLE" + grid + R"STYLE(] }
+            }
+          },
+          "layers": [{
+            "id": "grid",
+            "type": "line",
+            "source": "grid",
+            "paint": { )STYLE" + paint + R"STYLE( }
+          }]
+        })STYLE";
+    };
+
+    map.getStyle().loadJSON(style(R"("line-width": ["coalesce", ["get", "width"], 4])"));
+    const PremultipliedImage separate = frontend.render(map);
+    ASSERT_FALSE(frontend.stats.empty());
+    const RenderingStats separateStats = frontend.stats.back();
+
+    map.getStyle().loadJSON(style(R"("line-width": 4)"));
+    const PremultipliedImage together = frontend.render(map);
+    const RenderingStats togetherStats = frontend.stats.back();
+
+    // Each tile takes a draw call of its own, unless it is drawn together with the others.
+    ASSERT_EQ(separateStats.renderedTiles, togetherStats.renderedTiles);
+    ASSERT_GT(togetherStats.renderedTiles, 1u);
+    ASSERT_LE(togetherStats.renderedTiles, LineBatchedProgram::maxTiles);
+    EXPECT_EQ(separateStats.drawCalls - togetherStats.drawCalls, togetherStats.renderedTiles - 1);
+
+    // Clipping to the tiles in the shader looks like clipping with the stencil buffer.
+    ASSERT_EQ(separate.size, together.size);
+    const uint64_t mismatched = mapbox::pixelmatch(together.data.get(), separate.data.get(),
+                                                   separate.size.width, separate.size.height,
+                                                   nullptr, 0.1);
+    EXPECT_LE(mismatched, separate.size.area() / 1000);
+
+    // The stencil clip isn't translated with the lines, so translated lines are drawn per tile.
+    map.getStyle().loadJSON(style(R"("line-width": 4, "line-translate": [20, 20])"));
+    frontend.render(map);
+    EXPECT_EQ(separateStats.drawCalls, frontend.stats.back().drawCalls);
+}
+
+TEST(Map, RenderDeferred) {
+    MapTest<DefaultFileSource> test { ":memory:", "test/fixtures/api/assets" };
+
+    test.map.getStyle().loadJSON(util::read_file("test/fixtures/api/water.json"));
+
+    const PremultipliedImage expected = test.frontend.render(test.map);
+
+    // Both images are read before either is retrieved, so they may share the GPU's time.
+    auto first = test.frontend.renderDeferred(test.map);
+    auto second = test.frontend.renderDeferred(test.map);
+
+    const PremultipliedImage actual = first.get();
+    ASSERT_EQ(expected.size, actual.size);
+    EXPECT_EQ(0, std::memcmp(expected.data.get(), actual.data.get(), expected.bytes()));
+
+    // The rows are flipped by the encoder.
+    const PremultipliedImage decoded = decodeImage(second.encodePNG({}));
+    ASSERT_EQ(expected.size, decoded.size);
+    EXPECT_EQ(0, std::memcmp(expected.data.get(), decoded.data.get(), expected.bytes()));
+}
+
+TEST(Map, RenderBatch) {
+    MapTest<DefaultFileSource> test { ":memory:", "test/fixtures/api/assets" };
+
+    test.map.getStyle().loadJSON(util::read_file("test/fixtures/api/water.json"));
+
+    std::vector<HeadlessFrontend::BatchItem> items;
+    for (double zoom = 0; zoom < 3; zoom++) {
+        CameraOptions camera;
+        camera.center = LatLng { 10 * zoom, 20 * zoom };
+        camera.zoom = zoom;
+        items.push_back({ camera, { 128 + 64 * uint32_t(zoom), 128 } });
+    }
+
+    std::vector<PremultipliedImage> images;
+    test.frontend.renderBatch(test.map, items, [&] (std::size_t index, PremultipliedImage image) {
+        EXPECT_EQ(images.size(), index);
+        images.push_back(std::move(image));
+    }, 1);
+    ASSERT_EQ(items.size(), images.size());
+
+    for (std::size_t i = 0; i < items.size(); i++) {
+        test.frontend.setSize(items[i].size);
+        test.map.setSize(items[i].size);
+        test.map.jumpTo(items[i].camera);
+        const PremultipliedImage expected = test.frontend.render(test.map);
+
+        ASSERT_EQ(expected.size, images[i].size);
+        EXPECT_EQ(0, std::memcmp(expected.data.get(), images[i].data.get(), expected.bytes()));
+    }
+}
+
 TEST(Map, WithoutVAOExtension) {
     MapTest<DefaultFileSource> test { ":memory:", "test/fixtures/api/assets" };
 
@@ -476,6 +476,48 @@ TEST(Transform, Camera) {
     ASSERT_FALSE(transform.inTransition());
 }
 
+TEST(Transform, PredictedStates) {
+    Transform transform;
+    transform.resize({ 1000, 1000 });
+
+    CameraOptions origin;
+    origin.zoom = 2;
+    origin.center = LatLng { 0, 0 };
+    transform.jumpTo(origin);
+    ASSERT_TRUE(transform.getPredictedStates(Clock::now()).empty());
+
+    CameraOptions destination;
+    destination.zoom = 14;
+    destination.center = LatLng { 40, 100 };
+    transform.flyTo(destination, AnimationOptions(Seconds(10)));
+    ASSERT_TRUE(transform.inTransition());
+
+    const TimePoint start = transform.getTransitionStart();
+    const TimePoint end = start + transform.getTransitionDuration();
+
+    auto predicted = transform.getPredictedStates(start);
+    ASSERT_EQ(2u, predicted.size());
+
+    // A viewport a little further along the flight path, which is still far from the destination.
+    EXPECT_LT(predicted[0].getZoom(), 14);
+
+    // The destination.
+    EXPECT_NEAR(40, predicted[1].getLatLng().latitude(), 0.001);
+    EXPECT_NEAR(100, predicted[1].getLatLng().longitude(), 0.001);
+    EXPECT_NEAR(14, predicted[1].getZoom(), 0.00001);
+
+    // Predicting doesn't move the camera.
+    ASSERT_DOUBLE_EQ(2, transform.getZoom());
+    ASSERT_NEAR(0, transform.getLatLng().longitude(), 1e-9);
+
+    // Near the end, only the destination is left.
+    EXPECT_EQ(1u, transform.getPredictedStates(end - Milliseconds(100)).size());
+
+    transform.updateTransitions(end);
+    ASSERT_FALSE(transform.inTransition());
+    EXPECT_TRUE(transform.getPredictedStates(end).empty());
+}
+
 TEST(Transform, DefaultTransform) {
     struct TransformObserver : public mbgl::MapObserver {
         void onCameraWillChange(MapObserver::CameraChangeMode) final {
@@ -0,0 +1,131 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/programs/binary_program_cache.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+const std::string path = "test/fixtures/binary_program_cache.pbf";
+
+void deleteCache() {
+    try {
+        util::deleteFile(path);
+    } catch (const util::IOException&) {
+    }
+}
+
+BinaryProgram program(std::string code, std::string identifier) {
+    return { 42, std::move(code), std::move(identifier), { { "a_pos", 1 } }, { { "u_matrix", 2 } } };
+}
+
+} // namespace
+
+TEST(BinaryProgramCache, PersistsVariants) {
+    deleteCache();
+
+    {
+        BinaryProgramCache cache(path, "renderer");
+        EXPECT_FALSE(cache.get("fill.00", "identifier"));
+        cache.put("fill.00", program("plain", "identifier"));
+        cache.put("fill.01", program("data-driven", "identifier"));
+    }
+
+    BinaryProgramCache cache(path, "renderer");
+    EXPECT_EQ(2u, cache.size());
+
+    auto plain = cache.get("fill.00", "identifier");
+    ASSERT_TRUE(plain);
+    EXPECT_EQ("plain", plain->code());
+    EXPECT_EQ(1u, plain->attributeLocation("a_pos"));
+    EXPECT_EQ(2, plain->uniformLocation("u_matrix"));
+
+    auto dataDriven = cache.get("fill.01", "identifier");
+    ASSERT_TRUE(dataDriven);
+    EXPECT_EQ("data-driven", dataDriven->code());
+}
+
+TEST(BinaryProgramCache, EvictsStaleEntries) {
+    deleteCache();
+
+    {
+        BinaryProgramCache cache(path, "renderer");
+        cache.put("fill.00", program("old", "identifier"));
+        cache.put("fill.00", program("new", "identifier"));
+        cache.put("line.00", program("line", "identifier"));
+
+        // Sources changed since the line program was compiled.
+        EXPECT_FALSE(cache.get("line.00", "changed"));
+        EXPECT_EQ(1u, cache.size());
+    }
+
+    {
+        BinaryProgramCache cache(path, "renderer");
+        EXPECT_EQ(1u, cache.size());
+        EXPECT_FALSE(cache.get("line.00", "identifier"));
+        auto fill = cache.get("fill.00", "identifier");
+        ASSERT_TRUE(fill);
+        EXPECT_EQ("new", fill->code());
+    }
+
+    // Binaries produced by another renderer can't be loaded.
+    BinaryProgramCache cache(path, "other renderer");
+    EXPECT_EQ(0u, cache.size());
+    EXPECT_FALSE(cache.get("fill.00", "identifier"));
+}
+
+TEST(BinaryProgramCache, TruncatedFile) {
+    deleteCache();
+
+    {
+        BinaryProgramCache cache(path, "renderer");
+        cache.put("fill.00", program("fill", "identifier"));
+        cache.put("line.00", program("line", "identifier"));
+    }
+
+    std::string data = util::read_file(path);
+    util::write_file(path, data.substr(0, data.size() - 4));
+
+    BinaryProgramCache cache(path, "renderer");
+    EXPECT_EQ(1u, cache.size());
+    EXPECT_TRUE(cache.get("fill.00", "identifier"));
+}
+
+TEST(BinaryProgramCache, DropsUnusedEntries) {
+    deleteCache();
+
+    {
+        BinaryProgramCache cache(path, "renderer");
+        cache.put("fill.00", program("fill", "identifier"));
+    }
+
+    {
+        // Every entry is older than the maximum age.
+        BinaryProgramCache cache(path, "renderer", Seconds::zero());
+        EXPECT_EQ(0u, cache.size());
+    }
+
+    // The file was rewritten without the entry.
+    BinaryProgramCache cache(path, "renderer");
+    EXPECT_EQ(0u, cache.size());
+}
+
+TEST(BinaryProgramCache, SharedFile) {
+    deleteCache();
+
+    {
+        // Both read the file before either writes it.
+        BinaryProgramCache first(path, "renderer");
+        BinaryProgramCache second(path, "renderer");
+        EXPECT_EQ(0u, first.size());
+        EXPECT_EQ(0u, second.size());
+        first.put("fill.00", program("fill", "identifier"));
+        second.put("line.00", program("line", "identifier"));
+    }
+
+    // Each write replaces the whole file, so it holds the entries of one of the writers.
+    BinaryProgramCache cache(path, "renderer");
+    EXPECT_EQ(1u, cache.size());
+    EXPECT_TRUE(cache.get("line.00", "identifier"));
+}
@@ -0,0 +1,65 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/renderer/paint_property_binder.hpp>
+#include <mbgl/style/expression/feature_batch.hpp>
+#include <mbgl/style/layers/circle_layer_properties.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+using Binder = PaintPropertyBinder<float, typename CircleRadius::Attribute::Type>;
+
+std::vector<StubGeometryTileFeature> features() {
+    std::vector<StubGeometryTileFeature> result;
+    for (std::size_t i = 0; i < 300; i++) {
+        // Every seventh feature doesn't have the property, and evaluates to the default value.
+        result.emplace_back(i % 7 == 3 ? PropertyMap {} : PropertyMap {{ "size", uint64_t(i) }});
+    }
+    return result;
+}
+
+// Adds the features to both binders, one of them prepared with the batch of features, and
+// expects both to evaluate the same values. The features' values increase, so a value taken
+// for the wrong feature changes the maximum of the binder's statistics.
+void expectBatchedEvaluationMatches(const PossiblyEvaluatedPropertyValue<float>& value) {
+    const std::vector<StubGeometryTileFeature> batchFeatures = features();
+    std::vector<const GeometryTileFeature*> pointers;
+    for (const auto& feature : batchFeatures) {
+        pointers.push_back(&feature);
+    }
+
+    auto batched = Binder::create(value, 10.0f, CircleRadius::defaultValue());
+    auto unbatched = Binder::create(value, 10.0f, CircleRadius::defaultValue());
+    batched->prepare(expression::FeatureBatch(pointers));
+
+    for (std::size_t i = 0; i < batchFeatures.size(); i++) {
+        batched->populateVertexVector(batchFeatures[i], i + 1);
+        unbatched->populateVertexVector(batchFeatures[i], i + 1);
+        ASSERT_EQ(unbatched->statistics.max(), batched->statistics.max()) << "feature " << i;
+    }
+
+    // Features added after the batch are evaluated individually.
+    const StubGeometryTileFeature extra { PropertyMap {{ "size", uint64_t(1000) }} };
+    batched->populateVertexVector(extra, batchFeatures.size() + 1);
+    unbatched->populateVertexVector(extra, batchFeatures.size() + 1);
+    EXPECT_EQ(unbatched->statistics.max(), batched->statistics.max());
+}
+
+} // namespace
+
+TEST(PaintPropertyBinder, SourceFunctionBatch) {
+    expectBatchedEvaluationMatches(PossiblyEvaluatedPropertyValue<float>(SourceFunction<float>("size", ExponentialStops<float>({
+        { 0.0f, 0.0f },
+        { 1000.0f, 2000.0f }
+    }))));
+}
+
+TEST(PaintPropertyBinder, CompositeFunctionBatch) {
+    expectBatchedEvaluationMatches(PossiblyEvaluatedPropertyValue<float>(CompositeFunction<float>("size", CompositeExponentialStops<float>({
+        { 0.0f, {{ 0.0f, 0.0f }, { 1000.0f, 1000.0f }} },
+        { 20.0f, {{ 0.0f, 0.0f }, { 1000.0f, 3000.0f }} }
+    }))));
+}
@@ -46,6 +46,44 @@ TEST(DefaultFileSource, TEST_REQUIRES_SERVER(CacheResponse)) {
     loop.run();
 }
 
+TEST(DefaultFileSource, TEST_REQUIRES_SERVER(CoalesceIdenticalRequests)) {
+    util::RunLoop loop;
+    DefaultFileSource fs(":memory:", ".");
+
+    // Each request that reaches the server gets a different response body.
+    const Resource resource { Resource::Unknown, "http://127.0.0.1:3000/cache" };
+
+    std::unique_ptr<AsyncRequest> req1;
+    std::unique_ptr<AsyncRequest> req2;
+    optional<std::string> data1;
+    optional<std::string> data2;
+
+    auto check = [&] {
+        if (data1 && data2) {
+            EXPECT_EQ(*data1, *data2);
+            loop.stop();
+        }
+    };
+
+    req1 = fs.request(resource, [&](Response res) {
+        req1.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        data1 = *res.data;
+        check();
+    });
+
+    req2 = fs.request(resource, [&](Response res) {
+        req2.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        data2 = *res.data;
+        check();
+    });
+
+    loop.run();
+}
+
 TEST(DefaultFileSource, TEST_REQUIRES_SERVER(CacheRevalidateSame)) {
     util::RunLoop loop;
     DefaultFileSource fs(":memory:", ".");
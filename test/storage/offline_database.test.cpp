@@ -4,6 +4,7 @@
 #include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/string.hpp>
 
@@ -424,6 +425,135 @@ TEST(OfflineDatabase, PutEvictsLeastRecentlyUsedResources) {
     EXPECT_FALSE(bool(db.get(Resource::style("http://example.com/1"))));
 }
 
+TEST(OfflineDatabase, GetAfterUpdate) {
+    using namespace mbgl;
+
+    OfflineDatabase db(":memory:");
+
+    Resource resource = Resource::tile("http://example.com/", 1.0, 0, 0, 0, Tileset::Scheme::XYZ);
+    Response response1;
+    response1.data = std::make_shared<std::string>("first");
+    Response response2;
+    response2.data = std::make_shared<std::string>("second");
+
+    db.put(resource, response1);
+    auto res1 = db.get(resource);
+    ASSERT_TRUE(res1 && res1->data);
+    EXPECT_EQ("first", *res1->data);
+
+    // Repeated reads are answered from memory, which must not hide later writes.
+    db.put(resource, response2);
+    auto res2 = db.get(resource);
+    ASSERT_TRUE(res2 && res2->data);
+    EXPECT_EQ("second", *res2->data);
+
+    // Tiles that differ only in their coordinates are distinct.
+    EXPECT_FALSE(bool(db.get(Resource::tile("http://example.com/", 1.0, 1, 0, 1, Tileset::Scheme::XYZ))));
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(GetFromMemoryUpdatesAccessed)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/accessed.db");
+    const std::string path = "test/fixtures/offline_database/accessed.db";
+
+    auto accessed = [&] {
+        mapbox::sqlite::Database db{ path, mapbox::sqlite::ReadOnly };
+        mapbox::sqlite::Statement stmt{ db, "SELECT accessed FROM resources" };
+        mapbox::sqlite::Query query{ stmt };
+        query.run();
+        return query.get<int64_t>(0);
+    };
+
+    Resource resource = Resource::style("http://example.com/");
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+
+    {
+        OfflineDatabase db(path);
+        db.put(resource, response);
+        ASSERT_TRUE(bool(db.get(resource)));
+
+        {
+            mapbox::sqlite::Database other{ path, mapbox::sqlite::ReadWrite };
+            other.exec("UPDATE resources SET accessed = 0");
+        }
+        EXPECT_EQ(0, accessed());
+
+        // Answered from memory. The timestamp is written in a batch, at the latest when the
+        // database is closed.
+        ASSERT_TRUE(bool(db.get(resource)));
+    }
+
+    EXPECT_GT(accessed(), 0);
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(GetFromMemoryIgnoresAccessedWriteErrors)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/accessed.db");
+    const std::string path = "test/fixtures/offline_database/accessed.db";
+
+    OfflineDatabase db(path);
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+
+    // Enough memory cache hits to write their timestamps.
+    std::vector<Resource> resources;
+    for (int i = 0; i < 64; i++) {
+        resources.push_back(Resource::style("http://example.com/" + util::toString(i)));
+        db.put(resources.back(), response);
+        ASSERT_TRUE(bool(db.get(resources.back())));
+    }
+
+    {
+        mapbox::sqlite::Database other{ path, mapbox::sqlite::ReadWrite };
+        other.exec("DROP TABLE resources");
+    }
+
+    Log::setObserver(std::make_unique<FixtureLogObserver>());
+
+    for (const auto& resource : resources) {
+        auto res = db.get(resource);
+        ASSERT_TRUE(res && res->data);
+        EXPECT_EQ("data", *res->data);
+    }
+
+    auto observer = Log::removeObserver();
+    auto flo = dynamic_cast<FixtureLogObserver*>(observer.get());
+    EXPECT_EQ(1u, flo->count({ EventSeverity::Error, Event::Database, 1, "no such table: resources" }));
+}
+
+TEST(OfflineDatabase, PutWithCompression) {
+    using namespace mbgl;
+
+    OfflineDatabase db(":memory:");
+
+    Response response;
+    response.data = std::make_shared<std::string>(10000, 'x');
+
+    const Resource fast = Resource::tile("http://example.com/", 1.0, 0, 0, 0, Tileset::Scheme::XYZ);
+    db.setCompression(Resource::Kind::Tile, util::Compression::Fast);
+    EXPECT_EQ(util::compressFast(*response.data).size(), db.put(fast, response).second);
+
+    const Resource none = Resource::tile("http://example.com/", 1.0, 0, 0, 1, Tileset::Scheme::XYZ);
+    db.setCompression(Resource::Kind::Tile, util::Compression::None);
+    EXPECT_EQ(response.data->size(), db.put(none, response).second);
+
+    const Resource zlib = Resource::tile("http://example.com/", 1.0, 1, 0, 1, Tileset::Scheme::XYZ);
+    db.setCompression(Resource::Kind::Tile, util::Compression::Zlib, 9);
+    EXPECT_EQ(util::compress(*response.data, 9).size(), db.put(zlib, response).second);
+
+    // Rows keep the codec they were written with.
+    for (const auto& resource : { fast, none, zlib }) {
+        auto result = db.get(resource);
+        ASSERT_TRUE(result && result->data);
+        EXPECT_EQ(*response.data, *result->data);
+    }
+}
+
 TEST(OfflineDatabase, PutRegionResourceDoesNotEvict) {
     using namespace mbgl;
 
@@ -488,6 +618,50 @@ TEST(OfflineDatabase, GetRegionCompletedStatus) {
     EXPECT_EQ(tileSize, status3.completedTileSize);
 }
 
+TEST(OfflineDatabase, GetRegionCompletedStatusCached) {
+    using namespace mbgl;
+
+    OfflineDatabase db(":memory:");
+    OfflineRegionDefinition definition { "http://example.com/style", LatLngBounds::hull({1, 2}, {3, 4}), 5, 6, 2.0 };
+    OfflineRegion region = db.createRegion(definition, OfflineRegionMetadata());
+
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+
+    // Populate the cached status, then check that it follows later changes.
+    db.getRegionCompletedStatus(region.getID());
+
+    const Resource tile = Resource::tile("http://example.com/", 1.0, 0, 0, 0, Tileset::Scheme::XYZ);
+    uint64_t tileSize = db.putRegionResource(region.getID(), tile, response);
+
+    // Linking the same resource again must not count it twice.
+    db.putRegionResource(region.getID(), tile, response);
+    EXPECT_TRUE(bool(db.hasRegionResource(region.getID(), tile)));
+
+    OfflineRegionStatus status1 = db.getRegionCompletedStatus(region.getID());
+    EXPECT_EQ(1u, status1.completedResourceCount);
+    EXPECT_EQ(tileSize, status1.completedResourceSize);
+    EXPECT_EQ(1u, status1.completedTileCount);
+    EXPECT_EQ(tileSize, status1.completedTileSize);
+
+    // An ambient update of a region resource changes its stored size.
+    Response updated;
+    updated.data = randomString(1024);
+    uint64_t updatedSize = db.put(tile, updated).second;
+
+    OfflineRegionStatus status2 = db.getRegionCompletedStatus(region.getID());
+    EXPECT_EQ(1u, status2.completedTileCount);
+    EXPECT_EQ(updatedSize, status2.completedTileSize);
+
+    // A resource that was cached ambiently is counted once it is linked to the region.
+    uint64_t styleSize = db.put(Resource::style("http://example.com/"), response).second;
+    EXPECT_TRUE(bool(db.getRegionResource(region.getID(), Resource::style("http://example.com/"))));
+
+    OfflineRegionStatus status3 = db.getRegionCompletedStatus(region.getID());
+    EXPECT_EQ(2u, status3.completedResourceCount);
+    EXPECT_EQ(styleSize + updatedSize, status3.completedResourceSize);
+}
+
 TEST(OfflineDatabase, HasRegionResource) {
     using namespace mbgl;
 
@@ -658,7 +832,7 @@ TEST(OfflineDatabase, MigrateFromV2Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
     EXPECT_LT(databasePageCount("test/fixtures/offline_database/migrated.db"),
               databasePageCount("test/fixtures/offline_database/v2.db"));
 }
@@ -679,7 +853,7 @@ TEST(OfflineDatabase, MigrateFromV3Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
 }
 
 TEST(OfflineDatabase, MigrateFromV4Schema) {
@@ -698,7 +872,7 @@ TEST(OfflineDatabase, MigrateFromV4Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
 
     // Journal mode should be DELETE after migration to v5.
     EXPECT_EQ("delete", databaseJournalMode("test/fixtures/offline_database/migrated.db"));
@@ -724,7 +898,7 @@ TEST(OfflineDatabase, MigrateFromV5Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
 
     EXPECT_EQ((std::vector<std::string>{ "id", "url_template", "pixel_ratio", "z", "x", "y",
                                          "expires", "modified", "etag", "data", "compressed",
@@ -748,7 +922,7 @@ TEST(OfflineDatabase, DowngradeSchema) {
         OfflineDatabase db("test/fixtures/offline_database/migrated.db", 0);
     }
 
-    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
 
     EXPECT_EQ((std::vector<std::string>{ "id", "url_template", "pixel_ratio", "z", "x", "y",
                                          "expires", "modified", "etag", "data", "compressed",
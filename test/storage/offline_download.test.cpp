@@ -333,6 +333,13 @@ TEST(OfflineDownload, GetStatusStyleAndSourceComplete) {
     EXPECT_EQ(262u, status.requiredResourceCount);
     EXPECT_TRUE(status.requiredResourceCountIsPrecise);
     EXPECT_FALSE(status.complete());
+
+    // The ambient cache stores a new version of the style.
+    test.db.put(Resource::style("http://127.0.0.1:3000/style.json"), test.response("empty.style.json"));
+
+    status = download.getStatus();
+    EXPECT_EQ(1u, status.requiredResourceCount);
+    EXPECT_TRUE(status.requiredResourceCountIsPrecise);
 }
 
 TEST(OfflineDownload, RequestError) {
@@ -0,0 +1,122 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/style/conversion.hpp>
+#include <mbgl/style/rapidjson_conversion.hpp>
+#include <mbgl/style/expression/bytecode.hpp>
+#include <mbgl/style/expression/feature_batch.hpp>
+#include <mbgl/util/rapidjson.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style;
+using namespace mbgl::style::expression;
+
+namespace {
+
+std::unique_ptr<Expression> parse(const std::string& json) {
+    JSDocument document;
+    document.Parse<0>(json.c_str());
+    assert(!document.HasParseError());
+    const JSValue* value = &document;
+    ParsingContext ctx;
+    ParseResult parsed = ctx.parseExpression(conversion::Convertible(value));
+    assert(parsed);
+    return std::move(*parsed);
+}
+
+std::string describe(const EvaluationResult& result) {
+    return result ? stringify(*result) : "error: " + result.error().message;
+}
+
+void expectIdentical(const Expression& expression, const Bytecode& bytecode, const EvaluationContext& context) {
+    const EvaluationResult expected = expression.evaluate(context);
+    const EvaluationResult actual = bytecode.evaluate(context);
+    ASSERT_EQ(bool(expected), bool(actual)) << describe(expected) << " vs. " << describe(actual);
+    if (expected) {
+        EXPECT_TRUE(*expected == *actual) << describe(expected) << " vs. " << describe(actual);
+    } else {
+        EXPECT_EQ(expected.error().message, actual.error().message);
+    }
+}
+
+const std::vector<StubGeometryTileFeature>& features() {
+    static const std::vector<StubGeometryTileFeature> result {
+        PropertyMap {},
+        PropertyMap {{ "a", 3.0 }, { "b", int64_t(-2) }, { "population", uint64_t(500) }, { "type", std::string("a") }},
+        PropertyMap {{ "a", 0.25 }, { "b", 1e9 }, { "population", 75000.0 }, { "type", std::string("b") }},
+        PropertyMap {{ "a", std::string("3") }, { "b", true }, { "population", 1e7 }, { "type", 1.0 }},
+    };
+    return result;
+}
+
+} // namespace
+
+TEST(Bytecode, MatchesTreeEvaluation) {
+    const std::vector<std::string> expressions {
+        R"(["interpolate", ["linear"], ["zoom"], 0, 1, 10, 5, 15, 20])",
+        R"(["interpolate", ["exponential", 1.5], ["get", "a"], 0, 1, 1, 10])",
+        R"(["interpolate", ["cubic-bezier", 0.4, 0, 0.6, 1], ["zoom"], 5, 1, 15, 10])",
+        R"(["interpolate", ["linear"], ["get", "population"], 0, ["to-color", "red"], 100000, ["to-color", "blue"]])",
+        R"(["step", ["get", "population"], "small", 1000, "medium", 100000, "large"])",
+        R"(["+", 1, ["step", ["zoom"], 1, 10, ["get", "a"]]])",
+        R"(["+", ["*", ["get", "a"], 2], ["number", ["get", "b"]], ["zoom"]])",
+        R"(["-", ["/", ["get", "population"], ["%", 7, 3]], ["^", 2, ["-", ["get", "a"]]]])",
+        R"(["min", ["sqrt", ["get", "population"]], ["ln", 10], ["max", ["zoom"], 3]])",
+        R"(["*", 2, ["match", ["get", "type"], "a", 1, "b", 2, 3]])",
+        R"(["+", 1, ["number", ["get", "a"], ["get", "b"], 0]])",
+        R"(["+", 1, ["interpolate", ["linear"], ["zoom"], 0, ["get", "a"], 10, 5]])",
+        R"(["heatmap-density"])",
+    };
+
+    for (const auto& json : expressions) {
+        SCOPED_TRACE(json);
+        std::unique_ptr<Expression> expression = parse(json);
+        std::unique_ptr<Bytecode> bytecode = Bytecode::compile(*expression);
+        ASSERT_TRUE(bytecode);
+
+        for (const auto& feature : features()) {
+            for (float zoom : { 0.0f, 4.5f, 10.0f, 12.0f, 22.0f }) {
+                expectIdentical(*expression, *bytecode, EvaluationContext(zoom, &feature));
+            }
+            expectIdentical(*expression, *bytecode, EvaluationContext(&feature));
+            expectIdentical(*expression, *bytecode, EvaluationContext(optional<float>(), &feature, 0.5));
+        }
+        expectIdentical(*expression, *bytecode, EvaluationContext(10.0f));
+    }
+}
+
+TEST(Bytecode, Fallbacks) {
+    auto lowered = parse(R"(["interpolate", ["linear"], ["get", "a"], 0, 1, 10, 5])");
+    EXPECT_EQ(0u, Bytecode::compile(*lowered)->fallbackCount());
+
+    auto partial = parse(R"(["*", 2, ["match", ["get", "type"], "a", 1, "b", 2, 3]])");
+    EXPECT_EQ(1u, Bytecode::compile(*partial)->fallbackCount());
+
+    // Nothing to lower.
+    auto unsupported = parse(R"(["to-string", ["get", "a"]])");
+    EXPECT_FALSE(Bytecode::compile(*unsupported));
+}
+
+TEST(Bytecode, Batch) {
+    auto expression = parse(R"(["+", ["*", ["get", "a"], 2], ["match", ["get", "type"], "a", 1, "b", 2, 3]])");
+    auto bytecode = Bytecode::compile(*expression);
+    ASSERT_TRUE(bytecode);
+
+    std::vector<const GeometryTileFeature*> pointers;
+    for (const auto& feature : features()) {
+        pointers.push_back(&feature);
+    }
+    const FeatureBatch batch(pointers);
+
+    for (optional<float> zoom : { optional<float>(), optional<float>(10.0f) }) {
+        const std::vector<EvaluationResult> results = bytecode->evaluate(batch, zoom);
+        ASSERT_EQ(batch.size(), results.size());
+        for (std::size_t i = 0; i < batch.size(); i++) {
+            const EvaluationResult expected = expression->evaluate(EvaluationContext(zoom, &batch[i], {}));
+            EXPECT_EQ(describe(expected), describe(results[i]));
+        }
+    }
+
+    EXPECT_TRUE(batch.column("missing")[0] == Null);
+    EXPECT_TRUE(batch.column("a")[1] == 3.0);
+}
@@ -40,6 +40,7 @@
 #include <mbgl/text/glyph_manager.hpp>
 
 #include <cstdint>
+#include <set>
 
 using namespace mbgl;
 using SourceType = mbgl::style::SourceType;
@@ -52,6 +53,7 @@ public:
     StubRenderSourceObserver renderSourceObserver;
     Transform transform;
     TransformState transformState;
+    std::vector<TransformState> prefetchStates;
     ThreadPool threadPool { 1 };
     Style style { loop, fileSource, 1 };
     AnnotationManager annotationManager { style };
@@ -68,7 +70,8 @@ public:
         annotationManager,
         imageManager,
         glyphManager,
-        0
+        0,
+        prefetchStates
     };
 
     SourceTest() {
@@ -254,6 +257,56 @@ TEST(Source, VectorTileEmpty) {
     test.run();
 }
 
+TEST(Source, PrefetchTiles) {
+    SourceTest test;
+
+    Transform prefetch(test.transformState);
+    prefetch.setLatLngZoom({ 0, 0 }, 2);
+    test.prefetchStates.push_back(prefetch.getState());
+
+    std::set<uint8_t> requestedZooms;
+    test.fileSource.tileResponse = [&] (const Resource& resource) -> optional<Response> {
+        requestedZooms.insert(resource.tileData->z);
+        if (resource.tileData->z == 2) {
+            // Prefetched tiles never arrive.
+            return {};
+        }
+        Response response;
+        response.noContent = true;
+        return response;
+    };
+
+    RasterLayer layer("id", "source");
+    std::vector<Immutable<Layer::Impl>> layers {{ layer.baseImpl }};
+
+    Tileset tileset;
+    tileset.tiles = { "tiles" };
+
+    RasterSource source("source", tileset, 512);
+    source.loadDescription(test.fileSource);
+
+    auto renderSource = RenderSource::create(source.baseImpl);
+
+    test.renderSourceObserver.tileChanged = [&] (RenderSource&, const OverscaledTileID& tileID) {
+        EXPECT_EQ(0, tileID.canonical.z);
+        // Pending prefetched tiles don't hold up loading.
+        EXPECT_TRUE(renderSource->isLoaded());
+        test.end();
+    };
+
+    renderSource->setObserver(&test.renderSourceObserver);
+    renderSource->update(source.baseImpl,
+                         layers,
+                         true,
+                         true,
+                         test.tileParameters);
+
+    test.run();
+
+    EXPECT_EQ(1u, requestedZooms.count(0));
+    EXPECT_EQ(1u, requestedZooms.count(2));
+}
+
 TEST(Source, RasterTileFail) {
     SourceTest test;
 
@@ -24,6 +24,7 @@ class CustomTileTest {
 public:
     FakeFileSource fileSource;
     TransformState transformState;
+    std::vector<TransformState> prefetchStates;
     util::RunLoop loop;
     ThreadPool threadPool { 1 };
     style::Style style { loop, fileSource, 1 };
@@ -41,7 +42,8 @@ public:
         annotationManager,
         imageManager,
         glyphManager,
-        0
+        0,
+        prefetchStates
     };
 };
 
@@ -63,8 +65,7 @@ TEST(CustomGeometryTile, InvokeFetchTile) {
     auto mb =std::make_shared<Mailbox>(*Scheduler::GetCurrent());
     ActorRef<CustomTileLoader> loaderActor(loader, mb);
     
-    CustomGeometryTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, CustomGeometrySource::TileOptions(),
-    loaderActor);
+    CustomGeometryTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, loaderActor);
 
     tile.setNecessity(TileNecessity::Required);
 
@@ -88,8 +89,7 @@ TEST(CustomGeometryTile, InvokeCancelTile) {
     auto mb =std::make_shared<Mailbox>(*Scheduler::GetCurrent());
     ActorRef<CustomTileLoader> loaderActor(loader, mb);
     
-    CustomGeometryTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, CustomGeometrySource::TileOptions(),
-    loaderActor);
+    CustomGeometryTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, loaderActor);
 
     tile.setNecessity(TileNecessity::Required);
     tile.setNecessity(TileNecessity::Optional);
@@ -101,17 +101,16 @@ TEST(CustomGeometryTile, InvokeTileChanged) {
 
     CircleLayer layer("circle", "source");
 
-    mapbox::geometry::feature_collection<double> features;
-    features.push_back(mapbox::geometry::feature<double> {
-        mapbox::geometry::point<double>(0, 0)
+    mapbox::geometry::feature_collection<int16_t> features;
+    features.push_back(mapbox::geometry::feature<int16_t> {
+        mapbox::geometry::point<int16_t>(0, 0)
     });
 
     CustomTileLoader loader(nullptr, nullptr);
     auto mb =std::make_shared<Mailbox>(*Scheduler::GetCurrent());
     ActorRef<CustomTileLoader> loaderActor(loader, mb);
     
-    CustomGeometryTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, CustomGeometrySource::TileOptions(),
-    loaderActor);
+    CustomGeometryTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, loaderActor);
 
     StubTileObserver observer;
     observer.tileChanged = [&] (const Tile&) {
@@ -122,9 +121,85 @@ TEST(CustomGeometryTile, InvokeTileChanged) {
 
     tile.setLayers({{ layer.baseImpl }});
     tile.setObserver(&observer);
-    tile.setTileData(features);
+    tile.setTileData(std::make_shared<const mapbox::geometry::feature_collection<int16_t>>(features));
 
     while (!tile.isComplete()) {
         test.loop.runOnce();
     }
 }
+
+TEST(CustomGeometryTile, SharedTileData) {
+    // Wrapped copies of a tile are fetched once and get the same data.
+    CustomTileTest test;
+
+    CircleLayer layer("circle", "source");
+
+    std::size_t fetches = 0;
+    CustomTileLoader loader([&](const CanonicalTileID&) { fetches++; }, nullptr);
+    auto mb = std::make_shared<Mailbox>(*Scheduler::GetCurrent());
+    ActorRef<CustomTileLoader> loaderActor(loader, mb);
+
+    CustomGeometryTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, loaderActor);
+    CustomGeometryTile wrapped(OverscaledTileID(0, 1, 0, 0, 0), "source", test.tileParameters, loaderActor);
+    for (auto* t : { &tile, &wrapped }) {
+        t->setLayers({{ layer.baseImpl }});
+        t->setNecessity(TileNecessity::Required);
+    }
+
+    while (fetches == 0) {
+        test.loop.runOnce();
+    }
+
+    mapbox::geometry::feature_collection<int16_t> features;
+    features.push_back(mapbox::geometry::feature<int16_t> {
+        mapbox::geometry::point<int16_t>(4096, 4096)
+    });
+    loader.setTileFeatures(CanonicalTileID(0, 0, 0),
+                           std::make_shared<const mapbox::geometry::feature_collection<int16_t>>(features));
+
+    while (!tile.isComplete() || !wrapped.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    EXPECT_EQ(1u, fetches);
+    EXPECT_NE(nullptr, tile.getBucket(*layer.baseImpl));
+    EXPECT_NE(nullptr, wrapped.getBucket(*layer.baseImpl));
+}
+
+TEST(CustomGeometryTile, CancelSharedFetch) {
+    // Cancelling one of two required tiles that share a fetch keeps the fetch going.
+    CustomTileTest test;
+
+    CircleLayer layer("circle", "source");
+
+    std::size_t fetches = 0;
+    std::size_t cancels = 0;
+    CustomTileLoader loader([&](const CanonicalTileID&) { fetches++; },
+                            [&](const CanonicalTileID&) { cancels++; });
+    auto mb = std::make_shared<Mailbox>(*Scheduler::GetCurrent());
+    ActorRef<CustomTileLoader> loaderActor(loader, mb);
+
+    CustomGeometryTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, loaderActor);
+    CustomGeometryTile wrapped(OverscaledTileID(0, 1, 0, 0, 0), "source", test.tileParameters, loaderActor);
+    for (auto* t : { &tile, &wrapped }) {
+        t->setLayers({{ layer.baseImpl }});
+        t->setNecessity(TileNecessity::Required);
+    }
+    tile.setNecessity(TileNecessity::Optional);
+
+    mapbox::geometry::feature_collection<int16_t> features;
+    features.push_back(mapbox::geometry::feature<int16_t> {
+        mapbox::geometry::point<int16_t>(4096, 4096)
+    });
+    // Sent through the mailbox, so that it arrives after the cancellation.
+    loaderActor.invoke(&CustomTileLoader::setTileFeatures, CanonicalTileID(0, 0, 0),
+                       std::make_shared<const mapbox::geometry::feature_collection<int16_t>>(features));
+
+    while (!wrapped.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    EXPECT_EQ(1u, fetches);
+    EXPECT_EQ(0u, cancels);
+    EXPECT_NE(nullptr, wrapped.getBucket(*layer.baseImpl));
+}
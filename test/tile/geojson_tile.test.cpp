@@ -23,6 +23,7 @@ class GeoJSONTileTest {
 public:
     FakeFileSource fileSource;
     TransformState transformState;
+    std::vector<TransformState> prefetchStates;
     util::RunLoop loop;
     ThreadPool threadPool { 1 };
     style::Style style { loop, fileSource, 1 };
@@ -41,7 +42,8 @@ public:
         annotationManager,
         imageManager,
         glyphManager,
-        0
+        0,
+        prefetchStates
     };
 };
 
@@ -19,6 +19,7 @@ class RasterTileTest {
 public:
     FakeFileSource fileSource;
     TransformState transformState;
+    std::vector<TransformState> prefetchStates;
     util::RunLoop loop;
     ThreadPool threadPool { 1 };
     style::Style style { loop, fileSource, 1 };
@@ -37,7 +38,8 @@ public:
         annotationManager,
         imageManager,
         glyphManager,
-        0
+        0,
+        prefetchStates
     };
 };
 
@@ -24,6 +24,7 @@ class VectorTileTest {
 public:
     FakeFileSource fileSource;
     TransformState transformState;
+    std::vector<TransformState> prefetchStates;
     util::RunLoop loop;
     ThreadPool threadPool { 1 };
     style::Style style { loop, fileSource, 1 };
@@ -42,7 +43,8 @@ public:
         annotationManager,
         imageManager,
         glyphManager,
-        0
+        0,
+        prefetchStates
     };
 };
 
@@ -71,5 +73,6 @@ TEST(VectorTile, Issue8542) {
 
     // Query before data is set
     std::vector<Feature> result;
-    tile.querySourceFeatures(result, { { {"layer"} }, {} });
+    tile.querySourceFeatures([&](const std::string&, Feature&& feature) { result.push_back(std::move(feature)); }, { { {"layer"} }, {} });
+    EXPECT_TRUE(result.empty());
 }
@@ -0,0 +1,45 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/compression.hpp>
+
+#include <random>
+#include <stdexcept>
+
+using namespace mbgl;
+
+TEST(Compression, FastRoundTrip) {
+    std::mt19937 random;
+
+    std::string repetitive;
+    for (int i = 0; i < 1000; i++) {
+        repetitive += "{\"id\":" + std::to_string(i) + ",\"name\":\"feature\"}";
+    }
+
+    std::string noise(70000, 0);
+    for (auto& c : noise) {
+        c = random();
+    }
+
+    for (const std::string& raw : { std::string(), std::string("a"), std::string("abcd"),
+                                    std::string(100000, 'x'), repetitive, noise }) {
+        const std::string compressed = util::compressFast(raw);
+        EXPECT_EQ(raw, util::decompressFast(compressed));
+    }
+
+    EXPECT_LT(util::compressFast(repetitive).size(), repetitive.size() / 2);
+}
+
+TEST(Compression, FastCorrupt) {
+    const std::string compressed = util::compressFast(std::string(1000, 'x'));
+
+    EXPECT_THROW(util::decompressFast(""), std::runtime_error);
+    EXPECT_THROW(util::decompressFast(compressed.substr(0, 3)), std::runtime_error);
+}
+
+TEST(Compression, ZlibLevel) {
+    const std::string raw(10000, 'x');
+
+    EXPECT_EQ(raw, util::decompress(util::compress(raw, 0)));
+    EXPECT_EQ(raw, util::decompress(util::compress(raw, 9)));
+    EXPECT_LT(util::compress(raw, 9).size(), util::compress(raw, 0).size());
+}
@@ -3,6 +3,12 @@
 #include <mbgl/util/premultiply.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/io.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
 
 using namespace mbgl;
 
@@ -34,6 +40,59 @@ TEST(Image, PNGRoundTripAlpha) {
     EXPECT_EQ(128, image.data[3]);
 }
 
+TEST(Image, PNGRoundTripOptions) {
+    const PremultipliedImage tile = decodeImage(util::read_file("test/fixtures/image/tile.jpeg"));
+    const std::string defaults = encodePNG(tile);
+
+    ThreadPool threadPool(2);
+    PNGEncodeOptions options;
+    options.scheduler = &threadPool;
+    const std::string parallel = encodePNG(tile, options);
+    EXPECT_EQ(defaults, parallel);
+
+    options.compressionLevel = 1;
+    const std::string fast = encodePNG(tile, options);
+    EXPECT_GT(fast.size(), parallel.size());
+
+    for (const auto& png : { parallel, fast }) {
+        const PremultipliedImage image = decodeImage(png);
+        ASSERT_EQ(tile.size, image.size);
+        EXPECT_EQ(0, std::memcmp(tile.data.get(), image.data.get(), tile.bytes()));
+    }
+
+    options.compressionLevel = 10;
+    EXPECT_THROW(encodePNG(tile, options), std::runtime_error);
+}
+
+TEST(Image, PNGPalette) {
+    // Images with at most 256 colors are stored without loss.
+    PremultipliedImage rgba({ 16, 16 });
+    for (uint32_t i = 0; i < rgba.size.area(); i++) {
+        rgba.data[i * 4 + 0] = i % 3 ? 0 : 64;
+        rgba.data[i * 4 + 1] = i % 5 ? 0 : 128;
+        rgba.data[i * 4 + 2] = i % 128;
+        rgba.data[i * 4 + 3] = i % 2 ? 255 : 128;
+    }
+
+    PNGEncodeOptions options;
+    options.palette = true;
+    PremultipliedImage image = decodeImage(encodePNG(rgba, options));
+    ASSERT_EQ(rgba.size, image.size);
+    EXPECT_EQ(0, std::memcmp(rgba.data.get(), image.data.get(), rgba.bytes()));
+
+    // Images with more colors are quantized.
+    const PremultipliedImage tile = decodeImage(util::read_file("test/fixtures/image/tile.jpeg"));
+    const std::string png = encodePNG(tile, options);
+    EXPECT_LT(png.size(), encodePNG(tile).size());
+    image = decodeImage(png);
+    ASSERT_EQ(tile.size, image.size);
+    double error = 0;
+    for (std::size_t i = 0; i < tile.bytes(); i++) {
+        error += std::abs(int(tile.data[i]) - int(image.data[i]));
+    }
+    EXPECT_LT(error / tile.bytes(), 8);
+}
+
 TEST(Image, PNGReadNoProfile) {
     PremultipliedImage image = decodeImage(util::read_file("test/fixtures/image/no_profile.png"));
     EXPECT_EQ(128, image.data[0]);
@@ -72,6 +131,18 @@ TEST(Image, PNGTile) {
     EXPECT_EQ(256u, image.size.height);
 }
 
+TEST(Image, PNGInterlaced) {
+    // A 61x45 crop at (100, 100) of tile.png, saved with Adam7 interlacing.
+    const PremultipliedImage tile = decodeImage(util::read_file("test/fixtures/image/tile.png"));
+    const PremultipliedImage image = decodeImage(util::read_file("test/fixtures/image/interlaced.png"));
+    ASSERT_EQ(61u, image.size.width);
+    ASSERT_EQ(45u, image.size.height);
+
+    PremultipliedImage expected({ 61, 45 });
+    PremultipliedImage::copy(tile, expected, { 100, 100 }, { 0, 0 }, expected.size);
+    EXPECT_EQ(0, std::memcmp(expected.data.get(), image.data.get(), expected.bytes()));
+}
+
 TEST(Image, JPEGTile) {
     PremultipliedImage image = decodeImage(util::read_file("test/fixtures/image/tile.jpeg"));
     EXPECT_EQ(256u, image.size.width);
@@ -163,3 +234,25 @@ TEST(Image, Premultiply) {
     EXPECT_EQ(0u, rgba.size.width);
     EXPECT_EQ(0u, rgba.size.height);
 }
+
+TEST(Image, PremultiplyPixels) {
+    // Every combination of channel and alpha values, with a pixel count that isn't a multiple
+    // of any vector width.
+    const size_t count = 256 * 256 + 3;
+    std::vector<uint8_t> pixels(count * 4);
+    for (size_t i = 0; i < count; i++) {
+        pixels[i * 4 + 0] = i % 256;
+        pixels[i * 4 + 1] = 255 - i % 256;
+        pixels[i * 4 + 2] = (i * 7) % 256;
+        pixels[i * 4 + 3] = (i / 256) % 256;
+    }
+    const std::vector<uint8_t> original = pixels;
+
+    util::premultiply(pixels.data(), count);
+
+    for (size_t i = 0; i < count * 4; i++) {
+        const uint8_t alpha = original[i - i % 4 + 3];
+        const uint8_t expected = i % 4 == 3 ? alpha : (original[i] * alpha + 127) / 255;
+        ASSERT_EQ(expected, pixels[i]) << "at byte " << i;
+    }
+}
@@ -0,0 +1,61 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/util/parallel_for.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(ParallelFor, CallsEachIndexOnce) {
+    ThreadPool pool(4);
+
+    std::vector<std::atomic<int>> calls(100);
+    for (auto& count : calls) {
+        count = 0;
+    }
+
+    util::parallelFor(pool, calls.size(), [&](std::size_t i) {
+        calls[i]++;
+    });
+
+    for (auto& count : calls) {
+        EXPECT_EQ(1, count.load());
+    }
+}
+
+TEST(ParallelFor, Nested) {
+    // A single thread is enough, since the calling thread helps out.
+    ThreadPool pool(1);
+
+    std::atomic<int> total { 0 };
+    util::parallelFor(pool, 8, [&](std::size_t) {
+        util::parallelFor(pool, 8, [&](std::size_t) {
+            total++;
+        });
+    });
+
+    EXPECT_EQ(64, total.load());
+}
+
+TEST(ParallelFor, RethrowsOnCaller) {
+    ThreadPool pool(4);
+
+    std::atomic<int> total { 0 };
+    try {
+        util::parallelFor(pool, 100, [&](std::size_t i) {
+            total++;
+            if (i % 10 == 3) {
+                throw std::runtime_error(std::to_string(i));
+            }
+        });
+        FAIL() << "expected an exception";
+    } catch (const std::runtime_error& error) {
+        EXPECT_STREQ("3", error.what());
+    }
+
+    EXPECT_EQ(100, total.load());
+}
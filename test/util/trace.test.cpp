@@ -0,0 +1,89 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/trace.hpp>
+#include <mbgl/util/rapidjson.hpp>
+
+#include <string>
+#include <thread>
+
+using namespace mbgl;
+
+TEST(Trace, NotRecordingByDefault) {
+    EXPECT_FALSE(Trace::isRecording());
+
+    bool evaluated = false;
+    {
+        MBGL_TRACE_DETAIL(Event::Render, "scope", (evaluated = true, "detail"));
+    }
+    EXPECT_FALSE(evaluated);
+}
+
+TEST(Trace, ChromeTraceJSON) {
+    Trace::start();
+    EXPECT_TRUE(Trace::isRecording());
+
+    {
+        MBGL_TRACE_DETAIL(Event::ParseTile, "outer", "0/0/0");
+        MBGL_TRACE(Event::ParseTile, "inner");
+    }
+
+    std::thread([] {
+        MBGL_TRACE(Event::Render, "other thread");
+    }).join();
+
+    const TimePoint begin = Clock::now();
+    Trace::recordAsync(Event::HttpRequest, "request", begin, begin + Milliseconds(2), "url");
+
+    Trace::stop();
+    EXPECT_FALSE(Trace::isRecording());
+
+    {
+        MBGL_TRACE(Event::Render, "not recorded");
+    }
+
+    JSDocument document;
+    const std::string json = Trace::toChromeTraceJSON();
+    document.Parse<0>(json.c_str());
+    ASSERT_FALSE(document.HasParseError());
+    ASSERT_TRUE(document.HasMember("traceEvents"));
+
+    const JSValue& events = document["traceEvents"];
+    ASSERT_TRUE(events.IsArray());
+
+    std::size_t threadNames = 0;
+    std::size_t complete = 0;
+    uint64_t innerThread = 0;
+    uint64_t otherThread = 0;
+    for (const auto& event : events.GetArray()) {
+        const std::string name = event["name"].GetString();
+        const std::string phase = event["ph"].GetString();
+        EXPECT_NE("not recorded", name);
+
+        if (phase == "M") {
+            EXPECT_EQ("thread_name", name);
+            threadNames++;
+        } else if (phase == "X") {
+            complete++;
+            EXPECT_GE(event["dur"].GetDouble(), 0);
+            if (name == "outer") {
+                EXPECT_EQ(std::string("ParseTile"), event["cat"].GetString());
+                EXPECT_EQ(std::string("0/0/0"), event["args"]["detail"].GetString());
+            } else if (name == "inner") {
+                innerThread = event["tid"].GetUint64();
+                EXPECT_FALSE(event.HasMember("args"));
+            } else if (name == "other thread") {
+                otherThread = event["tid"].GetUint64();
+            }
+        } else if (phase == "b") {
+            EXPECT_EQ("request", name);
+            EXPECT_EQ(std::string("url"), event["args"]["detail"].GetString());
+        } else {
+            EXPECT_EQ("e", phase);
+            EXPECT_EQ("request", name);
+        }
+    }
+
+    EXPECT_EQ(2u, threadNames);
+    EXPECT_EQ(3u, complete);
+    EXPECT_NE(innerThread, otherThread);
+}